@@ -46,7 +46,9 @@ public class OPM : ModuleRules
 				"SlateCore",
 				"EditorStyle",
 				"PropertyEditor",
-				"LevelEditor"
+				"LevelEditor",
+				"Foliage",
+				"EditorSubsystem"
 			}
 			);
 		
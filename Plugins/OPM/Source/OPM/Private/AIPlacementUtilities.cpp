@@ -5,7 +5,7 @@
 #include "Components/PrimitiveComponent.h"
 #include "GameFramework/Actor.h"
 
-EAIPatternType UOPM_AIPlacementUtilities::DetectPlacementPattern(const TArray<AActor*>& Actors)
+EAIPatternType UOPM_AIPlacementUtilities::DetectPlacementPattern(TArrayView<AActor* const> Actors)
 {
 	if (Actors.Num() < 3)
 	{
@@ -48,7 +48,7 @@ EAIPatternType UOPM_AIPlacementUtilities::DetectPlacementPattern(const TArray<AA
 }
 
 int32 UOPM_AIPlacementUtilities::GenerateSmartSuggestions(
-	const TArray<AActor*>& ExistingActors,
+	TArrayView<AActor* const> ExistingActors,
 	const FAIPlacementSettings& Settings,
 	TArray<FTransform>& SuggestedTransforms)
 {
@@ -136,7 +136,7 @@ int32 UOPM_AIPlacementUtilities::GenerateSmartSuggestions(
 }
 
 TArray<FTransform> UOPM_AIPlacementUtilities::OptimizeActorPlacement(
-	const TArray<AActor*>& Actors,
+	TArrayView<AActor* const> Actors,
 	const FAIPlacementSettings& Settings)
 {
 	TArray<FTransform> OptimizedTransforms;
@@ -194,7 +194,7 @@ TArray<FTransform> UOPM_AIPlacementUtilities::OptimizeActorPlacement(
 	return OptimizedTransforms;
 }
 
-float UOPM_AIPlacementUtilities::CalculateClusteringDensity(const TArray<AActor*>& Actors)
+float UOPM_AIPlacementUtilities::CalculateClusteringDensity(TArrayView<AActor* const> Actors)
 {
 	if (Actors.Num() < 2)
 	{
@@ -250,7 +250,7 @@ float UOPM_AIPlacementUtilities::CalculateOptimalSpacing(
 }
 
 int32 UOPM_AIPlacementUtilities::DetectAndCorrectOverlaps(
-	const TArray<AActor*>& Actors,
+	TArrayView<AActor* const> Actors,
 	TArray<FTransform>& CorrectedTransforms)
 {
 	CorrectedTransforms.Empty();
@@ -360,7 +360,7 @@ TArray<FTransform> UOPM_AIPlacementUtilities::GenerateOrganicPattern(
 }
 
 TArray<float> UOPM_AIPlacementUtilities::SuggestLODSettings(
-	const TArray<AActor*>& Actors,
+	TArrayView<AActor* const> Actors,
 	EAIOptimizationGoal OptimizationGoal)
 {
 	TArray<float> LODDistances;
@@ -404,7 +404,7 @@ TArray<float> UOPM_AIPlacementUtilities::SuggestLODSettings(
 	return LODDistances;
 }
 
-float UOPM_AIPlacementUtilities::EvaluatePlacementQuality(const TArray<AActor*>& Actors)
+float UOPM_AIPlacementUtilities::EvaluatePlacementQuality(TArrayView<AActor* const> Actors)
 {
 	if (Actors.Num() < 2)
 	{
@@ -437,7 +437,7 @@ float UOPM_AIPlacementUtilities::EvaluatePlacementQuality(const TArray<AActor*>&
 }
 
 TArray<FTransform> UOPM_AIPlacementUtilities::AutoBalanceDistribution(
-	const TArray<AActor*>& Actors,
+	TArrayView<AActor* const> Actors,
 	const FBox& BoundsBox)
 {
 	TArray<FTransform> BalancedTransforms;
@@ -477,7 +477,7 @@ TArray<FTransform> UOPM_AIPlacementUtilities::AutoBalanceDistribution(
 
 // Private helper methods
 
-float UOPM_AIPlacementUtilities::CalculateSpacingVariance(const TArray<AActor*>& Actors)
+float UOPM_AIPlacementUtilities::CalculateSpacingVariance(TArrayView<AActor* const> Actors)
 {
 	if (Actors.Num() < 2)
 	{
@@ -518,7 +518,7 @@ float UOPM_AIPlacementUtilities::CalculateSpacingVariance(const TArray<AActor*>&
 	return (Mean > KINDA_SMALL_NUMBER) ? (FMath::Sqrt(Variance) / Mean) : 0.0f;
 }
 
-bool UOPM_AIPlacementUtilities::DetectLinearPattern(const TArray<AActor*>& Actors, float Tolerance)
+bool UOPM_AIPlacementUtilities::DetectLinearPattern(TArrayView<AActor* const> Actors, float Tolerance)
 {
 	if (Actors.Num() < 3)
 	{
@@ -552,7 +552,7 @@ bool UOPM_AIPlacementUtilities::DetectLinearPattern(const TArray<AActor*>& Actor
 	return (OnLineCount >= Actors.Num() * 0.8f);
 }
 
-bool UOPM_AIPlacementUtilities::DetectRadialPattern(const TArray<AActor*>& Actors, float Tolerance)
+bool UOPM_AIPlacementUtilities::DetectRadialPattern(TArrayView<AActor* const> Actors, float Tolerance)
 {
 	if (Actors.Num() < 4)
 	{
@@ -589,7 +589,7 @@ bool UOPM_AIPlacementUtilities::DetectRadialPattern(const TArray<AActor*>& Actor
 	return (OnCircleCount >= Actors.Num() * 0.8f);
 }
 
-FVector UOPM_AIPlacementUtilities::CalculateCentroid(const TArray<AActor*>& Actors)
+FVector UOPM_AIPlacementUtilities::CalculateCentroid(TArrayView<AActor* const> Actors)
 {
 	FVector Centroid = FVector::ZeroVector;
 	int32 ValidCount = 0;
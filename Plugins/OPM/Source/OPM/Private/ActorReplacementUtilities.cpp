@@ -1,82 +1,158 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ActorReplacementUtilities.h"
+#include "OPMBulkEditScope.h"
+#include "TagIndexSubsystem.h"
+#include "OrganizationUtilities.h"
 #include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "FoliageInstancedStaticMeshComponent.h"
+#include "InstancedFoliageActor.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/UnrealType.h"
+#include "Editor.h"
 
-AActor* UOPM_ActorReplacementUtilities::ReplaceActor(
-	AActor* OldActor,
-	UClass* NewActorClass,
-	UWorld* World,
-	bool bPreserveTransform,
-	bool bPreserveAttachments)
+namespace OPMReplacement
 {
-	if (!OldActor || !NewActorClass || !World)
+	/** Tag on components created by ConvertActorsToInstances */
+	const FName ConvertedInstanceTag(TEXT("OPM_ConvertedInstance"));
+
+	/** Mesh and material overrides shared by every instance of a component */
+	struct FInstanceGroupKey
 	{
-		return nullptr;
-	}
+		UStaticMesh* Mesh = nullptr;
+		TArray<UMaterialInterface*> Materials;
 
-	// Store transform and other properties
-	FTransform Transform = OldActor->GetActorTransform();
-	TArray<FName> Tags = OldActor->Tags;
-	AActor* ParentActor = OldActor->GetAttachParentActor();
-	TArray<AActor*> AttachedActors;
-	OldActor->GetAttachedActors(AttachedActors);
+		bool operator==(const FInstanceGroupKey& Other) const
+		{
+			return Mesh == Other.Mesh && Materials == Other.Materials;
+		}
 
-	// Spawn new actor
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		friend uint32 GetTypeHash(const FInstanceGroupKey& Key)
+		{
+			uint32 Hash = GetTypeHash(Key.Mesh);
+			for (UMaterialInterface* Material : Key.Materials)
+			{
+				Hash = HashCombine(Hash, GetTypeHash(Material));
+			}
+			return Hash;
+		}
+	};
 
-	AActor* NewActor = World->SpawnActor<AActor>(
-		NewActorClass,
-		Transform.GetLocation(),
-		Transform.Rotator(),
-		SpawnParams
-	);
+	/** Properties copied from an old actor class to the matching property of a new one */
+	struct FPropertyCopyPlan
+	{
+		TArray<TPair<const FProperty*, const FProperty*>> Properties;
+	};
+
+	/** Plans per (old class, new class) pair, built on first use */
+	static TMap<TPair<TObjectKey<UClass>, TObjectKey<UClass>>, TUniquePtr<FPropertyCopyPlan>> CopyPlans;
+
+	/**
+	 * Blueprint compiles, hot reload and Live Coding reinstancing rebuild the property list of a
+	 * class in place, leaving cached FProperty pointers dangling, so any of them drops every plan
+	 */
+	static FDelegateHandle ObjectsReplacedHandle;
+	static FDelegateHandle ReloadCompleteHandle;
+	static FDelegateHandle BlueprintCompiledHandle;
 
-	if (!NewActor)
+	/** Helper to subscribe to the events that invalidate cached plans, once per session */
+	static void BindPlanInvalidation()
 	{
-		return nullptr;
+		if (!ObjectsReplacedHandle.IsValid())
+		{
+			ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>&)
+			{
+				CopyPlans.Empty();
+			});
+		}
+
+		if (!ReloadCompleteHandle.IsValid())
+		{
+			ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+			{
+				CopyPlans.Empty();
+			});
+		}
+
+		if (!BlueprintCompiledHandle.IsValid() && GEditor)
+		{
+			BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda([]()
+			{
+				CopyPlans.Empty();
+			});
+		}
 	}
 
-	// Apply transform
-	if (bPreserveTransform)
+	/** Helper to check whether a property holds per-instance data that is safe to copy */
+	static bool IsCopyableProperty(const FProperty* Property)
 	{
-		NewActor->SetActorScale3D(Transform.GetScale3D());
-	}
+		if (!Property->HasAnyPropertyFlags(CPF_Edit) ||
+			Property->HasAnyPropertyFlags(CPF_EditConst | CPF_DisableEditOnInstance | CPF_Transient | CPF_Deprecated |
+				CPF_InstancedReference | CPF_ContainsInstancedReference))
+		{
+			return false;
+		}
 
-	// Copy tags
-	NewActor->Tags = Tags;
+		// Components belong to their owner, sharing them between two actors would alias them
+		const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property);
+		return !ObjectProperty || !ObjectProperty->PropertyClass->IsChildOf<UActorComponent>();
+	}
 
-	// Preserve attachments
-	if (bPreserveAttachments)
+	/** Helper to find or build the plan matching editable properties by name and type */
+	static const FPropertyCopyPlan& GetCopyPlan(UClass* OldClass, UClass* NewClass)
 	{
-		// Attach to parent if it existed
-		if (ParentActor)
+		TUniquePtr<FPropertyCopyPlan>& Plan = CopyPlans.FindOrAdd(MakeTuple(TObjectKey<UClass>(OldClass), TObjectKey<UClass>(NewClass)));
+		if (Plan)
 		{
-			NewActor->AttachToActor(ParentActor, FAttachmentTransformRules::KeepWorldTransform);
+			return *Plan;
 		}
 
-		// Reattach children
-		for (AActor* AttachedActor : AttachedActors)
+		BindPlanInvalidation();
+
+		Plan = MakeUnique<FPropertyCopyPlan>();
+		for (TFieldIterator<FProperty> It(NewClass); It; ++It)
 		{
-			if (AttachedActor)
+			const FProperty* NewProperty = *It;
+			if (!IsCopyableProperty(NewProperty))
 			{
-				AttachedActor->AttachToActor(NewActor, FAttachmentTransformRules::KeepWorldTransform);
+				continue;
+			}
+
+			const FProperty* OldProperty = OldClass->FindPropertyByName(NewProperty->GetFName());
+			if (OldProperty && IsCopyableProperty(OldProperty) && OldProperty->SameType(NewProperty))
+			{
+				Plan->Properties.Emplace(OldProperty, NewProperty);
 			}
 		}
-	}
 
-	// Copy actor label
-	NewActor->SetActorLabel(OldActor->GetActorLabel());
+		return *Plan;
+	}
+}
 
-	// Destroy old actor
-	OldActor->Destroy();
+AActor* UOPM_ActorReplacementUtilities::ReplaceActor(
+	AActor* OldActor,
+	UClass* NewActorClass,
+	UWorld* World,
+	bool bPreserveTransform,
+	bool bPreserveAttachments)
+{
+	const TArray<AActor*> NewActors = BatchReplaceActors(
+		MakeArrayView(&OldActor, 1),
+		NewActorClass,
+		World,
+		bPreserveTransform,
+		bPreserveAttachments
+	);
 
-	return NewActor;
+	return NewActors.Num() > 0 ? NewActors[0] : nullptr;
 }
 
 TArray<AActor*> UOPM_ActorReplacementUtilities::BatchReplaceActors(
-	TArray<AActor*> OldActors,
+	TArrayView<AActor* const> OldActors,
 	UClass* NewActorClass,
 	UWorld* World,
 	bool bPreserveTransform,
@@ -84,29 +160,313 @@ TArray<AActor*> UOPM_ActorReplacementUtilities::BatchReplaceActors(
 {
 	TArray<AActor*> NewActors;
 
-	if (!NewActorClass || !World)
+	if (!NewActorClass || !NewActorClass->IsChildOf<AActor>() || !World)
 	{
 		return NewActors;
 	}
 
 	NewActors.Reserve(OldActors.Num());
+	TArray<AActor*> ReplacedActors;
+	ReplacedActors.Reserve(OldActors.Num());
+	TMap<AActor*, AActor*> Replacements;
+	Replacements.Reserve(OldActors.Num());
 
+	// Spawn deferred so copied properties are in place before the construction script runs
 	for (AActor* OldActor : OldActors)
 	{
-		AActor* NewActor = ReplaceActor(
-			OldActor,
+		if (!OldActor || Replacements.Contains(OldActor))
+		{
+			continue;
+		}
+
+		FTransform Transform = OldActor->GetActorTransform();
+		if (!bPreserveTransform)
+		{
+			Transform.SetScale3D(FVector::OneVector);
+		}
+
+		AActor* NewActor = World->SpawnActorDeferred<AActor>(
 			NewActorClass,
-			World,
-			bPreserveTransform,
-			bPreserveAttachments
+			Transform,
+			nullptr,
+			nullptr,
+			ESpawnActorCollisionHandlingMethod::AlwaysSpawn
 		);
 
-		if (NewActor)
+		if (!NewActor)
+		{
+			continue;
+		}
+
+		const OPMReplacement::FPropertyCopyPlan& Plan = OPMReplacement::GetCopyPlan(OldActor->GetClass(), NewActorClass);
+		for (const TPair<const FProperty*, const FProperty*>& Pair : Plan.Properties)
+		{
+			Pair.Value->CopyCompleteValue(
+				Pair.Value->ContainerPtrToValuePtr<void>(NewActor),
+				Pair.Key->ContainerPtrToValuePtr<void>(OldActor));
+		}
+
+		NewActor->FinishSpawning(Transform);
+
+		Replacements.Add(OldActor, NewActor);
+		ReplacedActors.Add(OldActor);
+		NewActors.Add(NewActor);
+	}
+
+	// Rewire attachments once every replacement exists, so nothing is attached to an actor about
+	// to be destroyed and parent/child pairs that are both replaced stay together
+	if (bPreserveAttachments)
+	{
+		TArray<AActor*> AttachedActors;
+		for (int32 Index = 0; Index < ReplacedActors.Num(); ++Index)
+		{
+			AActor* OldActor = ReplacedActors[Index];
+			AActor* NewActor = NewActors[Index];
+
+			if (AActor* ParentActor = OldActor->GetAttachParentActor())
+			{
+				AActor* const* NewParent = Replacements.Find(ParentActor);
+				NewActor->AttachToActor(NewParent ? *NewParent : ParentActor, FAttachmentTransformRules::KeepWorldTransform);
+			}
+
+			AttachedActors.Reset();
+			OldActor->GetAttachedActors(AttachedActors);
+			for (AActor* AttachedActor : AttachedActors)
+			{
+				if (AttachedActor && !Replacements.Contains(AttachedActor))
+				{
+					AttachedActor->AttachToActor(NewActor, FAttachmentTransformRules::KeepWorldTransform);
+				}
+			}
+		}
+	}
+
+	for (int32 Index = 0; Index < ReplacedActors.Num(); ++Index)
+	{
+		AActor* OldActor = ReplacedActors[Index];
+		AActor* NewActor = NewActors[Index];
+
+#if WITH_EDITOR
+		NewActor->SetActorLabel(OldActor->GetActorLabel(), false);
+		NewActor->SetFolderPath(OldActor->GetFolderPath());
+		FOPM_BulkEditScope::MarkPackageDirty(NewActor);
+#endif
+
+		OldActor->Destroy();
+	}
+
+	if (UOPM_TagIndexSubsystem* TagIndex = UOPM_TagIndexSubsystem::Get())
+	{
+		TagIndex->UpdateActors(NewActors);
+	}
+
+	FOPM_BulkEditScope::RequestViewportRedraw();
+
+	return NewActors;
+}
+
+void UOPM_ActorReplacementUtilities::ReleaseCopyPlans()
+{
+	using namespace OPMReplacement;
+
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+
+	ObjectsReplacedHandle.Reset();
+	ReloadCompleteHandle.Reset();
+	BlueprintCompiledHandle.Reset();
+
+	CopyPlans.Empty();
+}
+
+AActor* UOPM_ActorReplacementUtilities::ConvertActorsToInstances(
+	TArrayView<AActor* const> Actors,
+	UWorld* World,
+	bool bHierarchical)
+{
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	TMap<OPMReplacement::FInstanceGroupKey, TArray<FTransform>> Groups;
+	TArray<AActor*> Converted;
+	FVector Centroid = FVector::ZeroVector;
+
+	for (AActor* Actor : Actors)
+	{
+		UStaticMeshComponent* MeshComponent = GetSoleStaticMeshComponent(Actor);
+		if (!MeshComponent)
+		{
+			continue;
+		}
+
+		OPMReplacement::FInstanceGroupKey Key;
+		Key.Mesh = MeshComponent->GetStaticMesh();
+		Key.Materials = MeshComponent->OverrideMaterials;
+		while (Key.Materials.Num() > 0 && Key.Materials.Last() == nullptr)
+		{
+			Key.Materials.Pop(false);
+		}
+
+		const FTransform& Transform = MeshComponent->GetComponentTransform();
+		Groups.FindOrAdd(MoveTemp(Key)).Add(Transform);
+		Centroid += Transform.GetLocation();
+		Converted.Add(Actor);
+	}
+
+	if (Converted.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	Centroid /= Converted.Num();
+	const FString Label = Groups.Num() == 1 ?
+		Groups.CreateConstIterator().Key().Mesh->GetName() + TEXT("_Instances") :
+		FString(TEXT("Instances"));
+
+	AActor* Host = UOPM_OrganizationUtilities::CreateParentActor(World, Centroid, Label);
+	USceneComponent* Root = Host ? Host->GetRootComponent() : nullptr;
+	if (!Root)
+	{
+		return nullptr;
+	}
+	Root->SetMobility(EComponentMobility::Static);
+
+	for (const TPair<OPMReplacement::FInstanceGroupKey, TArray<FTransform>>& Group : Groups)
+	{
+		UInstancedStaticMeshComponent* Component = bHierarchical ?
+			NewObject<UHierarchicalInstancedStaticMeshComponent>(Host, NAME_None, RF_Transactional) :
+			NewObject<UInstancedStaticMeshComponent>(Host, NAME_None, RF_Transactional);
+
+		Component->ComponentTags.Add(OPMReplacement::ConvertedInstanceTag);
+		Component->SetStaticMesh(Group.Key.Mesh);
+		for (int32 MaterialIndex = 0; MaterialIndex < Group.Key.Materials.Num(); ++MaterialIndex)
+		{
+			Component->SetMaterial(MaterialIndex, Group.Key.Materials[MaterialIndex]);
+		}
+		Component->SetMobility(EComponentMobility::Static);
+		Component->SetupAttachment(Root);
+		Host->AddInstanceComponent(Component);
+		Component->RegisterComponent();
+
+		// One batched add per component, so the render state and HISM tree are built once
+		Component->AddInstances(Group.Value, false, true);
+	}
+
+	for (AActor* Actor : Converted)
+	{
+		Actor->Destroy();
+	}
+
+	FOPM_BulkEditScope::RequestViewportRedraw();
+
+	return Host;
+}
+
+TArray<AActor*> UOPM_ActorReplacementUtilities::ConvertInstancesToActors(
+	UInstancedStaticMeshComponent* Component,
+	TArrayView<const int32> InstanceIndices,
+	UWorld* World,
+	bool bAllInstances)
+{
+	TArray<AActor*> NewActors;
+
+	if (!Component || !World || !Component->GetStaticMesh())
+	{
+		return NewActors;
+	}
+
+	// Foliage instances are owned by FFoliageInfo, removing them from the component directly corrupts it
+	if (Component->IsA<UFoliageInstancedStaticMeshComponent>() || Cast<AInstancedFoliageActor>(Component->GetOwner()))
+	{
+		return NewActors;
+	}
+
+	const int32 InstanceCount = Component->GetInstanceCount();
+	TArray<int32> Indices;
+	if (bAllInstances)
+	{
+		for (int32 Index = 0; Index < InstanceCount; ++Index)
+		{
+			Indices.Add(Index);
+		}
+	}
+	else if (InstanceIndices.Num() > 0)
+	{
+		for (int32 Index : InstanceIndices)
+		{
+			if (Index >= 0 && Index < InstanceCount)
+			{
+				Indices.AddUnique(Index);
+			}
+		}
+	}
+	else
+	{
+#if WITH_EDITOR
+		for (TConstSetBitIterator<> It(Component->SelectedInstances); It; ++It)
+		{
+			if (It.GetIndex() < InstanceCount)
+			{
+				Indices.Add(It.GetIndex());
+			}
+		}
+#endif
+	}
+
+	if (Indices.Num() == 0)
+	{
+		return NewActors;
+	}
+
+	Indices.Sort();
+	NewActors.Reserve(Indices.Num());
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const FString BaseLabel = Component->GetStaticMesh()->GetName();
+	for (int32 Index : Indices)
+	{
+		FTransform Transform;
+		if (!Component->GetInstanceTransform(Index, Transform, true))
+		{
+			continue;
+		}
+
+		AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform, SpawnParams);
+		if (!Actor)
 		{
-			NewActors.Add(NewActor);
+			continue;
 		}
+
+		UStaticMeshComponent* MeshComponent = Actor->GetStaticMeshComponent();
+		MeshComponent->SetMobility(Component->Mobility);
+		MeshComponent->SetStaticMesh(Component->GetStaticMesh());
+		for (int32 MaterialIndex = 0; MaterialIndex < Component->OverrideMaterials.Num(); ++MaterialIndex)
+		{
+			MeshComponent->SetMaterial(MaterialIndex, Component->OverrideMaterials[MaterialIndex]);
+		}
+
+#if WITH_EDITOR
+		Actor->SetActorLabel(BaseLabel, false);
+		FOPM_BulkEditScope::MarkPackageDirty(Actor);
+#endif
+
+		NewActors.Add(Actor);
 	}
 
+	// Remove the converted instances in one call so the render data is rebuilt once
+	Component->Modify();
+	Component->RemoveInstances(Indices);
+
+	FOPM_BulkEditScope::RequestViewportRedraw();
+
 	return NewActors;
 }
 
@@ -128,6 +488,11 @@ void UOPM_ActorReplacementUtilities::CopyTags(AActor* SourceActor, AActor* Targe
 	}
 
 	TargetActor->Tags = SourceActor->Tags;
+
+	if (UOPM_TagIndexSubsystem* TagIndex = UOPM_TagIndexSubsystem::Get())
+	{
+		TagIndex->UpdateActor(TargetActor);
+	}
 }
 
 void UOPM_ActorReplacementUtilities::CopyAttachments(AActor* SourceActor, AActor* TargetActor)
@@ -156,3 +521,28 @@ void UOPM_ActorReplacementUtilities::CopyAttachments(AActor* SourceActor, AActor
 		}
 	}
 }
+
+// Private helper methods
+
+UStaticMeshComponent* UOPM_ActorReplacementUtilities::GetSoleStaticMeshComponent(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+	if (Primitives.Num() != 1)
+	{
+		return nullptr;
+	}
+
+	// Instanced components derive from the static mesh component but carry many meshes
+	UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Primitives[0]);
+	if (!MeshComponent || MeshComponent->IsA<UInstancedStaticMeshComponent>() || !MeshComponent->GetStaticMesh())
+	{
+		return nullptr;
+	}
+
+	return MeshComponent;
+}
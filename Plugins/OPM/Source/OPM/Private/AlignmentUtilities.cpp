@@ -1,12 +1,14 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "AlignmentUtilities.h"
+#include "OPMBulkEditScope.h"
 #include "Components/PrimitiveComponent.h"
+#include "Algo/StableSort.h"
 
 #define LOCTEXT_NAMESPACE "OPMAlignmentUtilities"
 
 void UOPM_AlignmentUtilities::AlignActors(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	EAlignmentType Type,
 	EAlignmentAxis Axis)
 {
@@ -47,337 +49,305 @@ void UOPM_AlignmentUtilities::AlignActors(
 	}
 }
 
-void UOPM_AlignmentUtilities::AlignActorsLeft(TArray<AActor*> Actors)
+void UOPM_AlignmentUtilities::AlignActorsLeft(TArrayView<AActor* const> Actors)
 {
-	if (Actors.Num() < 2)
-	{
-		return;
-	}
+	AlignToAnchor(Actors, 0, 0.0f);
+}
 
-	FBox Bounds = GetActorsBounds(Actors);
-	float AlignValue = Bounds.Min.X;
+void UOPM_AlignmentUtilities::AlignActorsRight(TArrayView<AActor* const> Actors)
+{
+	AlignToAnchor(Actors, 0, 1.0f);
+}
 
-	for (AActor* Actor : Actors)
-	{
-		if (Actor)
-		{
-			FVector Location = Actor->GetActorLocation();
-			FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
-			float Offset = Location.X - ActorBounds.Min.X;
-			Location.X = AlignValue + Offset;
-			Actor->SetActorLocation(Location);
-		}
-	}
+void UOPM_AlignmentUtilities::AlignActorsTop(TArrayView<AActor* const> Actors)
+{
+	AlignToAnchor(Actors, 2, 1.0f);
 }
 
-void UOPM_AlignmentUtilities::AlignActorsRight(TArray<AActor*> Actors)
+void UOPM_AlignmentUtilities::AlignActorsBottom(TArrayView<AActor* const> Actors)
 {
-	if (Actors.Num() < 2)
-	{
-		return;
-	}
+	AlignToAnchor(Actors, 2, 0.0f);
+}
 
-	FBox Bounds = GetActorsBounds(Actors);
-	float AlignValue = Bounds.Max.X;
+void UOPM_AlignmentUtilities::AlignActorsFront(TArrayView<AActor* const> Actors)
+{
+	AlignToAnchor(Actors, 1, 0.0f);
+}
 
-	for (AActor* Actor : Actors)
-	{
-		if (Actor)
-		{
-			FVector Location = Actor->GetActorLocation();
-			FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
-			float Offset = Location.X - ActorBounds.Max.X;
-			Location.X = AlignValue + Offset;
-			Actor->SetActorLocation(Location);
-		}
-	}
+void UOPM_AlignmentUtilities::AlignActorsBack(TArrayView<AActor* const> Actors)
+{
+	AlignToAnchor(Actors, 1, 1.0f);
 }
 
-void UOPM_AlignmentUtilities::AlignActorsTop(TArray<AActor*> Actors)
+void UOPM_AlignmentUtilities::CenterActorsX(TArrayView<AActor* const> Actors)
 {
-	if (Actors.Num() < 2)
-	{
-		return;
-	}
+	AlignToAnchor(Actors, 0, 0.5f);
+}
 
-	FBox Bounds = GetActorsBounds(Actors);
-	float AlignValue = Bounds.Max.Z;
+void UOPM_AlignmentUtilities::CenterActorsY(TArrayView<AActor* const> Actors)
+{
+	AlignToAnchor(Actors, 1, 0.5f);
+}
 
-	for (AActor* Actor : Actors)
-	{
-		if (Actor)
-		{
-			FVector Location = Actor->GetActorLocation();
-			FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
-			float Offset = Location.Z - ActorBounds.Max.Z;
-			Location.Z = AlignValue + Offset;
-			Actor->SetActorLocation(Location);
-		}
-	}
+void UOPM_AlignmentUtilities::CenterActorsZ(TArrayView<AActor* const> Actors)
+{
+	AlignToAnchor(Actors, 2, 0.5f);
 }
 
-void UOPM_AlignmentUtilities::AlignActorsBottom(TArray<AActor*> Actors)
+void UOPM_AlignmentUtilities::DistributeActors(
+	TArrayView<AActor* const> Actors,
+	EDistributionType Type)
 {
-	if (Actors.Num() < 2)
+	if (Actors.Num() < 3)
 	{
 		return;
 	}
 
-	FBox Bounds = GetActorsBounds(Actors);
-	float AlignValue = Bounds.Min.Z;
-
-	for (AActor* Actor : Actors)
+	switch (Type)
 	{
-		if (Actor)
-		{
-			FVector Location = Actor->GetActorLocation();
-			FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
-			float Offset = Location.Z - ActorBounds.Min.Z;
-			Location.Z = AlignValue + Offset;
-			Actor->SetActorLocation(Location);
-		}
+	case EDistributionType::Horizontal:
+		DistributeActorsHorizontally(Actors);
+		break;
+	case EDistributionType::Vertical:
+		DistributeActorsVertically(Actors);
+		break;
+	case EDistributionType::Radial:
+		// Radial distribution not yet implemented
+		break;
 	}
 }
 
-void UOPM_AlignmentUtilities::AlignActorsFront(TArray<AActor*> Actors)
+void UOPM_AlignmentUtilities::DistributeActorsHorizontally(TArrayView<AActor* const> Actors)
 {
-	if (Actors.Num() < 2)
-	{
-		return;
-	}
+	DistributeAlongAxis(Actors, 0);
+}
 
-	FBox Bounds = GetActorsBounds(Actors);
-	float AlignValue = Bounds.Min.Y;
+void UOPM_AlignmentUtilities::DistributeActorsVertically(TArrayView<AActor* const> Actors)
+{
+	DistributeAlongAxis(Actors, 2);
+}
+
+FBox UOPM_AlignmentUtilities::GetActorsBounds(TArrayView<AActor* const> Actors)
+{
+	FBox Bounds(ForceInit);
 
 	for (AActor* Actor : Actors)
 	{
 		if (Actor)
 		{
-			FVector Location = Actor->GetActorLocation();
 			FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
-			float Offset = Location.Y - ActorBounds.Min.Y;
-			Location.Y = AlignValue + Offset;
-			Actor->SetActorLocation(Location);
+			Bounds += ActorBounds;
 		}
 	}
+
+	return Bounds;
 }
 
-void UOPM_AlignmentUtilities::AlignActorsBack(TArray<AActor*> Actors)
+FVector UOPM_AlignmentUtilities::GetActorsCenter(TArrayView<AActor* const> Actors)
 {
-	if (Actors.Num() < 2)
-	{
-		return;
-	}
-
 	FBox Bounds = GetActorsBounds(Actors);
-	float AlignValue = Bounds.Max.Y;
+	return Bounds.GetCenter();
+}
 
-	for (AActor* Actor : Actors)
+void UOPM_AlignmentUtilities::SnapActorToGrid(AActor* Actor, float GridSize)
+{
+	if (!Actor || GridSize <= 0.0f)
 	{
-		if (Actor)
-		{
-			FVector Location = Actor->GetActorLocation();
-			FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
-			float Offset = Location.Y - ActorBounds.Max.Y;
-			Location.Y = AlignValue + Offset;
-			Actor->SetActorLocation(Location);
-		}
+		return;
 	}
+
+	FVector Location = Actor->GetActorLocation();
+	Location.X = FMath::GridSnap(Location.X, GridSize);
+	Location.Y = FMath::GridSnap(Location.Y, GridSize);
+	Location.Z = FMath::GridSnap(Location.Z, GridSize);
+	Actor->SetActorLocation(Location);
 }
 
-void UOPM_AlignmentUtilities::CenterActorsX(TArray<AActor*> Actors)
+void UOPM_AlignmentUtilities::SnapActorsToGrid(TArrayView<AActor* const> Actors, float GridSize)
 {
-	if (Actors.Num() < 2)
+	if (GridSize <= 0.0f)
 	{
 		return;
 	}
 
-	FBox Bounds = GetActorsBounds(Actors);
-	float Center = (Bounds.Min.X + Bounds.Max.X) * 0.5f;
-
+	TArray<AActor*> Snapped;
+	TArray<FVector> Locations;
+	Snapped.Reserve(Actors.Num());
+	Locations.Reserve(Actors.Num());
 	for (AActor* Actor : Actors)
 	{
-		if (Actor)
+		if (!Actor)
 		{
-			FVector Location = Actor->GetActorLocation();
-			FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
-			float ActorCenter = (ActorBounds.Min.X + ActorBounds.Max.X) * 0.5f;
-			float Offset = Location.X - ActorCenter;
-			Location.X = Center + Offset;
-			Actor->SetActorLocation(Location);
+			continue;
 		}
+
+		FVector Location = Actor->GetActorLocation();
+		Location.X = FMath::GridSnap(Location.X, GridSize);
+		Location.Y = FMath::GridSnap(Location.Y, GridSize);
+		Location.Z = FMath::GridSnap(Location.Z, GridSize);
+
+		Snapped.Add(Actor);
+		Locations.Add(Location);
 	}
+
+	CommitActorLocations(Snapped, Locations);
 }
 
-void UOPM_AlignmentUtilities::CenterActorsY(TArray<AActor*> Actors)
+void UOPM_AlignmentUtilities::CommitActorLocations(
+	TArrayView<AActor* const> Actors,
+	TArrayView<const FVector> Locations)
 {
-	if (Actors.Num() < 2)
+	const int32 NumActors = FMath::Min(Actors.Num(), Locations.Num());
+	TArray<USceneComponent*> MovedRoots;
+	MovedRoots.Reserve(NumActors);
+	TArray<TPair<int32, int32>> AttachedActors;
+
+	// Reposition every root without propagating, attached actors go through the regular path
+	// afterwards so their parent-relative transform is worked out against the moved parents
+	for (int32 Index = 0; Index < NumActors; ++Index)
 	{
-		return;
-	}
-
-	FBox Bounds = GetActorsBounds(Actors);
-	float Center = (Bounds.Min.Y + Bounds.Max.Y) * 0.5f;
+		AActor* Actor = Actors[Index];
+		USceneComponent* Root = Actor ? Actor->GetRootComponent() : nullptr;
+		if (!Root)
+		{
+			continue;
+		}
 
-	for (AActor* Actor : Actors)
-	{
-		if (Actor)
+		if (Root->GetAttachParent())
 		{
-			FVector Location = Actor->GetActorLocation();
-			FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
-			float ActorCenter = (ActorBounds.Min.Y + ActorBounds.Max.Y) * 0.5f;
-			float Offset = Location.Y - ActorCenter;
-			Location.Y = Center + Offset;
-			Actor->SetActorLocation(Location);
+			int32 Depth = 0;
+			for (const USceneComponent* Parent = Root->GetAttachParent(); Parent; Parent = Parent->GetAttachParent())
+			{
+				++Depth;
+			}
+			AttachedActors.Emplace(Depth, Index);
+			continue;
 		}
+
+		Root->SetRelativeLocation_Direct(Locations[Index]);
+		MovedRoots.Add(Root);
 	}
-}
 
-void UOPM_AlignmentUtilities::CenterActorsZ(TArray<AActor*> Actors)
-{
-	if (Actors.Num() < 2)
+	// Refresh world transforms once per root, children follow and render state is updated in bulk
+	for (USceneComponent* Root : MovedRoots)
 	{
-		return;
+		Root->UpdateComponentToWorld(EUpdateTransformFlags::None, ETeleportType::TeleportPhysics);
 	}
 
-	FBox Bounds = GetActorsBounds(Actors);
-	float Center = (Bounds.Min.Z + Bounds.Max.Z) * 0.5f;
-
-	for (AActor* Actor : Actors)
+	// Parents before children, so a child is placed against its parent's final transform
+	Algo::StableSortBy(AttachedActors, [](const TPair<int32, int32>& Pair) { return Pair.Key; });
+	for (const TPair<int32, int32>& Pair : AttachedActors)
 	{
-		if (Actor)
-		{
-			FVector Location = Actor->GetActorLocation();
-			FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
-			float ActorCenter = (ActorBounds.Min.Z + ActorBounds.Max.Z) * 0.5f;
-			float Offset = Location.Z - ActorCenter;
-			Location.Z = Center + Offset;
-			Actor->SetActorLocation(Location);
-		}
+		Actors[Pair.Value]->SetActorLocation(Locations[Pair.Value], false, nullptr, ETeleportType::TeleportPhysics);
 	}
-}
 
-void UOPM_AlignmentUtilities::DistributeActors(
-	TArray<AActor*> Actors,
-	EDistributionType Type)
-{
-	if (Actors.Num() < 3)
+	// UpdateComponentToWorld skips overlap tracking, refresh it once per moved hierarchy
+	for (USceneComponent* Root : MovedRoots)
 	{
-		return;
+		Root->UpdateOverlaps();
 	}
 
-	switch (Type)
+	if (NumActors > 0)
 	{
-	case EDistributionType::Horizontal:
-		DistributeActorsHorizontally(Actors);
-		break;
-	case EDistributionType::Vertical:
-		DistributeActorsVertically(Actors);
-		break;
-	case EDistributionType::Radial:
-		// Radial distribution not yet implemented
-		break;
+		FOPM_BulkEditScope::RequestViewportRedraw();
 	}
 }
 
-void UOPM_AlignmentUtilities::DistributeActorsHorizontally(TArray<AActor*> Actors)
+// Private helper methods
+
+void UOPM_AlignmentUtilities::CaptureSnapshot(TArrayView<AActor* const> Actors, FActorSnapshot& OutSnapshot)
 {
-	if (Actors.Num() < 3)
-	{
-		return;
-	}
+	OutSnapshot.Actors.Reset(Actors.Num());
+	OutSnapshot.Locations.Reset(Actors.Num());
+	OutSnapshot.Bounds.Reset(Actors.Num());
+	OutSnapshot.CombinedBounds = FBox(ForceInit);
 
-	// Sort actors by X position
-	Actors.Sort([](const AActor& A, const AActor& B) {
-		return A.GetActorLocation().X < B.GetActorLocation().X;
-	});
+	for (AActor* Actor : Actors)
+	{
+		if (!Actor)
+		{
+			continue;
+		}
 
-	FBox Bounds = GetActorsBounds(Actors);
-	float TotalDistance = Bounds.Max.X - Bounds.Min.X;
-	float Spacing = TotalDistance / (Actors.Num() - 1);
+		const FVector Location = Actor->GetActorLocation();
+		FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
 
-	// Keep first and last actors in place, distribute the rest
-	for (int32 i = 1; i < Actors.Num() - 1; ++i)
-	{
-		if (Actors[i])
+		// Actors without primitives still take part, as a point at their location
+		if (!ActorBounds.IsValid)
 		{
-			FVector Location = Actors[i]->GetActorLocation();
-			Location.X = Bounds.Min.X + Spacing * i;
-			Actors[i]->SetActorLocation(Location);
+			ActorBounds = FBox(Location, Location);
 		}
+
+		OutSnapshot.Actors.Add(Actor);
+		OutSnapshot.Locations.Add(Location);
+		OutSnapshot.Bounds.Add(ActorBounds);
+		OutSnapshot.CombinedBounds += ActorBounds;
 	}
 }
 
-void UOPM_AlignmentUtilities::DistributeActorsVertically(TArray<AActor*> Actors)
+void UOPM_AlignmentUtilities::AlignToAnchor(TArrayView<AActor* const> Actors, int32 Axis, float Anchor)
 {
-	if (Actors.Num() < 3)
+	if (Actors.Num() < 2)
 	{
 		return;
 	}
 
-	// Sort actors by Z position
-	Actors.Sort([](const AActor& A, const AActor& B) {
-		return A.GetActorLocation().Z < B.GetActorLocation().Z;
-	});
+	FActorSnapshot Snapshot;
+	CaptureSnapshot(Actors, Snapshot);
 
-	FBox Bounds = GetActorsBounds(Actors);
-	float TotalDistance = Bounds.Max.Z - Bounds.Min.Z;
-	float Spacing = TotalDistance / (Actors.Num() - 1);
+	const float AlignValue = FMath::Lerp(Snapshot.CombinedBounds.Min[Axis], Snapshot.CombinedBounds.Max[Axis], Anchor);
 
-	// Keep first and last actors in place, distribute the rest
-	for (int32 i = 1; i < Actors.Num() - 1; ++i)
+	TArray<FVector> Locations = Snapshot.Locations;
+	for (int32 Index = 0; Index < Locations.Num(); ++Index)
 	{
-		if (Actors[i])
-		{
-			FVector Location = Actors[i]->GetActorLocation();
-			Location.Z = Bounds.Min.Z + Spacing * i;
-			Actors[i]->SetActorLocation(Location);
-		}
+		const FBox& ActorBounds = Snapshot.Bounds[Index];
+		const float ActorAnchor = FMath::Lerp(ActorBounds.Min[Axis], ActorBounds.Max[Axis], Anchor);
+		Locations[Index][Axis] = AlignValue + (Locations[Index][Axis] - ActorAnchor);
 	}
+
+	CommitActorLocations(Snapshot.Actors, Locations);
 }
 
-FBox UOPM_AlignmentUtilities::GetActorsBounds(const TArray<AActor*>& Actors)
+void UOPM_AlignmentUtilities::DistributeAlongAxis(TArrayView<AActor* const> Actors, int32 Axis)
 {
-	FBox Bounds(ForceInit);
+	FActorSnapshot Snapshot;
+	CaptureSnapshot(Actors, Snapshot);
 
-	for (AActor* Actor : Actors)
+	const int32 NumActors = Snapshot.Actors.Num();
+	if (NumActors < 3)
 	{
-		if (Actor)
-		{
-			FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
-			Bounds += ActorBounds;
-		}
+		return;
 	}
 
-	return Bounds;
-}
-
-FVector UOPM_AlignmentUtilities::GetActorsCenter(const TArray<AActor*>& Actors)
-{
-	FBox Bounds = GetActorsBounds(Actors);
-	return Bounds.GetCenter();
-}
-
-void UOPM_AlignmentUtilities::SnapActorToGrid(AActor* Actor, float GridSize)
-{
-	if (!Actor || GridSize <= 0.0f)
+	// Order by location along the axis
+	TArray<int32> Order;
+	Order.Reserve(NumActors);
+	for (int32 Index = 0; Index < NumActors; ++Index)
 	{
-		return;
+		Order.Add(Index);
 	}
+	Order.Sort([&Snapshot, Axis](int32 A, int32 B)
+	{
+		return Snapshot.Locations[A][Axis] < Snapshot.Locations[B][Axis];
+	});
 
-	FVector Location = Actor->GetActorLocation();
-	Location.X = FMath::GridSnap(Location.X, GridSize);
-	Location.Y = FMath::GridSnap(Location.Y, GridSize);
-	Location.Z = FMath::GridSnap(Location.Z, GridSize);
-	Actor->SetActorLocation(Location);
-}
+	const float Min = Snapshot.CombinedBounds.Min[Axis];
+	const float Spacing = (Snapshot.CombinedBounds.Max[Axis] - Min) / (NumActors - 1);
 
-void UOPM_AlignmentUtilities::SnapActorsToGrid(TArray<AActor*> Actors, float GridSize)
-{
-	for (AActor* Actor : Actors)
+	// Keep first and last actors in place, distribute the rest
+	TArray<AActor*> Moved;
+	TArray<FVector> Locations;
+	for (int32 Rank = 1; Rank < NumActors - 1; ++Rank)
 	{
-		SnapActorToGrid(Actor, GridSize);
+		const int32 Index = Order[Rank];
+		FVector Location = Snapshot.Locations[Index];
+		Location[Axis] = Min + Spacing * Rank;
+
+		Moved.Add(Snapshot.Actors[Index]);
+		Locations.Add(Location);
 	}
+
+	CommitActorLocations(Moved, Locations);
 }
 
 #undef LOCTEXT_NAMESPACE
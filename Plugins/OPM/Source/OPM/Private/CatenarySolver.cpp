@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CatenarySolver.h"
+#include "Async/ParallelFor.h"
+#include <cmath>
+
+namespace OPMCatenary
+{
+	/** Spans solved per parallel task */
+	const int32 BatchSize = 64;
+
+	/** Bisection steps on log(a), enough for double precision over the bracket */
+	const int32 SolveIterations = 60;
+
+	/** Parameter bracket relative to the span, the lower bound keeps sinh(Span / 2a) finite */
+	const double MinParameterRatio = 1.0e-3;
+	const double MaxParameterRatio = 1.0e6;
+
+	double GetHeight(double X, double Parameter, double VertexOffset)
+	{
+		return Parameter * (std::cosh((X - VertexOffset) / Parameter) - std::cosh(VertexOffset / Parameter));
+	}
+}
+
+void FOPM_CatenarySolver::SolveForSag(
+	TArrayView<const FVector> Starts,
+	TArrayView<const FVector> Ends,
+	float Sag,
+	int32 PointsPerSpan,
+	TArray<FVector>& OutPoints)
+{
+	Densify(Starts, Ends, PointsPerSpan, [Sag](double Span, double Rise)
+	{
+		return SolveParameterForSag(Span, Rise, Sag);
+	}, OutPoints);
+}
+
+void FOPM_CatenarySolver::SolveForTension(
+	TArrayView<const FVector> Starts,
+	TArrayView<const FVector> Ends,
+	float TensionRatio,
+	int32 PointsPerSpan,
+	TArray<FVector>& OutPoints)
+{
+	Densify(Starts, Ends, PointsPerSpan, [TensionRatio](double Span, double Rise)
+	{
+		return TensionRatio > 0.0f ? FMath::Max<double>(TensionRatio, Span * OPMCatenary::MinParameterRatio) : 0.0;
+	}, OutPoints);
+}
+
+double FOPM_CatenarySolver::SolveParameterForSag(double Span, double Rise, double Sag)
+{
+	if (Sag <= KINDA_SMALL_NUMBER || Span <= KINDA_SMALL_NUMBER)
+	{
+		return 0.0;
+	}
+
+	auto GetSag = [Span, Rise](double Parameter)
+	{
+		const double Middle = Span * 0.5;
+		return Rise * 0.5 - OPMCatenary::GetHeight(Middle, Parameter, GetVertexOffset(Span, Rise, Parameter));
+	};
+
+	// Sag falls monotonically as the parameter grows, bisect in log space across the bracket
+	double LogLow = FMath::Loge(Span * OPMCatenary::MinParameterRatio);
+	double LogHigh = FMath::Loge(Span * OPMCatenary::MaxParameterRatio);
+
+	if (GetSag(FMath::Exp(LogLow)) <= Sag)
+	{
+		return FMath::Exp(LogLow);
+	}
+
+	for (int32 Iteration = 0; Iteration < OPMCatenary::SolveIterations; ++Iteration)
+	{
+		const double LogMid = (LogLow + LogHigh) * 0.5;
+		if (GetSag(FMath::Exp(LogMid)) > Sag)
+		{
+			LogLow = LogMid;
+		}
+		else
+		{
+			LogHigh = LogMid;
+		}
+	}
+
+	return FMath::Exp((LogLow + LogHigh) * 0.5);
+}
+
+// Private helper methods
+
+template<typename ParameterFunc>
+void FOPM_CatenarySolver::Densify(
+	TArrayView<const FVector> Starts,
+	TArrayView<const FVector> Ends,
+	int32 PointsPerSpan,
+	ParameterFunc&& GetParameter,
+	TArray<FVector>& OutPoints)
+{
+	const int32 NumSpans = FMath::Min(Starts.Num(), Ends.Num());
+	PointsPerSpan = FMath::Max(PointsPerSpan, 1);
+	const int32 Stride = PointsPerSpan + 1;
+
+	OutPoints.SetNumUninitialized(NumSpans * Stride);
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumSpans, OPMCatenary::BatchSize);
+	ParallelFor(NumBatches, [&](int32 Batch)
+	{
+		const int32 First = Batch * OPMCatenary::BatchSize;
+		const int32 Last = FMath::Min(First + OPMCatenary::BatchSize, NumSpans);
+
+		for (int32 SpanIndex = First; SpanIndex < Last; ++SpanIndex)
+		{
+			const FVector& Start = Starts[SpanIndex];
+			const FVector& End = Ends[SpanIndex];
+
+			const FVector Horizontal(End.X - Start.X, End.Y - Start.Y, 0.0);
+			const double Span = Horizontal.Size();
+			const double Rise = End.Z - Start.Z;
+			const FVector Direction = Span > KINDA_SMALL_NUMBER ? Horizontal / Span : FVector::ZeroVector;
+
+			const double Parameter = Span > KINDA_SMALL_NUMBER ? GetParameter(Span, Rise) : 0.0;
+			const double VertexOffset = Parameter > 0.0 ? GetVertexOffset(Span, Rise, Parameter) : 0.0;
+
+			FVector* SpanPoints = OutPoints.GetData() + SpanIndex * Stride;
+			for (int32 Step = 0; Step <= PointsPerSpan; ++Step)
+			{
+				const double Alpha = static_cast<double>(Step) / PointsPerSpan;
+
+				// Straight or vertical spans fall back to the chord
+				if (Parameter <= 0.0)
+				{
+					SpanPoints[Step] = FMath::Lerp(Start, End, Alpha);
+					continue;
+				}
+
+				const double X = Span * Alpha;
+				const double Height = OPMCatenary::GetHeight(X, Parameter, VertexOffset);
+				SpanPoints[Step] = Start + Direction * X + FVector(0.0, 0.0, Height);
+			}
+
+			// Pin the ends exactly to the supports
+			SpanPoints[0] = Start;
+			SpanPoints[PointsPerSpan] = End;
+		}
+	}, NumBatches <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+double FOPM_CatenarySolver::GetVertexOffset(double Span, double Rise, double Parameter)
+{
+	// From a (cosh((Span - x0) / a) - cosh(x0 / a)) = Rise
+	const double HalfAngle = Span / (2.0 * Parameter);
+	return Span * 0.5 - Parameter * std::asinh(Rise / (2.0 * Parameter * std::sinh(HalfAngle)));
+}
@@ -0,0 +1,355 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FoliageSpatialIndex.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "FoliageType.h"
+#include "InstancedFoliage.h"
+#include "InstancedFoliageActor.h"
+
+namespace OPMFoliageIndex
+{
+	/** Grid cell size in world units, close to typical query radii so border cells stay small */
+	const double CellSize = 256.0;
+
+	/** Spacing assumed for foliage types painted without a minimum radius */
+	const float DefaultInstanceSpacing = 100.0f;
+
+	TMap<TObjectKey<UWorld>, TUniquePtr<FOPM_FoliageSpatialIndex>> WorldIndices;
+
+	/** Helper to find the cell holding a location */
+	static FIntPoint GetCell(const FVector2D& Location)
+	{
+		return FIntPoint(
+			FMath::FloorToInt32(Location.X / CellSize),
+			FMath::FloorToInt32(Location.Y / CellSize));
+	}
+}
+
+FOPM_FoliageSpatialIndex::FOPM_FoliageSpatialIndex(UWorld* InWorld)
+	: World(InWorld)
+{
+#if WITH_EDITOR
+	InstanceCountChangedHandle = AInstancedFoliageActor::InstanceCountChanged().AddRaw(this, &FOPM_FoliageSpatialIndex::OnInstanceCountChanged);
+#endif
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FOPM_FoliageSpatialIndex::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FOPM_FoliageSpatialIndex::OnLevelChanged);
+}
+
+FOPM_FoliageSpatialIndex::~FOPM_FoliageSpatialIndex()
+{
+#if WITH_EDITOR
+	AInstancedFoliageActor::InstanceCountChanged().Remove(InstanceCountChangedHandle);
+#endif
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+}
+
+FOPM_FoliageSpatialIndex* FOPM_FoliageSpatialIndex::Get(UWorld* World)
+{
+	check(IsInGameThread());
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	// Drop indices of worlds that have since been destroyed
+	for (auto It = OPMFoliageIndex::WorldIndices.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TUniquePtr<FOPM_FoliageSpatialIndex>& Index = OPMFoliageIndex::WorldIndices.FindOrAdd(World);
+	if (!Index)
+	{
+		Index = MakeUnique<FOPM_FoliageSpatialIndex>(World);
+	}
+
+	Index->Update();
+	return Index.Get();
+}
+
+void FOPM_FoliageSpatialIndex::ReleaseAll()
+{
+	OPMFoliageIndex::WorldIndices.Empty();
+}
+
+void FOPM_FoliageSpatialIndex::Update()
+{
+	if (bNeedsDiscovery)
+	{
+		DiscoverTypes();
+	}
+
+	for (auto It = Grids.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().bDirty)
+		{
+			continue;
+		}
+
+		const UFoliageType* FoliageType = It.Key().ResolveObjectPtr();
+		if (!FoliageType)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		UpdateType(FoliageType, It.Value());
+	}
+}
+
+float FOPM_FoliageSpatialIndex::GetDensity(const FVector& Location, float Radius) const
+{
+	if (Radius <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	const FVector2D Min(Location.X - Radius, Location.Y - Radius);
+	const FVector2D Max(Location.X + Radius, Location.Y + Radius);
+	const float QueryArea = FMath::Square(2.0f * Radius);
+
+	// Sum the area covered by each type's instances at their painted spacing
+	float CoveredArea = 0.0f;
+	for (const auto& Pair : Grids)
+	{
+		const FTypeGrid& Grid = Pair.Value;
+		CoveredArea += Grid.CountInRect(Min, Max) * Grid.InstanceFootprint;
+	}
+
+	return FMath::Clamp(CoveredArea / QueryArea, 0.0f, 1.0f);
+}
+
+int32 FOPM_FoliageSpatialIndex::CountInstances(const FVector& Location, float Radius) const
+{
+	const FVector2D Min(Location.X - Radius, Location.Y - Radius);
+	const FVector2D Max(Location.X + Radius, Location.Y + Radius);
+
+	int32 Count = 0;
+	for (const auto& Pair : Grids)
+	{
+		Count += Pair.Value.CountInRect(Min, Max);
+	}
+
+	return Count;
+}
+
+void FOPM_FoliageSpatialIndex::Invalidate(const UFoliageType* FoliageType)
+{
+	if (FTypeGrid* Grid = Grids.Find(FoliageType))
+	{
+		Grid->bDirty = true;
+	}
+	else
+	{
+		// Newly painted type
+		Grids.Add(FoliageType);
+	}
+}
+
+void FOPM_FoliageSpatialIndex::InvalidateAll()
+{
+	for (auto& Pair : Grids)
+	{
+		Pair.Value.bDirty = true;
+	}
+
+	bNeedsDiscovery = true;
+}
+
+// Private helper methods
+
+int32 FOPM_FoliageSpatialIndex::FTypeGrid::CountInRect(const FVector2D& Min, const FVector2D& Max) const
+{
+	if (Cells.Num() == 0 || Min.X > Max.X || Min.Y > Max.Y)
+	{
+		return 0;
+	}
+
+	const FIntPoint MinCell = OPMFoliageIndex::GetCell(Min);
+	const FIntPoint MaxCell = OPMFoliageIndex::GetCell(Max);
+
+	int32 Count = 0;
+	auto CountCell = [&Min, &Max, &MinCell, &MaxCell, &Count](const FIntPoint& Cell, const TArray<FVector2D>& Locations)
+	{
+		// Cells wholly inside the rectangle count in full, border cells test each instance
+		if (Cell.X > MinCell.X && Cell.X < MaxCell.X && Cell.Y > MinCell.Y && Cell.Y < MaxCell.Y)
+		{
+			Count += Locations.Num();
+			return;
+		}
+
+		for (const FVector2D& Location : Locations)
+		{
+			if (Location.X >= Min.X && Location.X <= Max.X && Location.Y >= Min.Y && Location.Y <= Max.Y)
+			{
+				++Count;
+			}
+		}
+	};
+
+	// Large queries walk the occupied cells instead of every cell under the rectangle
+	const int64 NumQueryCells = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+	if (NumQueryCells > Cells.Num())
+	{
+		for (const auto& Pair : Cells)
+		{
+			const FIntPoint& Cell = Pair.Key;
+			if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X && Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y)
+			{
+				CountCell(Cell, Pair.Value);
+			}
+		}
+		return Count;
+	}
+
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			const FIntPoint Cell(X, Y);
+			if (const TArray<FVector2D>* Locations = Cells.Find(Cell))
+			{
+				CountCell(Cell, *Locations);
+			}
+		}
+	}
+
+	return Count;
+}
+
+void FOPM_FoliageSpatialIndex::FTypeGrid::AddLocation(const FVector2D& Location)
+{
+	Cells.FindOrAdd(OPMFoliageIndex::GetCell(Location)).Add(Location);
+}
+
+void FOPM_FoliageSpatialIndex::FTypeGrid::RemoveLocation(const FVector2D& Location)
+{
+	const FIntPoint Cell = OPMFoliageIndex::GetCell(Location);
+	if (TArray<FVector2D>* Locations = Cells.Find(Cell))
+	{
+		Locations->RemoveSingleSwap(Location, false);
+		if (Locations->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void FOPM_FoliageSpatialIndex::UpdateType(const UFoliageType* FoliageType, FTypeGrid& Grid) const
+{
+	Grid.bDirty = false;
+
+	const float Spacing = FMath::Max(FoliageType->Radius, OPMFoliageIndex::DefaultInstanceSpacing);
+	Grid.InstanceFootprint = FMath::Square(Spacing);
+
+	UWorld* IndexedWorld = World.Get();
+	if (!IndexedWorld)
+	{
+		Grid.Cells.Empty();
+		Grid.SourceLocations.Empty();
+		return;
+	}
+
+	// Diff each foliage actor (one per level / partition cell) against the locations read last time.
+	// Every instance of the type is still read, but only the cells of instances a paint stroke added,
+	// moved or removed are written
+	TSet<TObjectKey<AInstancedFoliageActor>> SeenActors;
+	for (TActorIterator<AInstancedFoliageActor> It(IndexedWorld); It; ++It)
+	{
+		const FFoliageInfo* Info = It->FindInfo(FoliageType);
+		if (!Info)
+		{
+			continue;
+		}
+
+		SeenActors.Add(*It);
+		TArray<FVector2D>& Previous = Grid.SourceLocations.FindOrAdd(*It);
+
+		const int32 NumInstances = Info->Instances.Num();
+		const int32 NumShared = FMath::Min(NumInstances, Previous.Num());
+
+		for (int32 Index = 0; Index < NumShared; ++Index)
+		{
+			const FVector& Current = Info->Instances[Index].Location;
+			const FVector2D Location(Current.X, Current.Y);
+			if (Location != Previous[Index])
+			{
+				Grid.RemoveLocation(Previous[Index]);
+				Grid.AddLocation(Location);
+				Previous[Index] = Location;
+			}
+		}
+
+		for (int32 Index = NumShared; Index < Previous.Num(); ++Index)
+		{
+			Grid.RemoveLocation(Previous[Index]);
+		}
+		Previous.SetNumUninitialized(NumShared);
+
+		for (int32 Index = NumShared; Index < NumInstances; ++Index)
+		{
+			const FVector& Current = Info->Instances[Index].Location;
+			const FVector2D Location(Current.X, Current.Y);
+			Grid.AddLocation(Location);
+			Previous.Add(Location);
+		}
+	}
+
+	// Foliage actors that were unloaded, destroyed or no longer hold the type
+	for (auto It = Grid.SourceLocations.CreateIterator(); It; ++It)
+	{
+		if (!SeenActors.Contains(It.Key()))
+		{
+			for (const FVector2D& Location : It.Value())
+			{
+				Grid.RemoveLocation(Location);
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FOPM_FoliageSpatialIndex::DiscoverTypes()
+{
+	bNeedsDiscovery = false;
+
+	UWorld* IndexedWorld = World.Get();
+	if (!IndexedWorld)
+	{
+		return;
+	}
+
+	for (TActorIterator<AInstancedFoliageActor> It(IndexedWorld); It; ++It)
+	{
+		It->ForEachFoliageInfo([this](UFoliageType* FoliageType, FFoliageInfo& Info)
+		{
+			if (FoliageType && !Grids.Contains(FoliageType))
+			{
+				Grids.Add(FoliageType);
+			}
+			return true;
+		});
+	}
+}
+
+void FOPM_FoliageSpatialIndex::OnInstanceCountChanged(const UFoliageType* FoliageType)
+{
+	if (FoliageType)
+	{
+		Invalidate(FoliageType);
+	}
+}
+
+void FOPM_FoliageSpatialIndex::OnLevelChanged(ULevel* Level, UWorld* InWorld)
+{
+	if (InWorld == World.Get())
+	{
+		InvalidateAll();
+	}
+}
@@ -0,0 +1,431 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LandscapeHeightSnapshot.h"
+#include "Landscape.h"
+#include "LandscapeInfo.h"
+#include "LandscapeDataAccess.h"
+#include "Async/ParallelFor.h"
+
+#if WITH_EDITOR
+#include "LandscapeEdit.h"
+#endif
+
+namespace OPMHeightSnapshot
+{
+	/** Cells per side of a marching squares tile */
+	const int32 ContourTileSize = 64;
+
+	/** Contour segment between two grid edges */
+	struct FContourSegment
+	{
+		int64 EdgeA;
+		int64 EdgeB;
+	};
+
+	/** Grid edge id: horizontal edges start at (X, Y) going +X, vertical edges going +Y */
+	int64 MakeEdgeKey(int32 X, int32 Y, int32 SizeX, bool bVertical)
+	{
+		return ((static_cast<int64>(Y) * SizeX + X) << 1) | (bVertical ? 1 : 0);
+	}
+}
+
+bool FOPM_LandscapeHeightSnapshot::Capture(ALandscape* Landscape, const FBox& Bounds, int32 MaxResolution)
+{
+	Heights.Reset();
+	Loaded.Reset();
+	SizeX = 0;
+	SizeY = 0;
+
+	if (!Landscape)
+	{
+		return false;
+	}
+
+#if WITH_EDITOR
+	ULandscapeInfo* LandscapeInfo = Landscape->GetLandscapeInfo();
+	int32 MinX, MinY, MaxX, MaxY;
+	if (!LandscapeInfo || !LandscapeInfo->GetLandscapeExtent(MinX, MinY, MaxX, MaxY))
+	{
+		return false;
+	}
+
+	LandscapeTransform = Landscape->GetTransform();
+
+	// Convert the requested area to quad coordinates and clip to the landscape
+	const FVector LocalA = LandscapeTransform.InverseTransformPosition(FVector(Bounds.Min.X, Bounds.Min.Y, 0.0f));
+	const FVector LocalB = LandscapeTransform.InverseTransformPosition(FVector(Bounds.Max.X, Bounds.Max.Y, 0.0f));
+
+	const int32 X1 = FMath::Max(MinX, FMath::FloorToInt(FMath::Min(LocalA.X, LocalB.X)));
+	const int32 Y1 = FMath::Max(MinY, FMath::FloorToInt(FMath::Min(LocalA.Y, LocalB.Y)));
+	const int32 X2 = FMath::Min(MaxX, FMath::CeilToInt(FMath::Max(LocalA.X, LocalB.X)));
+	const int32 Y2 = FMath::Min(MaxY, FMath::CeilToInt(FMath::Max(LocalA.Y, LocalB.Y)));
+
+	if (X2 - X1 < 1 || Y2 - Y1 < 1)
+	{
+		return false;
+	}
+
+	const int32 QuadsX = X2 - X1;
+	const int32 QuadsY = Y2 - Y1;
+	Stride = FMath::Max(1, FMath::DivideAndRoundUp(FMath::Max(QuadsX, QuadsY), FMath::Max(MaxResolution - 1, 1)));
+	Origin = FIntPoint(X1, Y1);
+	SizeX = QuadsX / Stride + 1;
+	SizeY = QuadsY / Stride + 1;
+
+	// The extent spans World Partition regions that are not loaded, only loaded components hold real heights
+	const int32 ComponentSizeQuads = LandscapeInfo->ComponentSizeQuads;
+	if (ComponentSizeQuads <= 0)
+	{
+		SizeX = 0;
+		SizeY = 0;
+		return false;
+	}
+
+	Loaded.Init(false, SizeX * SizeY);
+	bool bAnyLoaded = false;
+
+	for (int32 KeyY = FMath::DivideAndRoundDown(Y1, ComponentSizeQuads); KeyY <= FMath::DivideAndRoundDown(Y2, ComponentSizeQuads); ++KeyY)
+	{
+		for (int32 KeyX = FMath::DivideAndRoundDown(X1, ComponentSizeQuads); KeyX <= FMath::DivideAndRoundDown(X2, ComponentSizeQuads); ++KeyX)
+		{
+			if (!LandscapeInfo->XYtoComponentMap.Contains(FIntPoint(KeyX, KeyY)))
+			{
+				continue;
+			}
+
+			// Samples on the component's quads, including its shared far border
+			const int32 SampleMinX = FMath::Max(0, FMath::DivideAndRoundUp(KeyX * ComponentSizeQuads - X1, Stride));
+			const int32 SampleMinY = FMath::Max(0, FMath::DivideAndRoundUp(KeyY * ComponentSizeQuads - Y1, Stride));
+			const int32 SampleMaxX = FMath::Min(SizeX - 1, ((KeyX + 1) * ComponentSizeQuads - X1) / Stride);
+			const int32 SampleMaxY = FMath::Min(SizeY - 1, ((KeyY + 1) * ComponentSizeQuads - Y1) / Stride);
+
+			for (int32 Y = SampleMinY; Y <= SampleMaxY && SampleMinX <= SampleMaxX; ++Y)
+			{
+				Loaded.SetRange(Y * SizeX + SampleMinX, SampleMaxX - SampleMinX + 1, true);
+				bAnyLoaded = true;
+			}
+		}
+	}
+
+	if (!bAnyLoaded)
+	{
+		Loaded.Reset();
+		SizeX = 0;
+		SizeY = 0;
+		return false;
+	}
+
+	FLandscapeEditDataInterface LandscapeEdit(LandscapeInfo);
+	const uint16 ZeroHeight = LandscapeDataAccess::GetTexHeight(0.0f);
+
+	TArray<uint16> RawHeights;
+	if (Stride == 1)
+	{
+		RawHeights.Init(ZeroHeight, SizeX * SizeY);
+		LandscapeEdit.GetHeightDataFast(X1, Y1, X1 + SizeX - 1, Y1 + SizeY - 1, RawHeights.GetData(), SizeX);
+	}
+	else
+	{
+		// Read only the rows we keep, then drop the skipped columns
+		RawHeights.SetNumUninitialized(SizeX * SizeY);
+		TArray<uint16> Row;
+		const int32 RowLength = (SizeX - 1) * Stride + 1;
+
+		for (int32 Y = 0; Y < SizeY; ++Y)
+		{
+			const int32 QuadY = Y1 + Y * Stride;
+			Row.Init(ZeroHeight, RowLength);
+			LandscapeEdit.GetHeightDataFast(X1, QuadY, X1 + RowLength - 1, QuadY, Row.GetData(), RowLength);
+
+			for (int32 X = 0; X < SizeX; ++X)
+			{
+				RawHeights[Y * SizeX + X] = Row[X * Stride];
+			}
+		}
+	}
+
+	// Convert to world heights once so queries are plain lookups
+	Heights.SetNumUninitialized(SizeX * SizeY);
+	for (int32 Y = 0; Y < SizeY; ++Y)
+	{
+		for (int32 X = 0; X < SizeX; ++X)
+		{
+			const float LocalHeight = LandscapeDataAccess::GetLocalHeight(RawHeights[Y * SizeX + X]);
+			const FVector Local(Origin.X + X * Stride, Origin.Y + Y * Stride, LocalHeight);
+			Heights[Y * SizeX + X] = LandscapeTransform.TransformPosition(Local).Z;
+		}
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool FOPM_LandscapeHeightSnapshot::SampleHeight(const FVector& Location, float& OutHeight) const
+{
+	if (!IsValid())
+	{
+		return false;
+	}
+
+	const FVector2D Grid = WorldToGrid(Location);
+	if (Grid.X < 0.0f || Grid.Y < 0.0f || Grid.X > SizeX - 1 || Grid.Y > SizeY - 1)
+	{
+		return false;
+	}
+
+	const int32 X0 = FMath::Min(FMath::FloorToInt(Grid.X), SizeX - 2);
+	const int32 Y0 = FMath::Min(FMath::FloorToInt(Grid.Y), SizeY - 2);
+	const float FracX = Grid.X - X0;
+	const float FracY = Grid.Y - Y0;
+
+	if (!IsLoaded(X0, Y0) || !IsLoaded(X0 + 1, Y0) || !IsLoaded(X0, Y0 + 1) || !IsLoaded(X0 + 1, Y0 + 1))
+	{
+		return false;
+	}
+
+	const float Top = FMath::Lerp(GetHeight(X0, Y0), GetHeight(X0 + 1, Y0), FracX);
+	const float Bottom = FMath::Lerp(GetHeight(X0, Y0 + 1), GetHeight(X0 + 1, Y0 + 1), FracX);
+
+	OutHeight = FMath::Lerp(Top, Bottom, FracY);
+	return true;
+}
+
+bool FOPM_LandscapeHeightSnapshot::SampleNormal(const FVector& Location, FVector& OutNormal) const
+{
+	if (!IsValid())
+	{
+		return false;
+	}
+
+	const FVector2D Grid = WorldToGrid(Location);
+	if (Grid.X < 0.0f || Grid.Y < 0.0f || Grid.X > SizeX - 1 || Grid.Y > SizeY - 1)
+	{
+		return false;
+	}
+
+	// Central differences on the nearest sample, one-sided next to holes and the snapshot border
+	const int32 X = FMath::RoundToInt(Grid.X);
+	const int32 Y = FMath::RoundToInt(Grid.Y);
+	if (!IsLoaded(X, Y))
+	{
+		return false;
+	}
+
+	const int32 XMin = (X > 0 && IsLoaded(X - 1, Y)) ? X - 1 : X;
+	const int32 XMax = (X < SizeX - 1 && IsLoaded(X + 1, Y)) ? X + 1 : X;
+	const int32 YMin = (Y > 0 && IsLoaded(X, Y - 1)) ? Y - 1 : Y;
+	const int32 YMax = (Y < SizeY - 1 && IsLoaded(X, Y + 1)) ? Y + 1 : Y;
+	if (XMin == XMax || YMin == YMax)
+	{
+		return false;
+	}
+
+	const FVector AlongX = GridToWorld(XMax, Y, GetHeight(XMax, Y)) - GridToWorld(XMin, Y, GetHeight(XMin, Y));
+	const FVector AlongY = GridToWorld(X, YMax, GetHeight(X, YMax)) - GridToWorld(X, YMin, GetHeight(X, YMin));
+
+	OutNormal = FVector::CrossProduct(AlongX, AlongY).GetSafeNormal();
+	if (OutNormal.Z < 0.0f)
+	{
+		OutNormal = -OutNormal;
+	}
+	return true;
+}
+
+void FOPM_LandscapeHeightSnapshot::ExtractIsoLines(float IsoHeight, TArray<TArray<FVector>>& OutLines) const
+{
+	using namespace OPMHeightSnapshot;
+
+	OutLines.Reset();
+
+	if (!IsValid())
+	{
+		return;
+	}
+
+	const int32 CellsX = SizeX - 1;
+	const int32 CellsY = SizeY - 1;
+	const int32 TilesX = FMath::DivideAndRoundUp(CellsX, ContourTileSize);
+	const int32 TilesY = FMath::DivideAndRoundUp(CellsY, ContourTileSize);
+
+	// Segment edges per case, corners: 0 = (X, Y), 1 = (X+1, Y), 2 = (X+1, Y+1), 3 = (X, Y+1)
+	// Edges: 0 = bottom, 1 = right, 2 = top, 3 = left. Saddles (5, 10) are resolved below.
+	static const int8 CaseEdges[16][2] =
+	{
+		{ -1, -1 }, { 3, 0 }, { 0, 1 }, { 3, 1 },
+		{ 1, 2 }, { -1, -1 }, { 0, 2 }, { 3, 2 },
+		{ 2, 3 }, { 0, 2 }, { -1, -1 }, { 1, 2 },
+		{ 3, 1 }, { 0, 1 }, { 3, 0 }, { -1, -1 }
+	};
+
+	TArray<TArray<FContourSegment>> TileSegments;
+	TileSegments.SetNum(TilesX * TilesY);
+
+	ParallelFor(TilesX * TilesY, [&](int32 TileIndex)
+	{
+		const int32 StartX = (TileIndex % TilesX) * ContourTileSize;
+		const int32 StartY = (TileIndex / TilesX) * ContourTileSize;
+		const int32 EndX = FMath::Min(StartX + ContourTileSize, CellsX);
+		const int32 EndY = FMath::Min(StartY + ContourTileSize, CellsY);
+
+		TArray<FContourSegment>& Segments = TileSegments[TileIndex];
+
+		for (int32 Y = StartY; Y < EndY; ++Y)
+		{
+			for (int32 X = StartX; X < EndX; ++X)
+			{
+				// Holes carry no heights, contouring them would trace their border
+				if (!IsLoaded(X, Y) || !IsLoaded(X + 1, Y) || !IsLoaded(X + 1, Y + 1) || !IsLoaded(X, Y + 1))
+				{
+					continue;
+				}
+
+				const float H0 = GetHeight(X, Y);
+				const float H1 = GetHeight(X + 1, Y);
+				const float H2 = GetHeight(X + 1, Y + 1);
+				const float H3 = GetHeight(X, Y + 1);
+
+				const int32 Case = (H0 >= IsoHeight ? 1 : 0) | (H1 >= IsoHeight ? 2 : 0) |
+					(H2 >= IsoHeight ? 4 : 0) | (H3 >= IsoHeight ? 8 : 0);
+
+				if (Case == 0 || Case == 15)
+				{
+					continue;
+				}
+
+				const int64 EdgeKeys[4] =
+				{
+					MakeEdgeKey(X, Y, SizeX, false),
+					MakeEdgeKey(X + 1, Y, SizeX, true),
+					MakeEdgeKey(X, Y + 1, SizeX, false),
+					MakeEdgeKey(X, Y, SizeX, true)
+				};
+
+				if (Case == 5 || Case == 10)
+				{
+					// Saddle: the cell centre decides which diagonal corners are connected
+					const bool bCenterInside = (H0 + H1 + H2 + H3) * 0.25f >= IsoHeight;
+					const bool bCutBottomRightAndTopLeft = (Case == 5) == bCenterInside;
+
+					if (bCutBottomRightAndTopLeft)
+					{
+						Segments.Add({ EdgeKeys[0], EdgeKeys[1] });
+						Segments.Add({ EdgeKeys[2], EdgeKeys[3] });
+					}
+					else
+					{
+						Segments.Add({ EdgeKeys[3], EdgeKeys[0] });
+						Segments.Add({ EdgeKeys[1], EdgeKeys[2] });
+					}
+					continue;
+				}
+
+				Segments.Add({ EdgeKeys[CaseEdges[Case][0]], EdgeKeys[CaseEdges[Case][1]] });
+			}
+		}
+	});
+
+	TArray<FContourSegment> Segments;
+	for (TArray<FContourSegment>& Tile : TileSegments)
+	{
+		Segments.Append(MoveTemp(Tile));
+	}
+
+	if (Segments.Num() == 0)
+	{
+		return;
+	}
+
+	// Each grid edge is shared by at most two segments
+	TMap<int64, FIntPoint> EdgeToSegments;
+	EdgeToSegments.Reserve(Segments.Num() * 2);
+	for (int32 i = 0; i < Segments.Num(); ++i)
+	{
+		for (int64 Edge : { Segments[i].EdgeA, Segments[i].EdgeB })
+		{
+			FIntPoint& Linked = EdgeToSegments.FindOrAdd(Edge, FIntPoint(INDEX_NONE, INDEX_NONE));
+			(Linked.X == INDEX_NONE ? Linked.X : Linked.Y) = i;
+		}
+	}
+
+	auto EdgeToWorld = [this, IsoHeight](int64 Edge)
+	{
+		const bool bVertical = (Edge & 1) != 0;
+		const int32 Index = static_cast<int32>(Edge >> 1);
+		const int32 X = Index % SizeX;
+		const int32 Y = Index / SizeX;
+		const float HA = GetHeight(X, Y);
+		const float HB = bVertical ? GetHeight(X, Y + 1) : GetHeight(X + 1, Y);
+		const float Alpha = FMath::IsNearlyEqual(HA, HB) ? 0.5f : FMath::Clamp((IsoHeight - HA) / (HB - HA), 0.0f, 1.0f);
+		return bVertical ? GridToWorld(X, Y + Alpha, IsoHeight) : GridToWorld(X + Alpha, Y, IsoHeight);
+	};
+
+	// Follow segments through shared edges until the chain ends or closes
+	auto Walk = [&](int32 StartSegment, int64 StartEdge, TBitArray<>& Visited, TArray<int64>& OutEdges)
+	{
+		int32 Segment = StartSegment;
+		int64 Edge = StartEdge;
+
+		while (true)
+		{
+			const FIntPoint& Linked = EdgeToSegments.FindChecked(Edge);
+			const int32 Next = (Linked.X == Segment) ? Linked.Y : Linked.X;
+			if (Next == INDEX_NONE || Visited[Next])
+			{
+				return Next == StartSegment;
+			}
+
+			Visited[Next] = true;
+			Edge = (Segments[Next].EdgeA == Edge) ? Segments[Next].EdgeB : Segments[Next].EdgeA;
+			Segment = Next;
+			OutEdges.Add(Edge);
+		}
+	};
+
+	TBitArray<> Visited(false, Segments.Num());
+	for (int32 i = 0; i < Segments.Num(); ++i)
+	{
+		if (Visited[i])
+		{
+			continue;
+		}
+		Visited[i] = true;
+
+		// A closed walk ends back on EdgeA, repeating the first point
+		TArray<int64> Forward = { Segments[i].EdgeA, Segments[i].EdgeB };
+		const bool bClosed = Walk(i, Segments[i].EdgeB, Visited, Forward);
+
+		TArray<int64> Backward;
+		if (!bClosed)
+		{
+			Walk(i, Segments[i].EdgeA, Visited, Backward);
+		}
+
+		TArray<FVector>& Line = OutLines.AddDefaulted_GetRef();
+		Line.Reserve(Backward.Num() + Forward.Num());
+		for (int32 j = Backward.Num() - 1; j >= 0; --j)
+		{
+			Line.Add(EdgeToWorld(Backward[j]));
+		}
+		for (int64 Edge : Forward)
+		{
+			Line.Add(EdgeToWorld(Edge));
+		}
+	}
+}
+
+// Private helper methods
+
+FVector2D FOPM_LandscapeHeightSnapshot::WorldToGrid(const FVector& Location) const
+{
+	const FVector Local = LandscapeTransform.InverseTransformPosition(FVector(Location.X, Location.Y, LandscapeTransform.GetLocation().Z));
+	return FVector2D((Local.X - Origin.X) / Stride, (Local.Y - Origin.Y) / Stride);
+}
+
+FVector FOPM_LandscapeHeightSnapshot::GridToWorld(float GridX, float GridY, float Height) const
+{
+	FVector World = LandscapeTransform.TransformPosition(FVector(Origin.X + GridX * Stride, Origin.Y + GridY * Stride, 0.0f));
+	World.Z = Height;
+	return World;
+}
@@ -1,18 +1,26 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "LandscapeIntegrationUtilities.h"
+#include "FoliageSpatialIndex.h"
+#include "LandscapeWeightmapCache.h"
+#include "LandscapeHeightSnapshot.h"
+#include "LandscapeTileCache.h"
+#include "TerrainSnapSubsystem.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "Landscape.h"
 #include "LandscapeComponent.h"
 #include "LandscapeInfo.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Reverse.h"
 
 TArray<AActor*> UOPM_LandscapeIntegrationUtilities::PlaceActorsOnLandscape(
 	UClass* ActorClass,
 	const TArray<FTransform>& Transforms,
 	ALandscape* Landscape,
 	const FLandscapePlacementSettings& Settings,
-	UWorld* World)
+	UWorld* World,
+	bool bKeepOnTerrain)
 {
 	TArray<AActor*> SpawnedActors;
 
@@ -21,6 +29,9 @@ TArray<AActor*> UOPM_LandscapeIntegrationUtilities::PlaceActorsOnLandscape(
 		return SpawnedActors;
 	}
 
+	const FOPM_LandscapeWeightmapCache* WeightmapCache = PrepareWeightmapCache(Landscape, Settings);
+	UOPM_TerrainSnapSubsystem* SnapSubsystem = bKeepOnTerrain ? UOPM_TerrainSnapSubsystem::Get() : nullptr;
+
 	for (const FTransform& Transform : Transforms)
 	{
 		// Adjust transform to align with terrain
@@ -30,7 +41,8 @@ TArray<AActor*> UOPM_LandscapeIntegrationUtilities::PlaceActorsOnLandscape(
 		float Slope = CalculateSlopeAngle(Landscape, AdjustedTransform.GetLocation());
 		float Height = AdjustedTransform.GetLocation().Z;
 
-		if (MeetsSlopeRequirements(Slope, Settings) && MeetsHeightRequirements(Height, Settings))
+		if (MeetsSlopeRequirements(Slope, Settings) && MeetsHeightRequirements(Height, Settings) &&
+			MeetsLayerRequirements(Landscape, WeightmapCache, AdjustedTransform.GetLocation(), Settings))
 		{
 			FActorSpawnParameters SpawnParams;
 			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
@@ -46,6 +58,12 @@ TArray<AActor*> UOPM_LandscapeIntegrationUtilities::PlaceActorsOnLandscape(
 			{
 				SpawnedActor->SetActorScale3D(AdjustedTransform.GetScale3D());
 				SpawnedActors.Add(SpawnedActor);
+
+				// Keep the actor on the terrain if the landscape is sculpted later
+				if (SnapSubsystem)
+				{
+					SnapSubsystem->RegisterActor(SpawnedActor, Landscape, Settings);
+				}
 			}
 		}
 	}
@@ -77,6 +95,13 @@ bool UOPM_LandscapeIntegrationUtilities::SampleLandscapeHeight(
 		return true;
 	}
 
+	// Region not loaded, read it from its World Partition streaming proxy
+	FOPM_LandscapeTileCache* TileCache = FOPM_LandscapeTileCache::Get(Landscape);
+	if (TileCache)
+	{
+		return TileCache->SampleHeight(Location, OutHeight);
+	}
+
 	return false;
 }
 
@@ -128,6 +153,28 @@ float UOPM_LandscapeIntegrationUtilities::CalculateSlopeAngle(
 	return 0.0f;
 }
 
+bool UOPM_LandscapeIntegrationUtilities::SampleLandscapeLayerWeight(
+	ALandscape* Landscape,
+	FName LayerName,
+	const FVector& Location,
+	float& OutWeight)
+{
+	FOPM_LandscapeWeightmapCache* WeightmapCache = FOPM_LandscapeWeightmapCache::Get(Landscape);
+	if (!WeightmapCache)
+	{
+		return false;
+	}
+
+	WeightmapCache->CacheLayer(LayerName);
+	if (WeightmapCache->SampleWeight(LayerName, Location, OutWeight))
+	{
+		return true;
+	}
+
+	FOPM_LandscapeTileCache* TileCache = FOPM_LandscapeTileCache::Get(Landscape);
+	return TileCache && TileCache->SampleWeight(LayerName, Location, OutWeight);
+}
+
 FTransform UOPM_LandscapeIntegrationUtilities::AlignToTerrain(
 	const FTransform& Transform,
 	ALandscape* Landscape,
@@ -297,6 +344,8 @@ TArray<FVector> UOPM_LandscapeIntegrationUtilities::FilterLocationsByTerrain(
 		return FilteredLocations;
 	}
 
+	const FOPM_LandscapeWeightmapCache* WeightmapCache = PrepareWeightmapCache(Landscape, Settings);
+
 	for (const FVector& Location : Locations)
 	{
 		float Height = 0.0f;
@@ -304,7 +353,8 @@ TArray<FVector> UOPM_LandscapeIntegrationUtilities::FilterLocationsByTerrain(
 		{
 			float Slope = CalculateSlopeAngle(Landscape, Location);
 
-			if (MeetsHeightRequirements(Height, Settings) && MeetsSlopeRequirements(Slope, Settings))
+			if (MeetsHeightRequirements(Height, Settings) && MeetsSlopeRequirements(Slope, Settings) &&
+				MeetsLayerRequirements(Landscape, WeightmapCache, Location, Settings))
 			{
 				FVector AdjustedLocation = Location;
 				AdjustedLocation.Z = Height;
@@ -325,89 +375,160 @@ TArray<FTransform> UOPM_LandscapeIntegrationUtilities::GenerateContourFollowingP
 {
 	TArray<FTransform> Transforms;
 
-	if (!Landscape || Count <= 0)
+	if (!Landscape || Count <= 0 || Spacing <= 0.0f)
 	{
 		return Transforms;
 	}
 
-	FVector CurrentLocation = StartLocation;
-	float CurrentHeight = 0.0f;
-	
-	if (!SampleLandscapeHeight(Landscape, CurrentLocation, CurrentHeight))
+	float ContourHeight = 0.0f;
+	if (!SampleLandscapeHeight(Landscape, StartLocation, ContourHeight))
 	{
 		return Transforms;
 	}
 
-	// Add first point
-	Transforms.Add(FTransform(FRotator::ZeroRotator, FVector(CurrentLocation.X, CurrentLocation.Y, CurrentHeight), FVector::OneVector));
+	// A contour of Count points can reach at most Count * Spacing away from the start
+	const float SearchExtent = Count * Spacing;
+	const FBox SearchBounds(
+		StartLocation - FVector(SearchExtent, SearchExtent, 0.0f),
+		StartLocation + FVector(SearchExtent, SearchExtent, 0.0f));
 
-	// Follow contour by finding points at similar height
-	for (int32 i = 1; i < Count; ++i)
+	FOPM_LandscapeHeightSnapshot Snapshot;
+	if (!Snapshot.Capture(Landscape, SearchBounds))
 	{
-		float BestScore = FLT_MAX;
-		FVector BestLocation = CurrentLocation;
+		return Transforms;
+	}
 
-		// Sample points around current location
-		const int32 NumSamples = 8;
-		for (int32 j = 0; j < NumSamples; ++j)
-		{
-			float Angle = (360.0f / NumSamples) * j;
-			FVector TestLocation = CurrentLocation + FVector(
-				FMath::Cos(FMath::DegreesToRadians(Angle)) * Spacing,
-				FMath::Sin(FMath::DegreesToRadians(Angle)) * Spacing,
-				0.0f
-			);
+	TArray<TArray<FVector>> Contours;
+	Snapshot.ExtractIsoLines(ContourHeight, Contours);
 
-			float TestHeight = 0.0f;
-			if (SampleLandscapeHeight(Landscape, TestLocation, TestHeight))
-			{
-				// Prefer points at similar height
-				float HeightDiff = FMath::Abs(TestHeight - CurrentHeight);
-				float Slope = CalculateSlopeAngle(Landscape, TestLocation);
+	// Find the contour passing closest to the start location
+	int32 BestContour = INDEX_NONE;
+	int32 BestSegment = INDEX_NONE;
+	FVector BestPoint = StartLocation;
+	float BestDistSquared = FLT_MAX;
 
-				if (MeetsSlopeRequirements(Slope, Settings))
-				{
-					if (HeightDiff < BestScore)
-					{
-						BestScore = HeightDiff;
-						BestLocation = FVector(TestLocation.X, TestLocation.Y, TestHeight);
-					}
-				}
+	for (int32 ContourIndex = 0; ContourIndex < Contours.Num(); ++ContourIndex)
+	{
+		const TArray<FVector>& Contour = Contours[ContourIndex];
+		for (int32 i = 0; i < Contour.Num() - 1; ++i)
+		{
+			const FVector Closest = FMath::ClosestPointOnSegment(StartLocation, Contour[i], Contour[i + 1]);
+			const float DistSquared = FVector::DistSquared2D(Closest, StartLocation);
+			if (DistSquared < BestDistSquared)
+			{
+				BestDistSquared = DistSquared;
+				BestContour = ContourIndex;
+				BestSegment = i;
+				BestPoint = Closest;
 			}
 		}
+	}
+
+	if (BestContour == INDEX_NONE)
+	{
+		return Transforms;
+	}
 
-		if (BestScore < FLT_MAX)
+	const TArray<FVector>& Contour = Contours[BestContour];
+	const bool bClosed = Contour.Num() > 2 && Contour[0].Equals(Contour.Last());
+
+	// Walk forward from the start point (once around for closed contours)
+	TArray<FVector> ForwardPath = { BestPoint };
+	for (int32 i = BestSegment + 1; i < Contour.Num(); ++i)
+	{
+		ForwardPath.Add(Contour[i]);
+	}
+	if (bClosed)
+	{
+		for (int32 i = 1; i <= BestSegment; ++i)
 		{
-			CurrentLocation = BestLocation;
-			Transforms.Add(FTransform(FRotator::ZeroRotator, CurrentLocation, FVector::OneVector));
+			ForwardPath.Add(Contour[i]);
 		}
-		else
+		ForwardPath.Add(BestPoint);
+	}
+
+	TArray<FVector> Points = ResamplePolyline(ForwardPath, Spacing, Count);
+
+	// Open contours may run out ahead, continue behind the start point
+	if (!bClosed && Points.Num() < Count)
+	{
+		TArray<FVector> BackwardPath = { BestPoint };
+		for (int32 i = BestSegment; i >= 0; --i)
 		{
-			break; // Can't find valid next point
+			BackwardPath.Add(Contour[i]);
+		}
+
+		TArray<FVector> BackwardPoints = ResamplePolyline(BackwardPath, Spacing, Count - Points.Num() + 1);
+		if (BackwardPoints.Num() > 1)
+		{
+			Algo::Reverse(BackwardPoints);
+			BackwardPoints.Pop(); // Start point is already in Points
+			BackwardPoints.Append(Points);
+			Points = MoveTemp(BackwardPoints);
 		}
 	}
 
+	Transforms.Reserve(Points.Num());
+	for (int32 i = 0; i < Points.Num(); ++i)
+	{
+		FVector Normal;
+		if (Snapshot.SampleNormal(Points[i], Normal))
+		{
+			const float Slope = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(Normal.Z, -1.0f, 1.0f)));
+			if (!MeetsSlopeRequirements(Slope, Settings))
+			{
+				continue;
+			}
+		}
+
+		if (!MeetsHeightRequirements(Points[i].Z, Settings))
+		{
+			continue;
+		}
+
+		// Face along the contour
+		const FVector Tangent = Points[FMath::Min(i + 1, Points.Num() - 1)] - Points[FMath::Max(i - 1, 0)];
+		const FRotator Rotation(0.0f, Tangent.IsNearlyZero() ? 0.0f : Tangent.Rotation().Yaw, 0.0f);
+
+		Transforms.Add(FTransform(Rotation, Points[i], FVector::OneVector));
+	}
+
 	return Transforms;
 }
 
+TArray<TArray<FVector>> UOPM_LandscapeIntegrationUtilities::ExtractContourLines(
+	ALandscape* Landscape,
+	const FBox& BoundsBox,
+	float Height)
+{
+	TArray<TArray<FVector>> Contours;
+
+	FOPM_LandscapeHeightSnapshot Snapshot;
+	if (Snapshot.Capture(Landscape, BoundsBox))
+	{
+		Snapshot.ExtractIsoLines(Height, Contours);
+	}
+
+	return Contours;
+}
+
 float UOPM_LandscapeIntegrationUtilities::GetFoliageDensityAtLocation(
 	ALandscape* Landscape,
 	const FVector& Location,
 	float Radius)
 {
-	// Placeholder implementation
-	// In a full implementation, this would query the foliage system
-	// For now, return a simple value based on terrain complexity
-	
 	if (!Landscape)
 	{
 		return 0.0f;
 	}
 
-	float Complexity = CalculateTerrainComplexity(Landscape, Location, Radius);
-	
-	// Simple heuristic: more complex terrain tends to have more foliage
-	return FMath::Clamp(Complexity * 0.7f, 0.0f, 1.0f);
+	const FOPM_FoliageSpatialIndex* FoliageIndex = FOPM_FoliageSpatialIndex::Get(Landscape->GetWorld());
+	if (!FoliageIndex)
+	{
+		return 0.0f;
+	}
+
+	return FoliageIndex->GetDensity(Location, Radius);
 }
 
 TArray<FVector> UOPM_LandscapeIntegrationUtilities::FilterLocationsByFoliage(
@@ -422,13 +543,29 @@ TArray<FVector> UOPM_LandscapeIntegrationUtilities::FilterLocationsByFoliage(
 		return FilteredLocations;
 	}
 
-	for (const FVector& Location : Locations)
+	// Resolve the index once on the game thread, queries below are read-only
+	const FOPM_FoliageSpatialIndex* FoliageIndex = FOPM_FoliageSpatialIndex::Get(Landscape->GetWorld());
+	if (!FoliageIndex)
 	{
-		float Density = GetFoliageDensityAtLocation(Landscape, Location);
-		
-		if (Density <= FoliageDensityThreshold)
+		return Locations;
+	}
+
+	const float QueryRadius = 100.0f; // Matches GetFoliageDensityAtLocation's default radius
+
+	TArray<bool> bKeep;
+	bKeep.SetNumUninitialized(Locations.Num());
+
+	ParallelFor(Locations.Num(), [&](int32 Index)
+	{
+		bKeep[Index] = FoliageIndex->GetDensity(Locations[Index], QueryRadius) <= FoliageDensityThreshold;
+	});
+
+	FilteredLocations.Reserve(Locations.Num());
+	for (int32 i = 0; i < Locations.Num(); ++i)
+	{
+		if (bKeep[i])
 		{
-			FilteredLocations.Add(Location);
+			FilteredLocations.Add(Locations[i]);
 		}
 	}
 
@@ -463,6 +600,8 @@ TArray<FVector> UOPM_LandscapeIntegrationUtilities::GetSuitablePlacementLocation
 		return SuitableLocations;
 	}
 
+	const FOPM_LandscapeWeightmapCache* WeightmapCache = PrepareWeightmapCache(Landscape, Settings);
+
 	// Sample grid of points within bounds
 	int32 GridSize = FMath::CeilToInt(FMath::Sqrt(MaxLocations * 2.0f));
 	FVector BoundsSize = BoundsBox.GetSize();
@@ -483,7 +622,8 @@ TArray<FVector> UOPM_LandscapeIntegrationUtilities::GetSuitablePlacementLocation
 			{
 				float Slope = CalculateSlopeAngle(Landscape, TestLocation);
 
-				if (MeetsHeightRequirements(Height, Settings) && MeetsSlopeRequirements(Slope, Settings))
+				if (MeetsHeightRequirements(Height, Settings) && MeetsSlopeRequirements(Slope, Settings) &&
+					MeetsLayerRequirements(Landscape, WeightmapCache, TestLocation, Settings))
 				{
 					TestLocation.Z = Height;
 
@@ -604,6 +744,102 @@ bool UOPM_LandscapeIntegrationUtilities::MeetsSlopeRequirements(
 	return Slope <= Settings.MaxSlope;
 }
 
+bool UOPM_LandscapeIntegrationUtilities::MeetsLayerRequirements(
+	ALandscape* Landscape,
+	const FOPM_LandscapeWeightmapCache* WeightmapCache,
+	const FVector& Location,
+	const FLandscapePlacementSettings& Settings)
+{
+	if (Settings.LayerRules.Num() == 0)
+	{
+		return true;
+	}
+
+	if (!WeightmapCache)
+	{
+		return false;
+	}
+
+	if (WeightmapCache->ContainsLocation(Location))
+	{
+		return WeightmapCache->MeetsLayerRules(Settings.LayerRules, Location);
+	}
+
+	// Outside the loaded landscape, read weights from unloaded streaming proxies
+	FOPM_LandscapeTileCache* TileCache = FOPM_LandscapeTileCache::Get(Landscape);
+	if (!TileCache)
+	{
+		return false;
+	}
+
+	for (const FLandscapeLayerRule& Rule : Settings.LayerRules)
+	{
+		float Weight = 0.0f;
+		if (!TileCache->SampleWeight(Rule.LayerName, Location, Weight) ||
+			Weight < Rule.MinWeight || Weight > Rule.MaxWeight)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const FOPM_LandscapeWeightmapCache* UOPM_LandscapeIntegrationUtilities::PrepareWeightmapCache(
+	ALandscape* Landscape,
+	const FLandscapePlacementSettings& Settings)
+{
+	if (Settings.LayerRules.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	FOPM_LandscapeWeightmapCache* WeightmapCache = FOPM_LandscapeWeightmapCache::Get(Landscape);
+	if (WeightmapCache)
+	{
+		WeightmapCache->CacheLayers(Settings.LayerRules);
+	}
+
+	return WeightmapCache;
+}
+
+TArray<FVector> UOPM_LandscapeIntegrationUtilities::ResamplePolyline(
+	const TArray<FVector>& Polyline,
+	float Spacing,
+	int32 MaxPoints)
+{
+	TArray<FVector> Points;
+
+	if (Polyline.Num() == 0 || MaxPoints <= 0 || Spacing <= 0.0f)
+	{
+		return Points;
+	}
+
+	Points.Add(Polyline[0]);
+
+	// Distance still to travel before the next point is emitted
+	float Remaining = Spacing;
+
+	for (int32 i = 0; i < Polyline.Num() - 1 && Points.Num() < MaxPoints; ++i)
+	{
+		const FVector SegmentStart = Polyline[i];
+		const FVector SegmentEnd = Polyline[i + 1];
+		const float SegmentLength = FVector::Dist(SegmentStart, SegmentEnd);
+		float Travelled = 0.0f;
+
+		while (SegmentLength - Travelled >= Remaining && Points.Num() < MaxPoints)
+		{
+			Travelled += Remaining;
+			Points.Add(FMath::Lerp(SegmentStart, SegmentEnd, Travelled / SegmentLength));
+			Remaining = Spacing;
+		}
+
+		Remaining -= SegmentLength - Travelled;
+	}
+
+	return Points;
+}
+
 void UOPM_LandscapeIntegrationUtilities::GetBiomeParameters(
 	EBiomeType BiomeType,
 	float& OutMinDistance,
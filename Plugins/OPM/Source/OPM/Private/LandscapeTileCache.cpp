@@ -0,0 +1,519 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LandscapeTileCache.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Landscape.h"
+#include "LandscapeInfo.h"
+#include "LandscapeProxy.h"
+#include "LandscapeDataAccess.h"
+#include "LandscapeLayerInfoObject.h"
+#include "LandscapeStreamingProxy.h"
+#include "WorldPartition/WorldPartition.h"
+
+#if WITH_EDITOR
+#include "LandscapeEdit.h"
+#include "WorldPartition/WorldPartitionHandle.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#include "WorldPartition/Landscape/LandscapeActorDesc.h"
+#endif
+
+static TAutoConsoleVariable<int32> CVarLandscapeTileCacheBudgetMB(
+	TEXT("OPM.LandscapeTileCacheBudgetMB"),
+	512,
+	TEXT("Memory budget in MB for landscape tiles OPM reads from unloaded World Partition regions."));
+
+namespace OPMLandscapeTileCache
+{
+	TMap<TObjectKey<ALandscape>, TUniquePtr<FOPM_LandscapeTileCache>> LandscapeCaches;
+}
+
+FOPM_LandscapeTileCache::FOPM_LandscapeTileCache(ALandscape* InLandscape)
+	: Landscape(InLandscape)
+{
+	if (InLandscape)
+	{
+		LandscapeTransform = InLandscape->GetTransform();
+	}
+
+	// World Partition loads and unloads proxies without OnLevelActorAdded
+	LoadedActorAddedHandle = ULevel::OnLoadedActorAddedToLevelEvent.AddRaw(this, &FOPM_LandscapeTileCache::OnLoadedActorAdded);
+	LoadedActorRemovedHandle = ULevel::OnLoadedActorRemovedFromLevelEvent.AddRaw(this, &FOPM_LandscapeTileCache::OnLoadedActorRemoved);
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FOPM_LandscapeTileCache::OnLevelActorAdded);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FOPM_LandscapeTileCache::OnLevelActorDeleted);
+	}
+
+	ULandscapeInfo* LandscapeInfo = InLandscape ? InLandscape->GetLandscapeInfo() : nullptr;
+	if (LandscapeInfo)
+	{
+		LandscapeInfo->ForEachLandscapeProxy([this](ALandscapeProxy* Proxy)
+		{
+			BindToProxy(Proxy);
+			return true;
+		});
+	}
+}
+
+FOPM_LandscapeTileCache::~FOPM_LandscapeTileCache()
+{
+	ULevel::OnLoadedActorAddedToLevelEvent.Remove(LoadedActorAddedHandle);
+	ULevel::OnLoadedActorRemovedFromLevelEvent.Remove(LoadedActorRemovedHandle);
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+
+	UnbindAll();
+}
+
+FOPM_LandscapeTileCache* FOPM_LandscapeTileCache::Get(ALandscape* Landscape)
+{
+	check(IsInGameThread());
+
+	UWorld* World = Landscape ? Landscape->GetWorld() : nullptr;
+	if (!World || !World->GetWorldPartition())
+	{
+		return nullptr;
+	}
+
+	// Drop caches of landscapes that have since been destroyed
+	for (auto It = OPMLandscapeTileCache::LandscapeCaches.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TUniquePtr<FOPM_LandscapeTileCache>& Cache = OPMLandscapeTileCache::LandscapeCaches.FindOrAdd(Landscape);
+	if (!Cache)
+	{
+		Cache = MakeUnique<FOPM_LandscapeTileCache>(Landscape);
+	}
+
+	return Cache.Get();
+}
+
+void FOPM_LandscapeTileCache::ReleaseAll()
+{
+	OPMLandscapeTileCache::LandscapeCaches.Empty();
+}
+
+bool FOPM_LandscapeTileCache::SampleHeight(const FVector& Location, float& OutHeight)
+{
+	FVector2D QuadCoords;
+	FTile* Tile = FindTile(Location, QuadCoords);
+	if (!Tile || !MakeResident(*Tile, NAME_None))
+	{
+		return false;
+	}
+
+	const float RawHeight = SampleBilinear(Tile->Heights, *Tile, QuadCoords);
+	const float LocalHeight = (RawHeight - LandscapeDataAccess::MidValue) * LANDSCAPE_ZSCALE;
+
+	OutHeight = LandscapeTransform.TransformPosition(FVector(QuadCoords.X, QuadCoords.Y, LocalHeight)).Z;
+	return true;
+}
+
+bool FOPM_LandscapeTileCache::SampleWeight(FName LayerName, const FVector& Location, float& OutWeight)
+{
+	FVector2D QuadCoords;
+	FTile* Tile = FindTile(Location, QuadCoords);
+	if (!Tile || LayerName.IsNone() || !MakeResident(*Tile, LayerName))
+	{
+		return false;
+	}
+
+	const TArray<uint8>* Weights = Tile->Weights.Find(LayerName);
+	OutWeight = Weights ? SampleBilinear(*Weights, *Tile, QuadCoords) / 255.0f : 0.0f;
+	return true;
+}
+
+// Private helper methods
+
+void FOPM_LandscapeTileCache::GatherTiles()
+{
+	bGatherTiles = false;
+
+	// Keep decoded data of proxies whose extent did not change
+	TMap<FGuid, FTile> Previous;
+	for (FTile& Tile : Tiles)
+	{
+		if (Tile.IsResident())
+		{
+			Previous.Add(Tile.ProxyGuid, MoveTemp(Tile));
+		}
+	}
+
+	Tiles.Reset();
+	TileGrid.Reset();
+	TileSizeQuads = 0;
+	AllocatedBytes = 0;
+
+#if WITH_EDITOR
+	ALandscape* CachedLandscape = Landscape.Get();
+	UWorld* World = CachedLandscape ? CachedLandscape->GetWorld() : nullptr;
+	UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+	if (!WorldPartition)
+	{
+		return;
+	}
+
+	LandscapeTransform = CachedLandscape->GetTransform();
+	const FGuid LandscapeGuid = CachedLandscape->GetLandscapeGuid();
+
+	// Actor descriptors are available without loading the proxies themselves
+	FWorldPartitionHelpers::ForEachActorDesc<ALandscapeStreamingProxy>(WorldPartition, [this, &LandscapeGuid, &Previous](const FWorldPartitionActorDesc* ActorDesc)
+	{
+		const FLandscapeActorDesc* LandscapeDesc = static_cast<const FLandscapeActorDesc*>(ActorDesc);
+		if (LandscapeDesc->GridGuid != LandscapeGuid)
+		{
+			return true;
+		}
+
+		const FBox Bounds = ActorDesc->GetEditorBounds();
+		const FVector QuadMin = LandscapeTransform.InverseTransformPosition(FVector(Bounds.Min.X, Bounds.Min.Y, LandscapeTransform.GetLocation().Z));
+		const FVector QuadMax = LandscapeTransform.InverseTransformPosition(FVector(Bounds.Max.X, Bounds.Max.Y, LandscapeTransform.GetLocation().Z));
+
+		const FIntRect QuadRect(
+			FMath::RoundToInt(FMath::Min(QuadMin.X, QuadMax.X)),
+			FMath::RoundToInt(FMath::Min(QuadMin.Y, QuadMax.Y)),
+			FMath::RoundToInt(FMath::Max(QuadMin.X, QuadMax.X)),
+			FMath::RoundToInt(FMath::Max(QuadMin.Y, QuadMax.Y)));
+
+		FTile& Tile = Tiles.AddDefaulted_GetRef();
+		FTile* Resident = Previous.Find(ActorDesc->GetGuid());
+		if (Resident && Resident->QuadRect == QuadRect)
+		{
+			Tile = MoveTemp(*Resident);
+			AllocatedBytes += Tile.AllocatedBytes;
+		}
+
+		Tile.ProxyGuid = ActorDesc->GetGuid();
+		Tile.QuadRect = QuadRect;
+		return true;
+	});
+#endif
+
+	if (Tiles.Num() == 0)
+	{
+		return;
+	}
+
+	// Streaming proxies share one size and are laid out on a regular grid
+	TileSizeQuads = FMath::Max(Tiles[0].QuadRect.Width(), 1);
+	for (int32 i = 0; i < Tiles.Num(); ++i)
+	{
+		const FIntPoint Key(
+			FMath::FloorToInt(static_cast<float>(Tiles[i].QuadRect.Min.X) / TileSizeQuads),
+			FMath::FloorToInt(static_cast<float>(Tiles[i].QuadRect.Min.Y) / TileSizeQuads));
+		TileGrid.Add(Key, i);
+	}
+}
+
+FOPM_LandscapeTileCache::FTile* FOPM_LandscapeTileCache::FindTile(const FVector& Location, FVector2D& OutQuadCoords)
+{
+	if (bGatherTiles)
+	{
+		GatherTiles();
+	}
+
+	if (TileSizeQuads <= 0)
+	{
+		return nullptr;
+	}
+
+	const FVector Local = LandscapeTransform.InverseTransformPosition(FVector(Location.X, Location.Y, LandscapeTransform.GetLocation().Z));
+	OutQuadCoords = FVector2D(Local.X, Local.Y);
+
+	const int32 KeyX = FMath::FloorToInt(Local.X / TileSizeQuads);
+	const int32 KeyY = FMath::FloorToInt(Local.Y / TileSizeQuads);
+
+	// Locations on a shared border may belong to the previous tile
+	for (const FIntPoint& Key : { FIntPoint(KeyX, KeyY), FIntPoint(KeyX - 1, KeyY), FIntPoint(KeyX, KeyY - 1), FIntPoint(KeyX - 1, KeyY - 1) })
+	{
+		if (const int32* TileIndex = TileGrid.Find(Key))
+		{
+			FTile& Tile = Tiles[*TileIndex];
+			if (Local.X >= Tile.QuadRect.Min.X && Local.X <= Tile.QuadRect.Max.X &&
+				Local.Y >= Tile.QuadRect.Min.Y && Local.Y <= Tile.QuadRect.Max.Y)
+			{
+				return &Tile;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+bool FOPM_LandscapeTileCache::MakeResident(FTile& Tile, FName RequiredLayer)
+{
+	const bool bNeedsHeights = RequiredLayer.IsNone() && Tile.Heights.Num() == 0;
+	const bool bNeedsLayer = !RequiredLayer.IsNone() && !Tile.Weights.Contains(RequiredLayer);
+	if (!bNeedsHeights && !bNeedsLayer)
+	{
+		Tile.LastUsed = ++UseCounter;
+		return true;
+	}
+
+	if (!RequiredLayer.IsNone())
+	{
+		TrackedLayers.Add(RequiredLayer);
+	}
+
+#if WITH_EDITOR
+	ALandscape* CachedLandscape = Landscape.Get();
+	UWorld* World = CachedLandscape ? CachedLandscape->GetWorld() : nullptr;
+	UWorldPartition* WorldPartition = World ? World->GetWorldPartition() : nullptr;
+	if (!WorldPartition)
+	{
+		return false;
+	}
+
+	// Pin the proxy only while it is decoded, the reference unloads it again when it goes out of scope.
+	// The guard outlives the reference so the pin's own load and unload do not evict the tile.
+	TGuardValue<FGuid> PinnedGuard(PinnedProxyGuid, Tile.ProxyGuid);
+	FWorldPartitionReference ProxyReference(WorldPartition, Tile.ProxyGuid);
+	ULandscapeInfo* LandscapeInfo = CachedLandscape->GetLandscapeInfo();
+	if (!ProxyReference.IsValid() || !LandscapeInfo)
+	{
+		return false;
+	}
+
+	const FIntRect& Rect = Tile.QuadRect;
+	const int32 Width = Tile.GetWidth();
+	const int32 Height = Tile.GetHeight();
+
+	FLandscapeEditDataInterface LandscapeEdit(LandscapeInfo);
+	int64 AddedBytes = 0;
+
+	if (bNeedsHeights)
+	{
+		Tile.Heights.Init(LandscapeDataAccess::MidValue, Width * Height);
+		LandscapeEdit.GetHeightDataFast(Rect.Min.X, Rect.Min.Y, Rect.Max.X, Rect.Max.Y, Tile.Heights.GetData(), Width);
+		AddedBytes += Tile.Heights.GetAllocatedSize();
+	}
+
+	// Decode every requested layer the tile lacks while it is pinned, keep what is already there
+	for (const FName& LayerName : TrackedLayers)
+	{
+		if (Tile.Weights.Contains(LayerName))
+		{
+			continue;
+		}
+
+		TArray<uint8>& Weights = Tile.Weights.Add(LayerName);
+		Weights.SetNumZeroed(Width * Height);
+
+		if (ULandscapeLayerInfoObject* LayerInfo = LandscapeInfo->GetLayerInfoByName(LayerName))
+		{
+			LandscapeEdit.GetWeightDataFast(LayerInfo, Rect.Min.X, Rect.Min.Y, Rect.Max.X, Rect.Max.Y, Weights.GetData(), Width);
+		}
+
+		AddedBytes += Weights.GetAllocatedSize();
+	}
+
+	Tile.LastUsed = ++UseCounter;
+	Tile.AllocatedBytes += AddedBytes;
+	AllocatedBytes += AddedBytes;
+
+	EnforceBudget(&Tile);
+	return true;
+#else
+	return false;
+#endif
+}
+
+FOPM_LandscapeTileCache::FTile* FOPM_LandscapeTileCache::FindTileByProxy(const FGuid& ProxyGuid)
+{
+	return Tiles.FindByPredicate([&ProxyGuid](const FTile& Tile)
+	{
+		return Tile.ProxyGuid == ProxyGuid;
+	});
+}
+
+void FOPM_LandscapeTileCache::Evict(FTile& Tile)
+{
+	AllocatedBytes -= Tile.AllocatedBytes;
+	Tile.AllocatedBytes = 0;
+	Tile.Heights.Empty();
+	Tile.Weights.Empty();
+}
+
+void FOPM_LandscapeTileCache::EnforceBudget(const FTile* Keep)
+{
+	const int64 BudgetBytes = static_cast<int64>(FMath::Max(CVarLandscapeTileCacheBudgetMB.GetValueOnGameThread(), 1)) * 1024 * 1024;
+
+	while (AllocatedBytes > BudgetBytes)
+	{
+		FTile* Oldest = nullptr;
+		for (FTile& Tile : Tiles)
+		{
+			if (&Tile != Keep && Tile.IsResident() && (!Oldest || Tile.LastUsed < Oldest->LastUsed))
+			{
+				Oldest = &Tile;
+			}
+		}
+
+		if (!Oldest)
+		{
+			break;
+		}
+
+		Evict(*Oldest);
+	}
+}
+
+bool FOPM_LandscapeTileCache::IsOwnProxy(const ALandscapeProxy* Proxy) const
+{
+	const ALandscape* CachedLandscape = Landscape.Get();
+	return Proxy && CachedLandscape && Proxy->GetLandscapeGuid() == CachedLandscape->GetLandscapeGuid();
+}
+
+void FOPM_LandscapeTileCache::BindToProxy(ALandscapeProxy* Proxy)
+{
+#if WITH_EDITOR
+	const bool bAlreadyBound = ProxyBindings.ContainsByPredicate([Proxy](const TPair<TWeakObjectPtr<ALandscapeProxy>, FDelegateHandle>& Binding)
+	{
+		return Binding.Key.Get() == Proxy;
+	});
+
+	if (Proxy && !bAlreadyBound)
+	{
+		FDelegateHandle Handle = Proxy->OnComponentDataChanged().AddRaw(this, &FOPM_LandscapeTileCache::OnComponentDataChanged);
+		ProxyBindings.Emplace(Proxy, Handle);
+	}
+#endif
+}
+
+void FOPM_LandscapeTileCache::UnbindFromProxy(ALandscapeProxy* Proxy)
+{
+	for (int32 Index = ProxyBindings.Num() - 1; Index >= 0; --Index)
+	{
+		ALandscapeProxy* BoundProxy = ProxyBindings[Index].Key.Get();
+		if (!BoundProxy || BoundProxy == Proxy)
+		{
+#if WITH_EDITOR
+			if (BoundProxy)
+			{
+				BoundProxy->OnComponentDataChanged().Remove(ProxyBindings[Index].Value);
+			}
+#endif
+			ProxyBindings.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void FOPM_LandscapeTileCache::UnbindAll()
+{
+#if WITH_EDITOR
+	for (const TPair<TWeakObjectPtr<ALandscapeProxy>, FDelegateHandle>& Binding : ProxyBindings)
+	{
+		if (ALandscapeProxy* Proxy = Binding.Key.Get())
+		{
+			Proxy->OnComponentDataChanged().Remove(Binding.Value);
+		}
+	}
+#endif
+	ProxyBindings.Empty();
+}
+
+void FOPM_LandscapeTileCache::EvictProxy(const ALandscapeProxy* Proxy)
+{
+#if WITH_EDITOR
+	if (FTile* Tile = FindTileByProxy(Proxy->GetActorGuid()))
+	{
+		Evict(*Tile);
+	}
+#endif
+}
+
+void FOPM_LandscapeTileCache::OnComponentDataChanged(ALandscapeProxy* Proxy, const FLandscapeProxyComponentDataChangedParams& Params)
+{
+	// Sculpting and painting a loaded proxy leaves its decoded tile stale
+	if (Proxy)
+	{
+		EvictProxy(Proxy);
+	}
+}
+
+void FOPM_LandscapeTileCache::OnLoadedActorAdded(AActor& Actor)
+{
+#if WITH_EDITOR
+	ALandscapeProxy* Proxy = Cast<ALandscapeProxy>(&Actor);
+	if (!IsOwnProxy(Proxy) || Proxy->GetActorGuid() == PinnedProxyGuid)
+	{
+		return;
+	}
+
+	// Loaded proxies are read directly, the tile is decoded again once they unload
+	EvictProxy(Proxy);
+	BindToProxy(Proxy);
+	if (Proxy->IsA<ALandscapeStreamingProxy>() && !FindTileByProxy(Proxy->GetActorGuid()))
+	{
+		bGatherTiles = true;
+	}
+#endif
+}
+
+void FOPM_LandscapeTileCache::OnLoadedActorRemoved(AActor& Actor)
+{
+#if WITH_EDITOR
+	ALandscapeProxy* Proxy = Cast<ALandscapeProxy>(&Actor);
+	if (!IsOwnProxy(Proxy) || Proxy->GetActorGuid() == PinnedProxyGuid)
+	{
+		return;
+	}
+
+	// Edits made while the proxy was loaded are only in the saved package now
+	EvictProxy(Proxy);
+	UnbindFromProxy(Proxy);
+#endif
+}
+
+void FOPM_LandscapeTileCache::OnLevelActorAdded(AActor* Actor)
+{
+	ALandscapeStreamingProxy* Proxy = Cast<ALandscapeStreamingProxy>(Actor);
+	if (IsOwnProxy(Proxy))
+	{
+		BindToProxy(Proxy);
+		bGatherTiles = true;
+	}
+}
+
+void FOPM_LandscapeTileCache::OnLevelActorDeleted(AActor* Actor)
+{
+	ALandscapeStreamingProxy* Proxy = Cast<ALandscapeStreamingProxy>(Actor);
+	if (IsOwnProxy(Proxy))
+	{
+		UnbindFromProxy(Proxy);
+		bGatherTiles = true;
+	}
+}
+
+template<typename T>
+float FOPM_LandscapeTileCache::SampleBilinear(const TArray<T>& Data, const FTile& Tile, const FVector2D& QuadCoords)
+{
+	const int32 Width = Tile.GetWidth();
+	const int32 Height = Tile.GetHeight();
+	const float X = FMath::Clamp(static_cast<float>(QuadCoords.X - Tile.QuadRect.Min.X), 0.0f, static_cast<float>(Width - 1));
+	const float Y = FMath::Clamp(static_cast<float>(QuadCoords.Y - Tile.QuadRect.Min.Y), 0.0f, static_cast<float>(Height - 1));
+
+	const int32 X0 = FMath::Min(FMath::FloorToInt(X), Width - 2);
+	const int32 Y0 = FMath::Min(FMath::FloorToInt(Y), Height - 2);
+	const float FracX = X - X0;
+	const float FracY = Y - Y0;
+
+	const T* Row0 = Data.GetData() + Y0 * Width + X0;
+	const T* Row1 = Row0 + Width;
+
+	const float Top = FMath::Lerp(static_cast<float>(Row0[0]), static_cast<float>(Row0[1]), FracX);
+	const float Bottom = FMath::Lerp(static_cast<float>(Row1[0]), static_cast<float>(Row1[1]), FracX);
+
+	return FMath::Lerp(Top, Bottom, FracY);
+}
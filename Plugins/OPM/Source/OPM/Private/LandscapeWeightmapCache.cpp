@@ -0,0 +1,426 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LandscapeWeightmapCache.h"
+#include "Landscape.h"
+#include "LandscapeComponent.h"
+#include "LandscapeInfo.h"
+#include "LandscapeProxy.h"
+#include "LandscapeLayerInfoObject.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+
+#if WITH_EDITOR
+#include "LandscapeEdit.h"
+#endif
+
+namespace OPMWeightmapCache
+{
+	TMap<TObjectKey<ALandscape>, TUniquePtr<FOPM_LandscapeWeightmapCache>> LandscapeCaches;
+}
+
+FOPM_LandscapeWeightmapCache::FOPM_LandscapeWeightmapCache(ALandscape* InLandscape)
+	: Landscape(InLandscape)
+{
+	// World Partition loads and unloads proxies without OnLevelActorAdded
+	LoadedActorAddedHandle = ULevel::OnLoadedActorAddedToLevelEvent.AddRaw(this, &FOPM_LandscapeWeightmapCache::OnLoadedActorAdded);
+	LoadedActorRemovedHandle = ULevel::OnLoadedActorRemovedFromLevelEvent.AddRaw(this, &FOPM_LandscapeWeightmapCache::OnLoadedActorRemoved);
+	if (GEngine)
+	{
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FOPM_LandscapeWeightmapCache::OnLevelActorDeleted);
+	}
+
+	InvalidateAll();
+}
+
+FOPM_LandscapeWeightmapCache::~FOPM_LandscapeWeightmapCache()
+{
+	ULevel::OnLoadedActorAddedToLevelEvent.Remove(LoadedActorAddedHandle);
+	ULevel::OnLoadedActorRemovedFromLevelEvent.Remove(LoadedActorRemovedHandle);
+	if (GEngine)
+	{
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+
+	UnbindAll();
+}
+
+FOPM_LandscapeWeightmapCache* FOPM_LandscapeWeightmapCache::Get(ALandscape* Landscape)
+{
+	check(IsInGameThread());
+
+	if (!Landscape)
+	{
+		return nullptr;
+	}
+
+	// Drop caches of landscapes that have since been destroyed
+	for (auto It = OPMWeightmapCache::LandscapeCaches.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TUniquePtr<FOPM_LandscapeWeightmapCache>& Cache = OPMWeightmapCache::LandscapeCaches.FindOrAdd(Landscape);
+	if (!Cache)
+	{
+		Cache = MakeUnique<FOPM_LandscapeWeightmapCache>(Landscape);
+	}
+
+	return Cache.Get();
+}
+
+void FOPM_LandscapeWeightmapCache::ReleaseAll()
+{
+	OPMWeightmapCache::LandscapeCaches.Empty();
+}
+
+void FOPM_LandscapeWeightmapCache::CacheLayers(const TArray<FLandscapeLayerRule>& Rules)
+{
+	check(IsInGameThread());
+
+	TArray<FName, TInlineAllocator<8>> NewLayers;
+	for (const FLandscapeLayerRule& Rule : Rules)
+	{
+		if (!Rule.LayerName.IsNone() && !CachedLayers.Contains(Rule.LayerName))
+		{
+			NewLayers.AddUnique(Rule.LayerName);
+		}
+	}
+
+	RefreshComponents(NewLayers);
+}
+
+void FOPM_LandscapeWeightmapCache::CacheLayer(FName LayerName)
+{
+	check(IsInGameThread());
+
+	if (LayerName.IsNone() || CachedLayers.Contains(LayerName))
+	{
+		RefreshComponents(TConstArrayView<FName>());
+	}
+	else
+	{
+		RefreshComponents(MakeArrayView(&LayerName, 1));
+	}
+}
+
+bool FOPM_LandscapeWeightmapCache::SampleWeight(FName LayerName, const FVector& Location, float& OutWeight) const
+{
+	FVector2D Coords;
+	const FComponentRaster* Raster = FindComponent(Location, Coords);
+	const TArray<uint8>* Weights = Raster ? Raster->Layers.Find(LayerName) : nullptr;
+	if (!Weights)
+	{
+		return false;
+	}
+
+	if (Weights->Num() == 0)
+	{
+		OutWeight = 0.0f;
+		return true;
+	}
+
+	// Bilinear filter between the four surrounding vertices
+	const int32 Size = ComponentSizeQuads + 1;
+	const int32 X0 = FMath::Clamp(FMath::FloorToInt(Coords.X), 0, ComponentSizeQuads - 1);
+	const int32 Y0 = FMath::Clamp(FMath::FloorToInt(Coords.Y), 0, ComponentSizeQuads - 1);
+	const float FracX = FMath::Clamp(static_cast<float>(Coords.X) - X0, 0.0f, 1.0f);
+	const float FracY = FMath::Clamp(static_cast<float>(Coords.Y) - Y0, 0.0f, 1.0f);
+
+	const uint8* Row0 = Weights->GetData() + Y0 * Size + X0;
+	const uint8* Row1 = Row0 + Size;
+
+	const float Top = FMath::Lerp(static_cast<float>(Row0[0]), static_cast<float>(Row0[1]), FracX);
+	const float Bottom = FMath::Lerp(static_cast<float>(Row1[0]), static_cast<float>(Row1[1]), FracX);
+
+	OutWeight = FMath::Lerp(Top, Bottom, FracY) / 255.0f;
+	return true;
+}
+
+bool FOPM_LandscapeWeightmapCache::ContainsLocation(const FVector& Location) const
+{
+	FVector2D Coords;
+	return FindComponent(Location, Coords) != nullptr;
+}
+
+bool FOPM_LandscapeWeightmapCache::MeetsLayerRules(const TArray<FLandscapeLayerRule>& Rules, const FVector& Location) const
+{
+	for (const FLandscapeLayerRule& Rule : Rules)
+	{
+		float Weight = 0.0f;
+		SampleWeight(Rule.LayerName, Location, Weight);
+
+		if (Weight < Rule.MinWeight || Weight > Rule.MaxWeight)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FOPM_LandscapeWeightmapCache::InvalidateAll()
+{
+	UnbindAll();
+	Components.Empty();
+	PendingComponents.Empty();
+	CachedLayers.Empty();
+	ComponentSizeQuads = 0;
+
+	ALandscape* CachedLandscape = Landscape.Get();
+	ULandscapeInfo* LandscapeInfo = CachedLandscape ? CachedLandscape->GetLandscapeInfo() : nullptr;
+	if (!LandscapeInfo)
+	{
+		return;
+	}
+
+	LandscapeTransform = CachedLandscape->GetTransform();
+	ComponentSizeQuads = LandscapeInfo->ComponentSizeQuads;
+
+	LandscapeInfo->ForEachLandscapeProxy([this](ALandscapeProxy* Proxy)
+	{
+		AddProxy(Proxy);
+		return true;
+	});
+}
+
+// Private helper methods
+
+void FOPM_LandscapeWeightmapCache::RefreshComponents(TConstArrayView<FName> NewLayers)
+{
+	ALandscape* CachedLandscape = Landscape.Get();
+	if (!CachedLandscape)
+	{
+		return;
+	}
+
+	LandscapeTransform = CachedLandscape->GetTransform();
+
+	if (NewLayers.Num() == 0 && PendingComponents.Num() == 0)
+	{
+		return;
+	}
+
+#if WITH_EDITOR
+	ULandscapeInfo* LandscapeInfo = CachedLandscape->GetLandscapeInfo();
+	if (!LandscapeInfo || ComponentSizeQuads <= 0)
+	{
+		return;
+	}
+
+	FLandscapeEditDataInterface LandscapeEdit(LandscapeInfo);
+	const int32 Size = ComponentSizeQuads + 1;
+
+	// One bulk read per component and layer instead of a landscape edit query per point
+	auto Decode = [&](const FIntPoint& Key, FComponentRaster& Raster, FName LayerName)
+	{
+		TArray<uint8>& Weights = Raster.Layers.FindOrAdd(LayerName);
+		ULandscapeLayerInfoObject* LayerInfo = LandscapeInfo->GetLayerInfoByName(LayerName);
+		if (!LayerInfo)
+		{
+			Weights.Empty();
+			return;
+		}
+
+		// Areas without painted weight are not written by the landscape
+		Weights.Reset();
+		Weights.SetNumZeroed(Size * Size);
+
+		const int32 X1 = Key.X * ComponentSizeQuads;
+		const int32 Y1 = Key.Y * ComponentSizeQuads;
+		LandscapeEdit.GetWeightDataFast(LayerInfo, X1, Y1, X1 + ComponentSizeQuads, Y1 + ComponentSizeQuads, Weights.GetData(), Size);
+	};
+
+	for (const FIntPoint& Key : PendingComponents)
+	{
+		if (FComponentRaster* Raster = Components.Find(Key))
+		{
+			for (FName LayerName : CachedLayers)
+			{
+				Decode(Key, *Raster, LayerName);
+			}
+		}
+	}
+	PendingComponents.Reset();
+
+	for (FName LayerName : NewLayers)
+	{
+		for (TPair<FIntPoint, FComponentRaster>& Pair : Components)
+		{
+			Decode(Pair.Key, Pair.Value, LayerName);
+		}
+		CachedLayers.Add(LayerName);
+	}
+#endif
+}
+
+const FOPM_LandscapeWeightmapCache::FComponentRaster* FOPM_LandscapeWeightmapCache::FindComponent(const FVector& Location, FVector2D& OutComponentCoords) const
+{
+	if (ComponentSizeQuads <= 0)
+	{
+		return nullptr;
+	}
+
+	const FVector Local = LandscapeTransform.InverseTransformPosition(Location);
+	const int32 KeyX = FMath::FloorToInt(Local.X / ComponentSizeQuads);
+	const int32 KeyY = FMath::FloorToInt(Local.Y / ComponentSizeQuads);
+
+	// Locations on a shared border may belong to the previous component
+	for (const FIntPoint& Key : { FIntPoint(KeyX, KeyY), FIntPoint(KeyX - 1, KeyY), FIntPoint(KeyX, KeyY - 1), FIntPoint(KeyX - 1, KeyY - 1) })
+	{
+		const FVector2D Coords(Local.X - Key.X * ComponentSizeQuads, Local.Y - Key.Y * ComponentSizeQuads);
+		if (Coords.X < 0.0f || Coords.Y < 0.0f || Coords.X > ComponentSizeQuads || Coords.Y > ComponentSizeQuads)
+		{
+			continue;
+		}
+
+		if (const FComponentRaster* Raster = Components.Find(Key))
+		{
+			OutComponentCoords = Coords;
+			return Raster;
+		}
+	}
+
+	return nullptr;
+}
+
+FIntPoint FOPM_LandscapeWeightmapCache::GetComponentKey(const ULandscapeComponent* Component) const
+{
+	const FIntPoint Base = Component->GetSectionBase();
+	return FIntPoint(
+		FMath::DivideAndRoundDown(Base.X, ComponentSizeQuads),
+		FMath::DivideAndRoundDown(Base.Y, ComponentSizeQuads));
+}
+
+bool FOPM_LandscapeWeightmapCache::IsOwnProxy(const ALandscapeProxy* Proxy) const
+{
+	const ALandscape* CachedLandscape = Landscape.Get();
+	return Proxy && CachedLandscape && Proxy->GetLandscapeGuid() == CachedLandscape->GetLandscapeGuid();
+}
+
+void FOPM_LandscapeWeightmapCache::AddProxy(ALandscapeProxy* Proxy)
+{
+	if (!Proxy || ComponentSizeQuads <= 0)
+	{
+		return;
+	}
+
+#if WITH_EDITOR
+	const bool bAlreadyBound = ProxyBindings.ContainsByPredicate([Proxy](const TPair<TWeakObjectPtr<ALandscapeProxy>, FDelegateHandle>& Binding)
+	{
+		return Binding.Key.Get() == Proxy;
+	});
+
+	if (!bAlreadyBound)
+	{
+		FDelegateHandle Handle = Proxy->OnComponentDataChanged().AddRaw(this, &FOPM_LandscapeWeightmapCache::OnComponentDataChanged);
+		ProxyBindings.Emplace(Proxy, Handle);
+	}
+#endif
+
+	// Decoded on the next use, the components may not be registered with the landscape yet
+	for (const ULandscapeComponent* Component : Proxy->LandscapeComponents)
+	{
+		if (Component)
+		{
+			const FIntPoint Key = GetComponentKey(Component);
+			Components.FindOrAdd(Key);
+			PendingComponents.Add(Key);
+		}
+	}
+}
+
+void FOPM_LandscapeWeightmapCache::RemoveProxy(ALandscapeProxy* Proxy)
+{
+	if (!Proxy || ComponentSizeQuads <= 0)
+	{
+		return;
+	}
+
+	for (const ULandscapeComponent* Component : Proxy->LandscapeComponents)
+	{
+		if (Component)
+		{
+			const FIntPoint Key = GetComponentKey(Component);
+			Components.Remove(Key);
+			PendingComponents.Remove(Key);
+		}
+	}
+
+	for (int32 Index = ProxyBindings.Num() - 1; Index >= 0; --Index)
+	{
+		ALandscapeProxy* BoundProxy = ProxyBindings[Index].Key.Get();
+		if (!BoundProxy || BoundProxy == Proxy)
+		{
+#if WITH_EDITOR
+			if (BoundProxy)
+			{
+				BoundProxy->OnComponentDataChanged().Remove(ProxyBindings[Index].Value);
+			}
+#endif
+			ProxyBindings.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void FOPM_LandscapeWeightmapCache::UnbindAll()
+{
+#if WITH_EDITOR
+	for (const TPair<TWeakObjectPtr<ALandscapeProxy>, FDelegateHandle>& Binding : ProxyBindings)
+	{
+		if (ALandscapeProxy* Proxy = Binding.Key.Get())
+		{
+			Proxy->OnComponentDataChanged().Remove(Binding.Value);
+		}
+	}
+#endif
+	ProxyBindings.Empty();
+}
+
+void FOPM_LandscapeWeightmapCache::OnComponentDataChanged(ALandscapeProxy* Proxy, const FLandscapeProxyComponentDataChangedParams& Params)
+{
+	if (ComponentSizeQuads <= 0)
+	{
+		return;
+	}
+
+	// Components added by the landscape tools are picked up here too
+	Params.ForEachComponent([this](const ULandscapeComponent* Component)
+	{
+		if (Component)
+		{
+			const FIntPoint Key = GetComponentKey(Component);
+			Components.FindOrAdd(Key);
+			PendingComponents.Add(Key);
+		}
+	});
+}
+
+void FOPM_LandscapeWeightmapCache::OnLoadedActorAdded(AActor& Actor)
+{
+	ALandscapeProxy* Proxy = Cast<ALandscapeProxy>(&Actor);
+	if (IsOwnProxy(Proxy))
+	{
+		AddProxy(Proxy);
+	}
+}
+
+void FOPM_LandscapeWeightmapCache::OnLoadedActorRemoved(AActor& Actor)
+{
+	ALandscapeProxy* Proxy = Cast<ALandscapeProxy>(&Actor);
+	if (IsOwnProxy(Proxy))
+	{
+		RemoveProxy(Proxy);
+	}
+}
+
+void FOPM_LandscapeWeightmapCache::OnLevelActorDeleted(AActor* Actor)
+{
+	ALandscapeProxy* Proxy = Cast<ALandscapeProxy>(Actor);
+	if (IsOwnProxy(Proxy))
+	{
+		RemoveProxy(Proxy);
+	}
+}
@@ -0,0 +1,293 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NamingTemplate.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+namespace OPMNamingTemplate
+{
+	/** Widest index padding accepted, enough for any int32 */
+	const int32 MaxIndexWidth = 10;
+
+	/** Helper to append a class name without the Blueprint generated class suffix */
+	static void AppendClassName(FStringBuilderBase& Out, const UClass* Class)
+	{
+		const FString& Name = Class->GetName();
+		FStringView View(Name);
+		if (View.EndsWith(TEXT("_C"), ESearchCase::CaseSensitive))
+		{
+			View.LeftChopInline(2);
+		}
+		Out.Append(View);
+	}
+
+	/** Helper to append the last element of an actor folder path */
+	static void AppendFolderLeaf(FStringBuilderBase& Out, const AActor* Actor)
+	{
+		const FName FolderPath = Actor->GetFolderPath();
+		if (FolderPath.IsNone())
+		{
+			return;
+		}
+
+		TStringBuilder<256> Path;
+		FolderPath.AppendString(Path);
+		FStringView View = Path.ToView();
+
+		int32 SlashIndex = INDEX_NONE;
+		if (View.FindLastChar(TEXT('/'), SlashIndex))
+		{
+			View.RightChopInline(SlashIndex + 1);
+		}
+		Out.Append(View);
+	}
+}
+
+void FOPM_NamingTemplate::AppendNumber(FStringBuilderBase& Out, int32 Value, int32 Width)
+{
+	TCHAR Digits[16];
+	int32 NumDigits = 0;
+	uint32 Magnitude = Value < 0 ? 0u - static_cast<uint32>(Value) : static_cast<uint32>(Value);
+	do
+	{
+		Digits[NumDigits++] = TEXT('0') + static_cast<TCHAR>(Magnitude % 10);
+		Magnitude /= 10;
+	}
+	while (Magnitude > 0);
+
+	if (Value < 0)
+	{
+		Out.AppendChar(TEXT('-'));
+	}
+	for (int32 Pad = NumDigits; Pad < Width; ++Pad)
+	{
+		Out.AppendChar(TEXT('0'));
+	}
+	while (NumDigits > 0)
+	{
+		Out.AppendChar(Digits[--NumDigits]);
+	}
+}
+
+bool FOPM_NamingTemplate::Compile(const FString& Pattern, FString* OutError)
+{
+	Tokens.Reset();
+	LiteralText.Reset(Pattern.Len());
+	bUsesIndex = false;
+
+	auto Fail = [this, OutError](const FString& Reason)
+	{
+		Tokens.Reset();
+		LiteralText.Reset();
+		bUsesIndex = false;
+		if (OutError)
+		{
+			*OutError = Reason;
+		}
+		return false;
+	};
+
+	auto AppendLiteralChar = [this](TCHAR Char)
+	{
+		if (Tokens.Num() == 0 || Tokens.Last().Type != ETokenType::Literal)
+		{
+			FToken& Token = Tokens.AddDefaulted_GetRef();
+			Token.LiteralStart = LiteralText.Len();
+		}
+		LiteralText.AppendChar(Char);
+		Tokens.Last().LiteralLen++;
+	};
+
+	const int32 Len = Pattern.Len();
+	for (int32 Pos = 0; Pos < Len; ++Pos)
+	{
+		const TCHAR Char = Pattern[Pos];
+
+		if (Char == TEXT('}'))
+		{
+			if (Pos + 1 < Len && Pattern[Pos + 1] == TEXT('}'))
+			{
+				AppendLiteralChar(Char);
+				++Pos;
+				continue;
+			}
+			return Fail(FString::Printf(TEXT("Unmatched '}' at %d"), Pos));
+		}
+
+		if (Char != TEXT('{'))
+		{
+			AppendLiteralChar(Char);
+			continue;
+		}
+
+		if (Pos + 1 < Len && Pattern[Pos + 1] == TEXT('{'))
+		{
+			AppendLiteralChar(Char);
+			++Pos;
+			continue;
+		}
+
+		int32 Close = Pattern.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos + 1);
+		if (Close == INDEX_NONE)
+		{
+			return Fail(FString::Printf(TEXT("Unterminated token at %d"), Pos));
+		}
+
+		FStringView Body = FStringView(Pattern).Mid(Pos + 1, Close - Pos - 1);
+		FStringView Format;
+		int32 ColonIndex = INDEX_NONE;
+		if (Body.FindChar(TEXT(':'), ColonIndex))
+		{
+			Format = Body.RightChop(ColonIndex + 1);
+			Body = Body.Left(ColonIndex);
+		}
+
+		FToken Token;
+		if (Body.Equals(TEXT("Label"), ESearchCase::IgnoreCase))
+		{
+			Token.Type = ETokenType::Label;
+		}
+		else if (Body.Equals(TEXT("Class"), ESearchCase::IgnoreCase))
+		{
+			Token.Type = ETokenType::Class;
+		}
+		else if (Body.Equals(TEXT("Folder"), ESearchCase::IgnoreCase))
+		{
+			Token.Type = ETokenType::Folder;
+		}
+		else if (Body.Equals(TEXT("Index"), ESearchCase::IgnoreCase))
+		{
+			Token.Type = ETokenType::Index;
+			bUsesIndex = true;
+
+			for (TCHAR Digit : Format)
+			{
+				if (!FChar::IsDigit(Digit))
+				{
+					return Fail(FString::Printf(TEXT("Invalid index format '%.*s'"), Format.Len(), Format.GetData()));
+				}
+				Token.Width = FMath::Min(Token.Width * 10 + (Digit - TEXT('0')), OPMNamingTemplate::MaxIndexWidth);
+			}
+		}
+		else
+		{
+			return Fail(FString::Printf(TEXT("Unknown token '%.*s'"), Body.Len(), Body.GetData()));
+		}
+
+		if (Token.Type != ETokenType::Index && !Format.IsEmpty())
+		{
+			return Fail(FString::Printf(TEXT("Token '%.*s' takes no format"), Body.Len(), Body.GetData()));
+		}
+
+		Tokens.Add(Token);
+		Pos = Close;
+	}
+
+	if (Tokens.Num() == 0)
+	{
+		return Fail(TEXT("Pattern is empty"));
+	}
+
+	return true;
+}
+
+void FOPM_NamingTemplate::Generate(const AActor* Actor, int32 Index, FStringBuilderBase& Out) const
+{
+	for (const FToken& Token : Tokens)
+	{
+		switch (Token.Type)
+		{
+		case ETokenType::Literal:
+			Out.Append(*LiteralText + Token.LiteralStart, Token.LiteralLen);
+			break;
+
+		case ETokenType::Label:
+			if (Actor)
+			{
+				Out.Append(Actor->GetActorLabel());
+			}
+			break;
+
+		case ETokenType::Class:
+			if (Actor)
+			{
+				OPMNamingTemplate::AppendClassName(Out, Actor->GetClass());
+			}
+			break;
+
+		case ETokenType::Folder:
+			if (Actor)
+			{
+				OPMNamingTemplate::AppendFolderLeaf(Out, Actor);
+			}
+			break;
+
+		case ETokenType::Index:
+			AppendNumber(Out, Index, Token.Width);
+			break;
+		}
+	}
+}
+
+FString FOPM_NamingTemplate::Generate(const AActor* Actor, int32 Index) const
+{
+	TStringBuilder<256> Builder;
+	Generate(Actor, Index, Builder);
+	return FString(Builder.ToView());
+}
+
+void FOPM_LabelIndex::Build(UWorld* World)
+{
+	Labels.Reset();
+	NextSuffix.Reset();
+
+	if (!World)
+	{
+		return;
+	}
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		Add(It->GetActorLabel());
+	}
+}
+
+void FOPM_LabelIndex::Remove(const FString& Label)
+{
+	if (int32* Count = Labels.Find(Label))
+	{
+		if (--*Count <= 0)
+		{
+			Labels.Remove(Label);
+		}
+	}
+}
+
+FString FOPM_LabelIndex::MakeUnique(const FString& Label)
+{
+	int32& Count = Labels.FindOrAdd(Label, 0);
+	if (Count == 0)
+	{
+		Count = 1;
+		return Label;
+	}
+
+	int32& Suffix = NextSuffix.FindOrAdd(Label, 1);
+	TStringBuilder<256> Builder;
+	for (;;)
+	{
+		Builder.Reset();
+		Builder.Append(Label);
+		Builder.AppendChar(TEXT('_'));
+		FOPM_NamingTemplate::AppendNumber(Builder, Suffix++, 0);
+
+		FString Candidate(Builder.ToView());
+		int32& CandidateCount = Labels.FindOrAdd(Candidate, 0);
+		if (CandidateCount == 0)
+		{
+			CandidateCount = 1;
+			return Candidate;
+		}
+	}
+}
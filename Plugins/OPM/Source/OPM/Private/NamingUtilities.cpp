@@ -1,9 +1,19 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "NamingUtilities.h"
+#include "NamingTemplate.h"
+#include "RenameRuleSet.h"
+#include "OPMBulkEditScope.h"
+#include "Async/ParallelFor.h"
+
+namespace OPMNaming
+{
+	/** Labels matched per parallel task */
+	const int32 BatchSize = 512;
+}
 
 void UOPM_NamingUtilities::BatchRename(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	const FString& Prefix,
 	const FString& Suffix,
 	int32 StartNumber,
@@ -17,14 +27,14 @@ void UOPM_NamingUtilities::BatchRename(
 		{
 			FString BaseName = Actor->GetActorLabel();
 			FString NewName = GenerateName(BaseName, Prefix, Suffix, CurrentNumber, Padding);
-			Actor->SetActorLabel(NewName);
+			SetLabel(Actor, NewName);
 			CurrentNumber++;
 		}
 	}
 }
 
 void UOPM_NamingUtilities::AddPrefix(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	const FString& Prefix)
 {
 	if (Prefix.IsEmpty())
@@ -38,13 +48,13 @@ void UOPM_NamingUtilities::AddPrefix(
 		{
 			FString CurrentName = Actor->GetActorLabel();
 			FString NewName = Prefix + CurrentName;
-			Actor->SetActorLabel(NewName);
+			SetLabel(Actor, NewName);
 		}
 	}
 }
 
 void UOPM_NamingUtilities::AddSuffix(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	const FString& Suffix)
 {
 	if (Suffix.IsEmpty())
@@ -58,13 +68,13 @@ void UOPM_NamingUtilities::AddSuffix(
 		{
 			FString CurrentName = Actor->GetActorLabel();
 			FString NewName = CurrentName + Suffix;
-			Actor->SetActorLabel(NewName);
+			SetLabel(Actor, NewName);
 		}
 	}
 }
 
 void UOPM_NamingUtilities::AutoNumber(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	int32 StartNumber,
 	int32 Padding)
 {
@@ -77,44 +87,101 @@ void UOPM_NamingUtilities::AutoNumber(
 			FString CurrentName = Actor->GetActorLabel();
 			FString NumberStr = FormatNumber(CurrentNumber, Padding);
 			FString NewName = CurrentName + TEXT("_") + NumberStr;
-			Actor->SetActorLabel(NewName);
+			SetLabel(Actor, NewName);
 			CurrentNumber++;
 		}
 	}
 }
 
 void UOPM_NamingUtilities::FindAndReplace(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	const FString& FindStr,
 	const FString& ReplaceStr,
 	bool bCaseSensitive)
 {
-	if (FindStr.IsEmpty())
+	FRenameRule Rule;
+	Rule.Type = ERenameRuleType::Literal;
+	Rule.Find = FindStr;
+	Rule.Replace = ReplaceStr;
+	Rule.bCaseSensitive = bCaseSensitive;
+
+	ApplyRenameRules(Actors, MakeArrayView(&Rule, 1));
+}
+
+int32 UOPM_NamingUtilities::ApplyRenameRules(
+	TArrayView<AActor* const> Actors,
+	TArrayView<const FRenameRule> Rules,
+	FString* OutError)
+{
+	FOPM_RenameRuleSet RuleSet;
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
 	{
-		return;
+		if (Rules[RuleIndex].Find.IsEmpty())
+		{
+			continue;
+		}
+
+		FString Error;
+		if (!RuleSet.AddRule(Rules[RuleIndex], &Error))
+		{
+			if (OutError)
+			{
+				*OutError = FString::Printf(TEXT("Rule %d: %s"), RuleIndex, *Error);
+			}
+			return 0;
+		}
 	}
 
-	ESearchCase::Type SearchCase = bCaseSensitive ? 
-		ESearchCase::CaseSensitive : 
-		ESearchCase::IgnoreCase;
+	if (RuleSet.Num() == 0)
+	{
+		return 0;
+	}
 
+	// Labels are read on the game thread, matching runs on the snapshot
+	TArray<AActor*> Snapshot;
+	TArray<FString> Labels;
+	Snapshot.Reserve(Actors.Num());
+	Labels.Reserve(Actors.Num());
 	for (AActor* Actor : Actors)
 	{
 		if (Actor)
 		{
-			FString CurrentName = Actor->GetActorLabel();
-			FString NewName = CurrentName.Replace(*FindStr, *ReplaceStr, SearchCase);
-			
-			if (NewName != CurrentName)
-			{
-				Actor->SetActorLabel(NewName);
-			}
+			Snapshot.Add(Actor);
+			Labels.Add(Actor->GetActorLabel());
 		}
 	}
+
+	TArray<FString> NewLabels;
+	TArray<bool> Changed;
+	NewLabels.SetNum(Labels.Num());
+	Changed.SetNumZeroed(Labels.Num());
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(Labels.Num(), OPMNaming::BatchSize);
+	ParallelFor(NumBatches, [&](int32 Batch)
+	{
+		const int32 First = Batch * OPMNaming::BatchSize;
+		const int32 Last = FMath::Min(First + OPMNaming::BatchSize, Labels.Num());
+		for (int32 Index = First; Index < Last; ++Index)
+		{
+			Changed[Index] = RuleSet.Apply(Labels[Index], NewLabels[Index]);
+		}
+	}, NumBatches <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	int32 NumRenamed = 0;
+	for (int32 Index = 0; Index < Snapshot.Num(); ++Index)
+	{
+		if (Changed[Index])
+		{
+			SetLabel(Snapshot[Index], NewLabels[Index]);
+			++NumRenamed;
+		}
+	}
+
+	return NumRenamed;
 }
 
 void UOPM_NamingUtilities::RemovePrefix(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	const FString& Prefix)
 {
 	if (Prefix.IsEmpty())
@@ -130,14 +197,14 @@ void UOPM_NamingUtilities::RemovePrefix(
 			if (CurrentName.StartsWith(Prefix))
 			{
 				FString NewName = CurrentName.RightChop(Prefix.Len());
-				Actor->SetActorLabel(NewName);
+				SetLabel(Actor, NewName);
 			}
 		}
 	}
 }
 
 void UOPM_NamingUtilities::RemoveSuffix(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	const FString& Suffix)
 {
 	if (Suffix.IsEmpty())
@@ -153,28 +220,74 @@ void UOPM_NamingUtilities::RemoveSuffix(
 			if (CurrentName.EndsWith(Suffix))
 			{
 				FString NewName = CurrentName.LeftChop(Suffix.Len());
-				Actor->SetActorLabel(NewName);
+				SetLabel(Actor, NewName);
 			}
 		}
 	}
 }
 
-FString UOPM_NamingUtilities::FormatNumber(int32 Number, int32 Padding)
+int32 UOPM_NamingUtilities::ApplyNamingTemplate(
+	TArrayView<AActor* const> Actors,
+	const FString& Pattern,
+	int32 StartIndex,
+	FString* OutError)
 {
-	if (Padding <= 0)
+	FOPM_NamingTemplate Template;
+	if (!Template.Compile(Pattern, OutError))
+	{
+		return 0;
+	}
+
+	// Generate every label before renaming so {Label} always refers to the label the actor had
+	TArray<AActor*> Renamed;
+	TArray<FString> NewLabels;
+	Renamed.Reserve(Actors.Num());
+	NewLabels.Reserve(Actors.Num());
+
+	UWorld* World = nullptr;
+	int32 Index = StartIndex;
+	for (AActor* Actor : Actors)
+	{
+		if (Actor)
+		{
+			World = World ? World : Actor->GetWorld();
+			Renamed.Add(Actor);
+			NewLabels.Add(Template.Generate(Actor, Index++));
+		}
+	}
+
+	if (Renamed.Num() == 0)
 	{
-		return FString::FromInt(Number);
+		return 0;
 	}
 
-	FString NumberStr = FString::FromInt(Number);
-	
-	// Add leading zeros
-	while (NumberStr.Len() < Padding)
+	// The batch gives up its current labels so actors may keep or swap them, labels also held
+	// by actors outside the batch stay taken
+	FOPM_LabelIndex LabelIndex;
+	LabelIndex.Build(World);
+	for (AActor* Actor : Renamed)
 	{
-		NumberStr = TEXT("0") + NumberStr;
+		LabelIndex.Remove(Actor->GetActorLabel());
 	}
 
-	return NumberStr;
+	for (int32 ActorIndex = 0; ActorIndex < Renamed.Num(); ++ActorIndex)
+	{
+		AActor* Actor = Renamed[ActorIndex];
+		const FString Label = LabelIndex.MakeUnique(NewLabels[ActorIndex]);
+		if (!Actor->GetActorLabel().Equals(Label, ESearchCase::CaseSensitive))
+		{
+			SetLabel(Actor, Label);
+		}
+	}
+
+	return Renamed.Num();
+}
+
+FString UOPM_NamingUtilities::FormatNumber(int32 Number, int32 Padding)
+{
+	TStringBuilder<32> Builder;
+	FOPM_NamingTemplate::AppendNumber(Builder, Number, Padding);
+	return FString(Builder.ToView());
 }
 
 FString UOPM_NamingUtilities::GenerateName(
@@ -184,26 +297,25 @@ FString UOPM_NamingUtilities::GenerateName(
 	int32 Number,
 	int32 Padding)
 {
-	FString NewName = BaseName;
-
-	// Add prefix
-	if (!Prefix.IsEmpty())
-	{
-		NewName = Prefix + NewName;
-	}
-
-	// Add suffix
-	if (!Suffix.IsEmpty())
-	{
-		NewName = NewName + Suffix;
-	}
+	TStringBuilder<256> Builder;
+	Builder.Append(Prefix);
+	Builder.Append(BaseName);
+	Builder.Append(Suffix);
 
 	// Add number
 	if (Number >= 0)
 	{
-		FString NumberStr = FormatNumber(Number, Padding);
-		NewName = NewName + TEXT("_") + NumberStr;
+		Builder.AppendChar(TEXT('_'));
+		FOPM_NamingTemplate::AppendNumber(Builder, Number, Padding);
 	}
 
-	return NewName;
+	return FString(Builder.ToView());
+}
+
+// Private helper methods
+
+void UOPM_NamingUtilities::SetLabel(AActor* Actor, const FString& NewName)
+{
+	Actor->SetActorLabel(NewName, false);
+	FOPM_BulkEditScope::MarkPackageDirty(Actor);
 }
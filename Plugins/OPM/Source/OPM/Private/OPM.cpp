@@ -1,6 +1,11 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "OPM.h"
+#include "ActorReplacementUtilities.h"
+#include "FoliageSpatialIndex.h"
+#include "LandscapeWeightmapCache.h"
+#include "LandscapeTileCache.h"
+#include "SplineEvaluationCache.h"
 
 #define LOCTEXT_NAMESPACE "FOPMModule"
 
@@ -13,6 +18,11 @@ void FOPMModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FOPM_FoliageSpatialIndex::ReleaseAll();
+	FOPM_LandscapeWeightmapCache::ReleaseAll();
+	FOPM_LandscapeTileCache::ReleaseAll();
+	FOPM_SplineCache::ReleaseAll();
+	UOPM_ActorReplacementUtilities::ReleaseCopyPlans();
 }
 
 #undef LOCTEXT_NAMESPACE
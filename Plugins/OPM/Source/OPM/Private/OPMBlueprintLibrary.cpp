@@ -7,13 +7,17 @@
 #include "ActorReplacementUtilities.h"
 #include "OrganizationUtilities.h"
 #include "OPMTransactionUtils.h"
+#include "OPMBulkEditScope.h"
 #include "AIPlacementUtilities.h"
 #include "LandscapeIntegrationUtilities.h"
 #include "SplineUtilities.h"
+#include "TagIndexSubsystem.h"
 #include "Engine/World.h"
 #include "Editor.h"
+#include "Engine/Selection.h"
 #include "Landscape.h"
 #include "Components/SplineComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 
 #define LOCTEXT_NAMESPACE "OPMBlueprintLibrary"
 
@@ -58,81 +62,92 @@ TArray<AActor*> UOPMBlueprintLibrary::PlaceActorsInPattern(
 	}
 
 	UWorld* World = WorldContextObject->GetWorld();
+	FOPM_BulkEditScope BulkEdit;
 	return UOPM_PlacementUtilities::PlaceActorsInPattern(ActorClass, Transforms, World);
 }
 
 // ==================== Alignment Functions ====================
 
 void UOPMBlueprintLibrary::AlignActors(
-	TArray<AActor*> Actors,
+	const TArray<AActor*>& Actors,
 	EAlignmentType Type,
 	EAlignmentAxis Axis)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("AlignActors", "Align Actors"));
 	Transaction.ModifyActors(Actors);
 	UOPM_AlignmentUtilities::AlignActors(Actors, Type, Axis);
 }
 
-void UOPMBlueprintLibrary::AlignActorsLeft(TArray<AActor*> Actors)
+void UOPMBlueprintLibrary::AlignActorsLeft(const TArray<AActor*>& Actors)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("AlignLeft", "Align Actors Left"));
 	Transaction.ModifyActors(Actors);
 	UOPM_AlignmentUtilities::AlignActorsLeft(Actors);
 }
 
-void UOPMBlueprintLibrary::AlignActorsRight(TArray<AActor*> Actors)
+void UOPMBlueprintLibrary::AlignActorsRight(const TArray<AActor*>& Actors)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("AlignRight", "Align Actors Right"));
 	Transaction.ModifyActors(Actors);
 	UOPM_AlignmentUtilities::AlignActorsRight(Actors);
 }
 
-void UOPMBlueprintLibrary::AlignActorsTop(TArray<AActor*> Actors)
+void UOPMBlueprintLibrary::AlignActorsTop(const TArray<AActor*>& Actors)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("AlignTop", "Align Actors Top"));
 	Transaction.ModifyActors(Actors);
 	UOPM_AlignmentUtilities::AlignActorsTop(Actors);
 }
 
-void UOPMBlueprintLibrary::AlignActorsBottom(TArray<AActor*> Actors)
+void UOPMBlueprintLibrary::AlignActorsBottom(const TArray<AActor*>& Actors)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("AlignBottom", "Align Actors Bottom"));
 	Transaction.ModifyActors(Actors);
 	UOPM_AlignmentUtilities::AlignActorsBottom(Actors);
 }
 
-void UOPMBlueprintLibrary::CenterActorsX(TArray<AActor*> Actors)
+void UOPMBlueprintLibrary::CenterActorsX(const TArray<AActor*>& Actors)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("CenterX", "Center Actors X"));
 	Transaction.ModifyActors(Actors);
 	UOPM_AlignmentUtilities::CenterActorsX(Actors);
 }
 
-void UOPMBlueprintLibrary::CenterActorsY(TArray<AActor*> Actors)
+void UOPMBlueprintLibrary::CenterActorsY(const TArray<AActor*>& Actors)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("CenterY", "Center Actors Y"));
 	Transaction.ModifyActors(Actors);
 	UOPM_AlignmentUtilities::CenterActorsY(Actors);
 }
 
-void UOPMBlueprintLibrary::CenterActorsZ(TArray<AActor*> Actors)
+void UOPMBlueprintLibrary::CenterActorsZ(const TArray<AActor*>& Actors)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("CenterZ", "Center Actors Z"));
 	Transaction.ModifyActors(Actors);
 	UOPM_AlignmentUtilities::CenterActorsZ(Actors);
 }
 
 void UOPMBlueprintLibrary::DistributeActors(
-	TArray<AActor*> Actors,
+	const TArray<AActor*>& Actors,
 	EDistributionType Type)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("Distribute", "Distribute Actors"));
 	Transaction.ModifyActors(Actors);
 	UOPM_AlignmentUtilities::DistributeActors(Actors, Type);
 }
 
-void UOPMBlueprintLibrary::SnapActorsToGrid(TArray<AActor*> Actors, float GridSize)
+void UOPMBlueprintLibrary::SnapActorsToGrid(const TArray<AActor*>& Actors, float GridSize)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("SnapToGrid", "Snap Actors to Grid"));
 	Transaction.ModifyActors(Actors);
 	UOPM_AlignmentUtilities::SnapActorsToGrid(Actors, GridSize);
@@ -141,54 +156,83 @@ void UOPMBlueprintLibrary::SnapActorsToGrid(TArray<AActor*> Actors, float GridSi
 // ==================== Naming Functions ====================
 
 void UOPMBlueprintLibrary::BatchRename(
-	TArray<AActor*> Actors,
+	const TArray<AActor*>& Actors,
 	const FString& Prefix,
 	const FString& Suffix,
 	int32 StartNumber,
 	int32 Padding)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("BatchRename", "Batch Rename Actors"));
 	Transaction.ModifyActors(Actors);
 	UOPM_NamingUtilities::BatchRename(Actors, Prefix, Suffix, StartNumber, Padding);
 }
 
-void UOPMBlueprintLibrary::AddPrefix(TArray<AActor*> Actors, const FString& Prefix)
+void UOPMBlueprintLibrary::AddPrefix(const TArray<AActor*>& Actors, const FString& Prefix)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("AddPrefix", "Add Prefix to Actors"));
 	Transaction.ModifyActors(Actors);
 	UOPM_NamingUtilities::AddPrefix(Actors, Prefix);
 }
 
-void UOPMBlueprintLibrary::AddSuffix(TArray<AActor*> Actors, const FString& Suffix)
+void UOPMBlueprintLibrary::AddSuffix(const TArray<AActor*>& Actors, const FString& Suffix)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("AddSuffix", "Add Suffix to Actors"));
 	Transaction.ModifyActors(Actors);
 	UOPM_NamingUtilities::AddSuffix(Actors, Suffix);
 }
 
-void UOPMBlueprintLibrary::AutoNumber(TArray<AActor*> Actors, int32 StartNumber, int32 Padding)
+void UOPMBlueprintLibrary::AutoNumber(const TArray<AActor*>& Actors, int32 StartNumber, int32 Padding)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("AutoNumber", "Auto Number Actors"));
 	Transaction.ModifyActors(Actors);
 	UOPM_NamingUtilities::AutoNumber(Actors, StartNumber, Padding);
 }
 
 void UOPMBlueprintLibrary::FindAndReplace(
-	TArray<AActor*> Actors,
+	const TArray<AActor*>& Actors,
 	const FString& FindStr,
 	const FString& ReplaceStr,
 	bool bCaseSensitive)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("FindReplace", "Find and Replace in Names"));
 	Transaction.ModifyActors(Actors);
 	UOPM_NamingUtilities::FindAndReplace(Actors, FindStr, ReplaceStr, bCaseSensitive);
 }
 
+int32 UOPMBlueprintLibrary::ApplyNamingTemplate(
+	const TArray<AActor*>& Actors,
+	const FString& Pattern,
+	int32 StartIndex)
+{
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("ApplyNamingTemplate", "Apply Naming Template"));
+	Transaction.ModifyActors(Actors);
+	return UOPM_NamingUtilities::ApplyNamingTemplate(Actors, Pattern, StartIndex);
+}
+
+int32 UOPMBlueprintLibrary::ApplyRenameRules(
+	const TArray<AActor*>& Actors,
+	const TArray<FRenameRule>& Rules,
+	FString& OutError)
+{
+	OutError.Reset();
+
+	FOPM_BulkEditScope BulkEdit;
+	// Only relabelled actors are recorded, SetActorLabel modifies each one it changes
+	FOPM_TransactionScope Transaction(LOCTEXT("ApplyRenameRules", "Apply Rename Rules"));
+	return UOPM_NamingUtilities::ApplyRenameRules(Actors, Rules, &OutError);
+}
+
 // ==================== Replacement Functions ====================
 
 TArray<AActor*> UOPMBlueprintLibrary::BatchReplaceActors(
 	UObject* WorldContextObject,
-	TArray<AActor*> OldActors,
+	const TArray<AActor*>& OldActors,
 	UClass* NewActorClass,
 	bool bPreserveTransform,
 	bool bPreserveAttachments)
@@ -199,6 +243,7 @@ TArray<AActor*> UOPMBlueprintLibrary::BatchReplaceActors(
 	}
 
 	UWorld* World = WorldContextObject->GetWorld();
+	FOPM_BulkEditScope BulkEdit;
 	return UOPM_ActorReplacementUtilities::BatchReplaceActors(
 		OldActors,
 		NewActorClass,
@@ -208,34 +253,89 @@ TArray<AActor*> UOPMBlueprintLibrary::BatchReplaceActors(
 	);
 }
 
+AActor* UOPMBlueprintLibrary::ConvertActorsToInstances(
+	UObject* WorldContextObject,
+	const TArray<AActor*>& Actors,
+	bool bHierarchical)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("ConvertToInstances", "Convert Actors to Instances"));
+	Transaction.ModifyActors(Actors);
+	return UOPM_ActorReplacementUtilities::ConvertActorsToInstances(Actors, World, bHierarchical);
+}
+
+TArray<AActor*> UOPMBlueprintLibrary::ConvertInstancesToActors(
+	UObject* WorldContextObject,
+	UInstancedStaticMeshComponent* Component,
+	const TArray<int32>& InstanceIndices,
+	bool bAllInstances)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return TArray<AActor*>();
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("ConvertToActors", "Convert Instances to Actors"));
+	return UOPM_ActorReplacementUtilities::ConvertInstancesToActors(Component, InstanceIndices, World, bAllInstances);
+}
+
 // ==================== Organization Functions ====================
 
-void UOPMBlueprintLibrary::SetActorFolder(TArray<AActor*> Actors, const FString& FolderPath)
+void UOPMBlueprintLibrary::SetActorFolder(const TArray<AActor*>& Actors, const FString& FolderPath)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("SetFolder", "Set Actor Folder"));
 	Transaction.ModifyActors(Actors);
 	UOPM_OrganizationUtilities::SetActorFolder(Actors, FName(*FolderPath));
 }
 
-void UOPMBlueprintLibrary::GroupActorsByType(TArray<AActor*> Actors)
+void UOPMBlueprintLibrary::GroupActorsByType(const TArray<AActor*>& Actors)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("GroupByType", "Group Actors by Type"));
 	Transaction.ModifyActors(Actors);
 	UOPM_OrganizationUtilities::GroupActorsByType(Actors, true);
 }
 
-void UOPMBlueprintLibrary::ApplyTags(TArray<AActor*> Actors, const TArray<FName>& Tags)
+int32 UOPMBlueprintLibrary::GroupActorsSpatially(
+	UObject* WorldContextObject,
+	const TArray<AActor*>& Actors,
+	const FSpatialGroupingSettings& Settings)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return 0;
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("GroupSpatially", "Group Actors Spatially"));
+	Transaction.ModifyActors(Actors);
+	return UOPM_OrganizationUtilities::GroupActorsSpatially(Actors, Settings, World);
+}
+
+void UOPMBlueprintLibrary::ApplyTags(const TArray<AActor*>& Actors, const TArray<FName>& Tags)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("ApplyTags", "Apply Tags to Actors"));
 	Transaction.ModifyActors(Actors);
 	UOPM_OrganizationUtilities::ApplyTagsToActors(Actors, Tags, false);
 }
 
 void UOPMBlueprintLibrary::AttachActorsToParent(
-	TArray<AActor*> Actors,
+	const TArray<AActor*>& Actors,
 	AActor* ParentActor,
 	bool bMaintainWorldTransform)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("AttachToParent", "Attach Actors to Parent"));
 	Transaction.ModifyActors(Actors);
 	if (ParentActor)
@@ -245,13 +345,50 @@ void UOPMBlueprintLibrary::AttachActorsToParent(
 	UOPM_OrganizationUtilities::AttachActorsToParent(Actors, ParentActor, bMaintainWorldTransform);
 }
 
-void UOPMBlueprintLibrary::DetachActorsFromParent(TArray<AActor*> Actors, bool bMaintainWorldTransform)
+void UOPMBlueprintLibrary::DetachActorsFromParent(const TArray<AActor*>& Actors, bool bMaintainWorldTransform)
 {
+	FOPM_BulkEditScope BulkEdit;
 	FOPM_TransactionScope Transaction(LOCTEXT("DetachFromParent", "Detach Actors from Parent"));
 	Transaction.ModifyActors(Actors);
 	UOPM_OrganizationUtilities::DetachActorsFromParent(Actors, bMaintainWorldTransform);
 }
 
+TArray<AActor*> UOPMBlueprintLibrary::QueryActorsByTags(UObject* WorldContextObject, const FTagQuery& Query)
+{
+	TArray<AActor*> Actors;
+
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	UOPM_TagIndexSubsystem* TagIndex = UOPM_TagIndexSubsystem::Get();
+	if (World && TagIndex)
+	{
+		TagIndex->Query(World, Query, Actors);
+	}
+
+	return Actors;
+}
+
+int32 UOPMBlueprintLibrary::SelectActorsByTags(UObject* WorldContextObject, const FTagQuery& Query)
+{
+	const TArray<AActor*> Actors = QueryActorsByTags(WorldContextObject, Query);
+
+#if WITH_EDITOR
+	if (GEditor)
+	{
+		USelection* Selection = GEditor->GetSelectedActors();
+		Selection->BeginBatchSelectOperation();
+		GEditor->SelectNone(false, true, false);
+		for (AActor* Actor : Actors)
+		{
+			GEditor->SelectActor(Actor, true, false, true);
+		}
+		Selection->EndBatchSelectOperation();
+		GEditor->NoteSelectionChange();
+	}
+#endif
+
+	return Actors.Num();
+}
+
 // ==================== Utility Functions ====================
 
 TArray<AActor*> UOPMBlueprintLibrary::GetSelectedActors()
@@ -326,7 +463,8 @@ TArray<AActor*> UOPMBlueprintLibrary::PlaceActorsOnLandscape(
 	UClass* ActorClass,
 	const TArray<FTransform>& Transforms,
 	ALandscape* Landscape,
-	const FLandscapePlacementSettings& Settings)
+	const FLandscapePlacementSettings& Settings,
+	bool bKeepOnTerrain)
 {
 	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
 	if (!World)
@@ -334,7 +472,8 @@ TArray<AActor*> UOPMBlueprintLibrary::PlaceActorsOnLandscape(
 		return TArray<AActor*>();
 	}
 
-	return UOPM_LandscapeIntegrationUtilities::PlaceActorsOnLandscape(ActorClass, Transforms, Landscape, Settings, World);
+	FOPM_BulkEditScope BulkEdit;
+	return UOPM_LandscapeIntegrationUtilities::PlaceActorsOnLandscape(ActorClass, Transforms, Landscape, Settings, World, bKeepOnTerrain);
 }
 
 bool UOPMBlueprintLibrary::SampleLandscapeHeight(
@@ -345,6 +484,15 @@ bool UOPMBlueprintLibrary::SampleLandscapeHeight(
 	return UOPM_LandscapeIntegrationUtilities::SampleLandscapeHeight(Landscape, Location, OutHeight);
 }
 
+bool UOPMBlueprintLibrary::SampleLandscapeLayerWeight(
+	ALandscape* Landscape,
+	FName LayerName,
+	const FVector& Location,
+	float& OutWeight)
+{
+	return UOPM_LandscapeIntegrationUtilities::SampleLandscapeLayerWeight(Landscape, LayerName, Location, OutWeight);
+}
+
 float UOPMBlueprintLibrary::CalculateSlopeAngle(
 	ALandscape* Landscape,
 	const FVector& Location)
@@ -378,6 +526,23 @@ TArray<AActor*> UOPMBlueprintLibrary::PlaceActorsAlongSpline(
 	UObject* WorldContextObject,
 	UClass* ActorClass,
 	USplineComponent* SplineComponent,
+	const FSplinePlacementSettings& Settings,
+	bool bWatchSpline)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return TArray<AActor*>();
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	return UOPM_SplineUtilities::PlaceActorsAlongSpline(ActorClass, SplineComponent, Settings, World, bWatchSpline);
+}
+
+TArray<AActor*> UOPMBlueprintLibrary::PlaceActorsAlongSplines(
+	UObject* WorldContextObject,
+	UClass* ActorClass,
+	const TArray<USplineComponent*>& Splines,
 	const FSplinePlacementSettings& Settings)
 {
 	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
@@ -386,7 +551,74 @@ TArray<AActor*> UOPMBlueprintLibrary::PlaceActorsAlongSpline(
 		return TArray<AActor*>();
 	}
 
-	return UOPM_SplineUtilities::PlaceActorsAlongSpline(ActorClass, SplineComponent, Settings, World);
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("PlaceActorsAlongSplines", "Place Actors Along Splines"));
+	return UOPM_SplineUtilities::PlaceActorsAlongSplines(ActorClass, Splines, Settings, World);
+}
+
+AActor* UOPMBlueprintLibrary::PlaceInstancesAlongSplines(
+	UObject* WorldContextObject,
+	UStaticMesh* Mesh,
+	const TArray<USplineComponent*>& Splines,
+	const FSplinePlacementSettings& Settings,
+	AActor* TargetActor)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("PlaceInstancesAlongSplines", "Place Instances Along Splines"));
+	Transaction.ModifyActor(TargetActor);
+
+	return UOPM_SplineUtilities::PlaceInstancesAlongSplines(Mesh, Splines, Settings, World, TargetActor);
+}
+
+TArray<AActor*> UOPMBlueprintLibrary::PlaceActorsAlongSplineNetwork(
+	UObject* WorldContextObject,
+	UClass* ActorClass,
+	const TArray<USplineComponent*>& Splines,
+	const FSplinePlacementSettings& Settings,
+	float JunctionClearance)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return TArray<AActor*>();
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("PlaceActorsAlongSplineNetwork", "Place Actors Along Spline Network"));
+	return UOPM_SplineUtilities::PlaceActorsAlongSplineNetwork(ActorClass, Splines, Settings, JunctionClearance, World);
+}
+
+TArray<FVector> UOPMBlueprintLibrary::FindSplineJunctions(
+	const TArray<USplineComponent*>& Splines,
+	float Tolerance)
+{
+	return UOPM_SplineUtilities::FindSplineJunctions(Splines, Tolerance);
+}
+
+AActor* UOPMBlueprintLibrary::PlaceSplineMeshesAlongSpline(
+	UObject* WorldContextObject,
+	UStaticMesh* Mesh,
+	USplineComponent* SplineComponent,
+	const FSplinePlacementSettings& Settings,
+	AActor* TargetActor)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("PlaceSplineMeshes", "Place Spline Meshes"));
+	Transaction.ModifyActor(TargetActor);
+
+	return UOPM_SplineUtilities::PlaceSplineMeshesAlongSpline(Mesh, SplineComponent, Settings, World, TargetActor);
 }
 
 TArray<FTransform> UOPMBlueprintLibrary::GenerateTransformsAlongSpline(
@@ -409,7 +641,10 @@ TArray<AActor*> UOPMBlueprintLibrary::GenerateRoadAlongSpline(
 		return TArray<AActor*>();
 	}
 
+	FOPM_BulkEditScope BulkEdit;
+	PRAGMA_DISABLE_DEPRECATION_WARNINGS
 	return UOPM_SplineUtilities::GenerateRoadAlongSpline(SplineComponent, RoadActorClass, PropActorClasses, PropSpacing, World);
+	PRAGMA_ENABLE_DEPRECATION_WARNINGS
 }
 
 TArray<AActor*> UOPMBlueprintLibrary::GenerateFenceAlongSpline(
@@ -425,7 +660,10 @@ TArray<AActor*> UOPMBlueprintLibrary::GenerateFenceAlongSpline(
 		return TArray<AActor*>();
 	}
 
+	FOPM_BulkEditScope BulkEdit;
+	PRAGMA_DISABLE_DEPRECATION_WARNINGS
 	return UOPM_SplineUtilities::GenerateFenceAlongSpline(SplineComponent, PostActorClass, PanelActorClass, PostSpacing, World);
+	PRAGMA_ENABLE_DEPRECATION_WARNINGS
 }
 
 TArray<AActor*> UOPMBlueprintLibrary::GenerateCableRoutingAlongSpline(
@@ -434,7 +672,8 @@ TArray<AActor*> UOPMBlueprintLibrary::GenerateCableRoutingAlongSpline(
 	UClass* CableActorClass,
 	UClass* SupportsActorClass,
 	float SupportSpacing,
-	float SagAmount)
+	float SagAmount,
+	float TensionRatio)
 {
 	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
 	if (!World)
@@ -442,7 +681,109 @@ TArray<AActor*> UOPMBlueprintLibrary::GenerateCableRoutingAlongSpline(
 		return TArray<AActor*>();
 	}
 
-	return UOPM_SplineUtilities::GenerateCableRoutingAlongSpline(SplineComponent, CableActorClass, SupportsActorClass, SupportSpacing, SagAmount, World);
+	FOPM_BulkEditScope BulkEdit;
+	return UOPM_SplineUtilities::GenerateCableRoutingAlongSpline(SplineComponent, CableActorClass, SupportsActorClass, SupportSpacing, SagAmount, World, TensionRatio);
+}
+
+AActor* UOPMBlueprintLibrary::GenerateRoadComposite(
+	UObject* WorldContextObject,
+	USplineComponent* SplineComponent,
+	UStaticMesh* RoadMesh,
+	const TArray<UStaticMesh*>& PropMeshes,
+	float PropSpacing,
+	AActor* TargetActor)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("GenerateRoadComposite", "Generate Road"));
+	Transaction.ModifyActor(TargetActor);
+
+	return UOPM_SplineUtilities::GenerateRoadComposite(SplineComponent, RoadMesh, PropMeshes, PropSpacing, World, TargetActor);
+}
+
+AActor* UOPMBlueprintLibrary::GenerateFenceComposite(
+	UObject* WorldContextObject,
+	USplineComponent* SplineComponent,
+	UStaticMesh* PostMesh,
+	UStaticMesh* PanelMesh,
+	float PostSpacing,
+	AActor* TargetActor)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("GenerateFenceComposite", "Generate Fence"));
+	Transaction.ModifyActor(TargetActor);
+
+	return UOPM_SplineUtilities::GenerateFenceComposite(SplineComponent, PostMesh, PanelMesh, PostSpacing, World, TargetActor);
+}
+
+AActor* UOPMBlueprintLibrary::GenerateCableComposite(
+	UObject* WorldContextObject,
+	USplineComponent* SplineComponent,
+	UStaticMesh* CableMesh,
+	UStaticMesh* SupportMesh,
+	float SupportSpacing,
+	float SagAmount,
+	AActor* TargetActor,
+	float TensionRatio)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("GenerateCableComposite", "Generate Cable Routing"));
+	Transaction.ModifyActor(TargetActor);
+
+	return UOPM_SplineUtilities::GenerateCableComposite(SplineComponent, CableMesh, SupportMesh, SupportSpacing, SagAmount, World, TargetActor, TensionRatio);
+}
+
+int32 UOPMBlueprintLibrary::SnapSplineToTerrainDense(
+	UObject* WorldContextObject,
+	USplineComponent* SplineComponent,
+	float HeightOffset,
+	float SampleSpacing,
+	float Tolerance)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World || !SplineComponent)
+	{
+		return 0;
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("SnapSplineToTerrain", "Snap Spline To Terrain"));
+	SplineComponent->Modify();
+
+	return UOPM_SplineUtilities::SnapSplineToTerrainDense(SplineComponent, World, HeightOffset, SampleSpacing, Tolerance);
+}
+
+FSplineSimplificationResult UOPMBlueprintLibrary::SimplifySpline(
+	USplineComponent* SplineComponent,
+	float Tolerance)
+{
+	if (!SplineComponent)
+	{
+		return FSplineSimplificationResult();
+	}
+
+	FOPM_BulkEditScope BulkEdit;
+	FOPM_TransactionScope Transaction(LOCTEXT("SimplifySpline", "Simplify Spline"));
+	SplineComponent->Modify();
+
+	return UOPM_SplineUtilities::SimplifySpline(SplineComponent, Tolerance);
 }
 
 float UOPMBlueprintLibrary::GetSplineLength(USplineComponent* SplineComponent)
@@ -453,9 +794,10 @@ float UOPMBlueprintLibrary::GetSplineLength(USplineComponent* SplineComponent)
 TArray<float> UOPMBlueprintLibrary::GetAdaptiveDistances(
 	USplineComponent* SplineComponent,
 	float MinSpacing,
-	float MaxSpacing)
+	float MaxSpacing,
+	float ChordTolerance)
 {
-	return UOPM_SplineUtilities::GetAdaptiveDistances(SplineComponent, MinSpacing, MaxSpacing);
+	return UOPM_SplineUtilities::GetAdaptiveDistances(SplineComponent, MinSpacing, MaxSpacing, ChordTolerance);
 }
 
 #undef LOCTEXT_NAMESPACE
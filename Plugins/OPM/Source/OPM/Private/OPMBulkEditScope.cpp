@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OPMBulkEditScope.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "Engine/Selection.h"
+#endif
+
+namespace OPMBulkEdit
+{
+	/** Number of open scopes, deferred work is flushed when it returns to zero */
+	static int32 Depth = 0;
+
+	static TSet<TWeakObjectPtr<UPackage>> DirtyPackages;
+	static bool bRedrawViewports = false;
+}
+
+FOPM_BulkEditScope::FOPM_BulkEditScope()
+{
+	check(IsInGameThread());
+
+	if (OPMBulkEdit::Depth++ == 0)
+	{
+#if WITH_EDITOR
+		if (GEditor)
+		{
+			GEditor->GetSelectedActors()->BeginBatchSelectOperation();
+		}
+#endif
+	}
+}
+
+FOPM_BulkEditScope::~FOPM_BulkEditScope()
+{
+	check(OPMBulkEdit::Depth > 0);
+
+	if (--OPMBulkEdit::Depth == 0)
+	{
+#if WITH_EDITOR
+		if (GEditor)
+		{
+			GEditor->GetSelectedActors()->EndBatchSelectOperation();
+		}
+#endif
+		Flush();
+	}
+}
+
+bool FOPM_BulkEditScope::IsActive()
+{
+	return OPMBulkEdit::Depth > 0;
+}
+
+void FOPM_BulkEditScope::ModifyActor(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	if (!IsActive())
+	{
+		Actor->Modify();
+		return;
+	}
+
+	Actor->Modify(false);
+	MarkPackageDirty(Actor);
+}
+
+void FOPM_BulkEditScope::MarkPackageDirty(UObject* Object)
+{
+	if (!Object)
+	{
+		return;
+	}
+
+	if (!IsActive())
+	{
+		Object->MarkPackageDirty();
+		return;
+	}
+
+	if (UPackage* Package = Object->GetPackage())
+	{
+		OPMBulkEdit::DirtyPackages.Add(Package);
+	}
+}
+
+void FOPM_BulkEditScope::RequestViewportRedraw()
+{
+	OPMBulkEdit::bRedrawViewports = true;
+
+	if (!IsActive())
+	{
+		Flush();
+	}
+}
+
+// Private helper methods
+
+void FOPM_BulkEditScope::Flush()
+{
+	for (const TWeakObjectPtr<UPackage>& Package : OPMBulkEdit::DirtyPackages)
+	{
+		if (Package.IsValid())
+		{
+			Package->MarkPackageDirty();
+		}
+	}
+	OPMBulkEdit::DirtyPackages.Reset();
+
+#if WITH_EDITOR
+	if (GEditor && OPMBulkEdit::bRedrawViewports)
+	{
+		GEditor->RedrawLevelEditingViewports();
+	}
+#endif
+
+	OPMBulkEdit::bRedrawViewports = false;
+}
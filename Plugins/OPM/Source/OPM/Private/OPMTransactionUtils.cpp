@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "OPMTransactionUtils.h"
+#include "OPMBulkEditScope.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -30,17 +31,14 @@ FOPM_TransactionScope::~FOPM_TransactionScope()
 #endif
 }
 
-void FOPM_TransactionScope::ModifyActors(const TArray<AActor*>& Actors)
+void FOPM_TransactionScope::ModifyActors(TArrayView<AActor* const> Actors)
 {
 #if WITH_EDITOR
 	if (bTransactionStarted)
 	{
 		for (AActor* Actor : Actors)
 		{
-			if (Actor)
-			{
-				Actor->Modify();
-			}
+			FOPM_BulkEditScope::ModifyActor(Actor);
 		}
 	}
 #endif
@@ -49,9 +47,9 @@ void FOPM_TransactionScope::ModifyActors(const TArray<AActor*>& Actors)
 void FOPM_TransactionScope::ModifyActor(AActor* Actor)
 {
 #if WITH_EDITOR
-	if (bTransactionStarted && Actor)
+	if (bTransactionStarted)
 	{
-		Actor->Modify();
+		FOPM_BulkEditScope::ModifyActor(Actor);
 	}
 #endif
 }
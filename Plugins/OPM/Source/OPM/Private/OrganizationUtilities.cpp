@@ -1,11 +1,13 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "OrganizationUtilities.h"
+#include "TagIndexSubsystem.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
 
 void UOPM_OrganizationUtilities::SetActorFolder(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	const FName& FolderPath)
 {
 	for (AActor* Actor : Actors)
@@ -18,7 +20,7 @@ void UOPM_OrganizationUtilities::SetActorFolder(
 }
 
 void UOPM_OrganizationUtilities::GroupActorsByType(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	bool bUseClassName)
 {
 	// Group actors by their class
@@ -63,8 +65,64 @@ void UOPM_OrganizationUtilities::GroupActorsByType(
 	}
 }
 
+int32 UOPM_OrganizationUtilities::GroupActorsSpatially(
+	TArrayView<AActor* const> Actors,
+	const FSpatialGroupingSettings& Settings,
+	UWorld* World)
+{
+	// Attached actors are shown under their parent whatever their folder, so they follow it
+	TArray<AActor*> Candidates;
+	Candidates.Reserve(Actors.Num());
+	for (AActor* Actor : Actors)
+	{
+		if (Actor && !Actor->GetAttachParentActor())
+		{
+			Candidates.Add(Actor);
+		}
+	}
+
+	TArray<FSpatialGroup> Groups;
+	if (Settings.Mode == ESpatialGroupingMode::GridCell)
+	{
+		BuildGridGroups(Candidates, FMath::Max(Settings.CellSize, 1.0f), Groups);
+	}
+	else
+	{
+		BuildClusterGroups(Candidates, FMath::Max(Settings.ClusterRadius, 1.0f), Settings.MinClusterSize, Groups);
+	}
+
+	int32 NumCreated = 0;
+	for (const FSpatialGroup& Group : Groups)
+	{
+		const FString GroupName = Settings.RootName.IsEmpty() ? Group.Name : Settings.RootName / Group.Name;
+
+		if (Settings.Output == ESpatialGroupingOutput::Folders)
+		{
+			SetActorFolder(Group.Actors, FName(*GroupName));
+			++NumCreated;
+			continue;
+		}
+
+		FVector Centroid = FVector::ZeroVector;
+		for (const AActor* Actor : Group.Actors)
+		{
+			Centroid += Actor->GetActorLocation();
+		}
+		Centroid /= Group.Actors.Num();
+
+		const FString Label = Settings.RootName.IsEmpty() ? Group.Name : Settings.RootName + TEXT("_") + Group.Name;
+		if (AActor* ParentActor = CreateParentActor(World, Centroid, Label))
+		{
+			AttachActorsToParent(Group.Actors, ParentActor, true);
+			++NumCreated;
+		}
+	}
+
+	return NumCreated;
+}
+
 void UOPM_OrganizationUtilities::ApplyTagsToActors(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	const TArray<FName>& Tags,
 	bool bReplace)
 {
@@ -85,10 +143,15 @@ void UOPM_OrganizationUtilities::ApplyTagsToActors(
 			}
 		}
 	}
+
+	if (UOPM_TagIndexSubsystem* TagIndex = UOPM_TagIndexSubsystem::Get())
+	{
+		TagIndex->UpdateActors(Actors);
+	}
 }
 
 void UOPM_OrganizationUtilities::RemoveTagsFromActors(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	const TArray<FName>& Tags)
 {
 	for (AActor* Actor : Actors)
@@ -101,9 +164,14 @@ void UOPM_OrganizationUtilities::RemoveTagsFromActors(
 			}
 		}
 	}
+
+	if (UOPM_TagIndexSubsystem* TagIndex = UOPM_TagIndexSubsystem::Get())
+	{
+		TagIndex->UpdateActors(Actors);
+	}
 }
 
-void UOPM_OrganizationUtilities::ClearActorTags(TArray<AActor*> Actors)
+void UOPM_OrganizationUtilities::ClearActorTags(TArrayView<AActor* const> Actors)
 {
 	for (AActor* Actor : Actors)
 	{
@@ -112,10 +180,15 @@ void UOPM_OrganizationUtilities::ClearActorTags(TArray<AActor*> Actors)
 			Actor->Tags.Empty();
 		}
 	}
+
+	if (UOPM_TagIndexSubsystem* TagIndex = UOPM_TagIndexSubsystem::Get())
+	{
+		TagIndex->UpdateActors(Actors);
+	}
 }
 
 void UOPM_OrganizationUtilities::AttachActorsToParent(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	AActor* ParentActor,
 	bool bMaintainWorldTransform)
 {
@@ -138,7 +211,7 @@ void UOPM_OrganizationUtilities::AttachActorsToParent(
 }
 
 void UOPM_OrganizationUtilities::DetachActorsFromParent(
-	TArray<AActor*> Actors,
+	TArrayView<AActor* const> Actors,
 	bool bMaintainWorldTransform)
 {
 	FDetachmentTransformRules TransformRules = bMaintainWorldTransform ?
@@ -166,6 +239,7 @@ AActor* UOPM_OrganizationUtilities::CreateParentActor(
 
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.Name = FName(*GroupName);
+	SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
 	AActor* ParentActor = World->SpawnActor<AActor>(
@@ -177,8 +251,161 @@ AActor* UOPM_OrganizationUtilities::CreateParentActor(
 
 	if (ParentActor)
 	{
+		// A bare actor has no root, give it one so children can attach
+		if (!ParentActor->GetRootComponent())
+		{
+			USceneComponent* Root = NewObject<USceneComponent>(ParentActor, TEXT("Root"), RF_Transactional);
+			Root->SetWorldLocation(Location);
+			ParentActor->SetRootComponent(Root);
+			ParentActor->AddInstanceComponent(Root);
+			Root->RegisterComponent();
+		}
+
 		ParentActor->SetActorLabel(GroupName);
 	}
 
 	return ParentActor;
 }
+
+// Private helper methods
+
+void UOPM_OrganizationUtilities::BuildGridGroups(
+	TArrayView<AActor* const> Actors,
+	float CellSize,
+	TArray<FSpatialGroup>& OutGroups)
+{
+	TMap<FIntPoint, int32> CellGroups;
+	TArray<FIntPoint> GroupCells;
+
+	for (AActor* Actor : Actors)
+	{
+		const FVector Location = Actor->GetActorLocation();
+		const FIntPoint Cell(
+			FMath::FloorToInt(Location.X / CellSize),
+			FMath::FloorToInt(Location.Y / CellSize));
+
+		int32& GroupIndex = CellGroups.FindOrAdd(Cell, INDEX_NONE);
+		if (GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = OutGroups.AddDefaulted();
+			OutGroups[GroupIndex].Name = FString::Printf(TEXT("Cell_%d_%d"), Cell.X, Cell.Y);
+			GroupCells.Add(Cell);
+		}
+		OutGroups[GroupIndex].Actors.Add(Actor);
+	}
+
+	// Order groups by cell so the outliner lists them predictably
+	TArray<int32> Order;
+	Order.Reserve(OutGroups.Num());
+	for (int32 Index = 0; Index < OutGroups.Num(); ++Index)
+	{
+		Order.Add(Index);
+	}
+	Order.Sort([&GroupCells](int32 A, int32 B)
+	{
+		return GroupCells[A].Y != GroupCells[B].Y ? GroupCells[A].Y < GroupCells[B].Y : GroupCells[A].X < GroupCells[B].X;
+	});
+
+	TArray<FSpatialGroup> Sorted;
+	Sorted.Reserve(OutGroups.Num());
+	for (int32 Index : Order)
+	{
+		Sorted.Add(MoveTemp(OutGroups[Index]));
+	}
+	OutGroups = MoveTemp(Sorted);
+}
+
+void UOPM_OrganizationUtilities::BuildClusterGroups(
+	TArrayView<AActor* const> Actors,
+	float Radius,
+	int32 MinClusterSize,
+	TArray<FSpatialGroup>& OutGroups)
+{
+	const int32 NumActors = Actors.Num();
+	const float RadiusSquared = Radius * Radius;
+
+	// Hash with cells one radius wide, so neighbours are always in the surrounding 3x3 cells
+	TArray<FVector> Locations;
+	TArray<FIntPoint> ActorCells;
+	TMap<FIntPoint, TArray<int32>> Cells;
+	Locations.Reserve(NumActors);
+	ActorCells.Reserve(NumActors);
+	for (int32 Index = 0; Index < NumActors; ++Index)
+	{
+		const FVector Location = Actors[Index]->GetActorLocation();
+		const FIntPoint Cell(FMath::FloorToInt(Location.X / Radius), FMath::FloorToInt(Location.Y / Radius));
+		Locations.Add(Location);
+		ActorCells.Add(Cell);
+		Cells.FindOrAdd(Cell).Add(Index);
+	}
+
+	// Union-find over actors, joined whenever two are within the radius
+	TArray<int32> Parents;
+	Parents.SetNumUninitialized(NumActors);
+	for (int32 Index = 0; Index < NumActors; ++Index)
+	{
+		Parents[Index] = Index;
+	}
+
+	auto FindRoot = [&Parents](int32 Index)
+	{
+		while (Parents[Index] != Index)
+		{
+			Parents[Index] = Parents[Parents[Index]];
+			Index = Parents[Index];
+		}
+		return Index;
+	};
+
+	for (int32 Index = 0; Index < NumActors; ++Index)
+	{
+		for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+		{
+			for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+			{
+				const TArray<int32>* Neighbours = Cells.Find(ActorCells[Index] + FIntPoint(OffsetX, OffsetY));
+				if (!Neighbours)
+				{
+					continue;
+				}
+
+				for (int32 Other : *Neighbours)
+				{
+					if (Other <= Index || FVector::DistSquared(Locations[Index], Locations[Other]) > RadiusSquared)
+					{
+						continue;
+					}
+
+					const int32 RootA = FindRoot(Index);
+					const int32 RootB = FindRoot(Other);
+					if (RootA != RootB)
+					{
+						Parents[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB);
+					}
+				}
+			}
+		}
+	}
+
+	// Clusters are numbered in order of their first actor
+	TMap<int32, int32> RootGroups;
+	TArray<FSpatialGroup> Clusters;
+	for (int32 Index = 0; Index < NumActors; ++Index)
+	{
+		int32& GroupIndex = RootGroups.FindOrAdd(FindRoot(Index), INDEX_NONE);
+		if (GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = Clusters.AddDefaulted();
+		}
+		Clusters[GroupIndex].Actors.Add(Actors[Index]);
+	}
+
+	for (FSpatialGroup& Cluster : Clusters)
+	{
+		if (Cluster.Actors.Num() >= MinClusterSize)
+		{
+			Cluster.Name = FString::Printf(TEXT("Cluster_%03d"), OutGroups.Num());
+			OutGroups.Add(MoveTemp(Cluster));
+		}
+	}
+}
@@ -0,0 +1,178 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RenameRuleSet.h"
+
+namespace OPMRenameRules
+{
+	/** Helper to translate a wildcard pattern into an anchored regular expression */
+	static FString WildcardToRegex(const FString& Wildcard)
+	{
+		FString Regex;
+		Regex.Reserve(Wildcard.Len() * 2 + 2);
+		Regex.AppendChar(TEXT('^'));
+
+		for (TCHAR Char : Wildcard)
+		{
+			switch (Char)
+			{
+			case TEXT('*'):
+				Regex += TEXT("(.*)");
+				break;
+
+			case TEXT('?'):
+				Regex += TEXT("(.)");
+				break;
+
+			case TEXT('\\'): case TEXT('^'): case TEXT('$'): case TEXT('.'): case TEXT('|'):
+			case TEXT('+'): case TEXT('('): case TEXT(')'): case TEXT('['): case TEXT(']'):
+			case TEXT('{'): case TEXT('}'):
+				Regex.AppendChar(TEXT('\\'));
+				Regex.AppendChar(Char);
+				break;
+
+			default:
+				Regex.AppendChar(Char);
+				break;
+			}
+		}
+
+		Regex.AppendChar(TEXT('$'));
+		return Regex;
+	}
+
+	/** Helper to check that a regular expression compiles, invalid patterns silently never match */
+	static bool IsValidRegex(const FString& Source, bool bCaseSensitive)
+	{
+		// A valid pattern with an empty alternative always matches the empty string
+		const FRegexPattern Trial(TEXT("(?:") + Source + TEXT(")|"), bCaseSensitive ? ERegexPatternFlags::None : ERegexPatternFlags::CaseInsensitive);
+		FRegexMatcher Matcher(Trial, FString());
+		return Matcher.FindNext();
+	}
+}
+
+bool FOPM_RenameRuleSet::AddRule(const FRenameRule& Rule, FString* OutError)
+{
+	if (Rule.Find.IsEmpty())
+	{
+		if (OutError)
+		{
+			*OutError = TEXT("Rule has nothing to find");
+		}
+		return false;
+	}
+
+	const FString Source = Rule.Type == ERenameRuleType::Wildcard ?
+		OPMRenameRules::WildcardToRegex(Rule.Find) :
+		Rule.Find;
+
+	if (Rule.Type != ERenameRuleType::Literal && !OPMRenameRules::IsValidRegex(Source, Rule.bCaseSensitive))
+	{
+		if (OutError)
+		{
+			*OutError = FString::Printf(TEXT("Invalid pattern '%s'"), *Rule.Find);
+		}
+		return false;
+	}
+
+	FCompiledRule& Compiled = Rules.AddDefaulted_GetRef();
+	Compiled.Type = Rule.Type;
+	Compiled.SearchCase = Rule.bCaseSensitive ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase;
+	Compiled.Find = Rule.Find;
+
+	if (Rule.Type == ERenameRuleType::Literal)
+	{
+		Compiled.ReplaceText = Rule.Replace;
+		return true;
+	}
+
+	Compiled.Pattern.Emplace(Source, Rule.bCaseSensitive ? ERegexPatternFlags::None : ERegexPatternFlags::CaseInsensitive);
+
+	// Split the replacement into literal runs and $N group references, $$ is a literal $
+	Compiled.ReplaceText.Reserve(Rule.Replace.Len());
+	const int32 Len = Rule.Replace.Len();
+	for (int32 Pos = 0; Pos < Len; ++Pos)
+	{
+		const TCHAR Char = Rule.Replace[Pos];
+		const TCHAR Next = Pos + 1 < Len ? Rule.Replace[Pos + 1] : TEXT('\0');
+
+		if (Char == TEXT('$') && FChar::IsDigit(Next))
+		{
+			FReplacePart& Part = Compiled.ReplaceParts.AddDefaulted_GetRef();
+			Part.Group = Next - TEXT('0');
+			++Pos;
+			continue;
+		}
+
+		if (Char == TEXT('$') && Next == TEXT('$'))
+		{
+			++Pos;
+		}
+
+		if (Compiled.ReplaceParts.Num() == 0 || Compiled.ReplaceParts.Last().Group != INDEX_NONE)
+		{
+			FReplacePart& Part = Compiled.ReplaceParts.AddDefaulted_GetRef();
+			Part.LiteralStart = Compiled.ReplaceText.Len();
+		}
+		Compiled.ReplaceText.AppendChar(Char);
+		Compiled.ReplaceParts.Last().LiteralLen++;
+	}
+
+	return true;
+}
+
+bool FOPM_RenameRuleSet::Apply(const FString& Label, FString& OutLabel) const
+{
+	OutLabel = Label;
+
+	FString Scratch;
+	for (const FCompiledRule& Rule : Rules)
+	{
+		if (Rule.Type == ERenameRuleType::Literal)
+		{
+			OutLabel.ReplaceInline(*Rule.Find, *Rule.ReplaceText, Rule.SearchCase);
+			continue;
+		}
+
+		Scratch.Reset(OutLabel.Len());
+		ApplyPattern(Rule, OutLabel, Scratch);
+		Swap(OutLabel, Scratch);
+	}
+
+	return !OutLabel.Equals(Label, ESearchCase::CaseSensitive);
+}
+
+// Private helper methods
+
+void FOPM_RenameRuleSet::ApplyPattern(const FCompiledRule& Rule, const FString& Input, FString& Out)
+{
+	FRegexMatcher Matcher(Rule.Pattern.GetValue(), Input);
+
+	int32 Copied = 0;
+	while (Matcher.FindNext())
+	{
+		const int32 MatchBegin = Matcher.GetMatchBeginning();
+		const int32 MatchEnd = Matcher.GetMatchEnding();
+		Out.AppendChars(*Input + Copied, MatchBegin - Copied);
+
+		for (const FReplacePart& Part : Rule.ReplaceParts)
+		{
+			if (Part.Group == INDEX_NONE)
+			{
+				Out.AppendChars(*Rule.ReplaceText + Part.LiteralStart, Part.LiteralLen);
+				continue;
+			}
+
+			// Groups that did not take part in the match, or do not exist, report INDEX_NONE
+			const int32 GroupBegin = Matcher.GetCaptureGroupBeginning(Part.Group);
+			const int32 GroupEnd = Matcher.GetCaptureGroupEnding(Part.Group);
+			if (GroupBegin != INDEX_NONE && GroupEnd > GroupBegin)
+			{
+				Out.AppendChars(*Input + GroupBegin, GroupEnd - GroupBegin);
+			}
+		}
+
+		Copied = MatchEnd;
+	}
+
+	Out.AppendChars(*Input + Copied, Input.Len() - Copied);
+}
@@ -0,0 +1,281 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SplineEvaluationCache.h"
+#include "Components/SplineComponent.h"
+
+namespace OPMSplineCache
+{
+	TMap<TObjectKey<USplineComponent>, TUniquePtr<FOPM_SplineCache>> SplineCaches;
+
+	/** Target distance between table samples in world units */
+	constexpr float TargetStep = 25.0f;
+
+	constexpr int32 MinSamples = 16;
+	constexpr int32 MaxSamples = 1 << 16;
+}
+
+const FOPM_SplineCache* FOPM_SplineCache::Get(USplineComponent* SplineComponent)
+{
+	check(IsInGameThread());
+
+	if (!SplineComponent)
+	{
+		return nullptr;
+	}
+
+	// Drop caches of splines that have since been destroyed
+	for (auto It = OPMSplineCache::SplineCaches.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TUniquePtr<FOPM_SplineCache>& Cache = OPMSplineCache::SplineCaches.FindOrAdd(SplineComponent);
+	if (!Cache)
+	{
+		Cache = MakeUnique<FOPM_SplineCache>();
+		Cache->Build(SplineComponent);
+	}
+	else if (Cache->SplineVersion != SplineComponent->SplineCurves.Version ||
+		!Cache->ComponentTransform.Equals(SplineComponent->GetComponentTransform()))
+	{
+		Cache->Build(SplineComponent);
+	}
+
+	return Cache.Get();
+}
+
+void FOPM_SplineCache::ReleaseAll()
+{
+	OPMSplineCache::SplineCaches.Empty();
+}
+
+void FOPM_SplineCache::Build(USplineComponent* SplineComponent)
+{
+	Samples.Reset();
+	Length = 0.0f;
+	Step = 1.0f;
+
+	if (!SplineComponent)
+	{
+		return;
+	}
+
+	const FSplineCurves& Curves = SplineComponent->SplineCurves;
+	SplineVersion = Curves.Version;
+	ComponentTransform = SplineComponent->GetComponentTransform();
+	Length = SplineComponent->GetSplineLength();
+
+	const int32 NumIntervals = FMath::Clamp(
+		FMath::CeilToInt(Length / OPMSplineCache::TargetStep),
+		OPMSplineCache::MinSamples,
+		OPMSplineCache::MaxSamples);
+	Step = Length > 0.0f ? Length / NumIntervals : 1.0f;
+
+	Samples.SetNum(NumIntervals + 1);
+	for (int32 Index = 0; Index <= NumIntervals; ++Index)
+	{
+		FSample& Sample = Samples[Index];
+		const float Key = Curves.ReparamTable.Eval(Index * Step, 0.0f);
+
+		const FVector LocalLocation = Curves.Position.Eval(Key, FVector::ZeroVector);
+		const FVector FirstDerivative = ComponentTransform.TransformVector(Curves.Position.EvalDerivative(Key, FVector::ZeroVector));
+		const FVector SecondDerivative = ComponentTransform.TransformVector(Curves.Position.EvalSecondDerivative(Key, FVector::ZeroVector));
+
+		Sample.InputKey = Key;
+		Sample.Location = ComponentTransform.TransformPosition(LocalLocation);
+		Sample.Direction = FirstDerivative.GetSafeNormal();
+		Sample.Scale = Curves.Scale.Eval(Key, FVector::OneVector);
+
+		// Curvature of a parametric curve: |r' x r''| / |r'|^3
+		const double Speed = FirstDerivative.Size();
+		Sample.Curvature = Speed > KINDA_SMALL_NUMBER
+			? static_cast<float>(FVector::CrossProduct(FirstDerivative, SecondDerivative).Size() / (Speed * Speed * Speed))
+			: 0.0f;
+	}
+
+	// Degenerate spans inherit the previous direction so frames stay defined
+	for (int32 Index = 1; Index < Samples.Num(); ++Index)
+	{
+		if (Samples[Index].Direction.IsZero())
+		{
+			Samples[Index].Direction = Samples[Index - 1].Direction;
+		}
+	}
+
+	for (int32 Index = 0; Index < Samples.Num() - 1; ++Index)
+	{
+		Samples[Index].ChordLength = FVector::Dist(Samples[Index].Location, Samples[Index + 1].Location);
+	}
+
+	const FVector InitialUp = SplineComponent->GetUpVectorAtSplineInputKey(Samples[0].InputKey, ESplineCoordinateSpace::World);
+	ComputeRotationMinimizingFrames(InitialUp, SplineComponent->IsClosedLoop());
+}
+
+FVector FOPM_SplineCache::GetLocationAtDistance(float Distance) const
+{
+	if (Samples.Num() == 0)
+	{
+		return FVector::ZeroVector;
+	}
+
+	int32 Index;
+	float Alpha;
+	FindInterval(Distance, Index, Alpha);
+
+	const FSample& A = Samples[Index];
+	const FSample& B = Samples[Index + 1];
+
+	// Cubic Hermite between table samples, tangents are unit directions scaled to the world-space
+	// chord so scaled components interpolate along the curve
+	return FMath::CubicInterp(A.Location, A.Direction * A.ChordLength, B.Location, B.Direction * A.ChordLength, Alpha);
+}
+
+FVector FOPM_SplineCache::GetDirectionAtDistance(float Distance) const
+{
+	if (Samples.Num() == 0)
+	{
+		return FVector::ForwardVector;
+	}
+
+	int32 Index;
+	float Alpha;
+	FindInterval(Distance, Index, Alpha);
+	return FMath::Lerp(Samples[Index].Direction, Samples[Index + 1].Direction, Alpha).GetSafeNormal();
+}
+
+FVector FOPM_SplineCache::GetUpVectorAtDistance(float Distance) const
+{
+	if (Samples.Num() == 0)
+	{
+		return FVector::UpVector;
+	}
+
+	int32 Index;
+	float Alpha;
+	FindInterval(Distance, Index, Alpha);
+	return FMath::Lerp(Samples[Index].Up, Samples[Index + 1].Up, Alpha).GetSafeNormal();
+}
+
+FVector FOPM_SplineCache::GetScaleAtDistance(float Distance) const
+{
+	if (Samples.Num() == 0)
+	{
+		return FVector::OneVector;
+	}
+
+	int32 Index;
+	float Alpha;
+	FindInterval(Distance, Index, Alpha);
+	return FMath::Lerp(Samples[Index].Scale, Samples[Index + 1].Scale, Alpha);
+}
+
+float FOPM_SplineCache::GetCurvatureAtDistance(float Distance) const
+{
+	if (Samples.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	int32 Index;
+	float Alpha;
+	FindInterval(Distance, Index, Alpha);
+	return FMath::Lerp(Samples[Index].Curvature, Samples[Index + 1].Curvature, Alpha);
+}
+
+float FOPM_SplineCache::GetMaxCurvature(float StartDistance, float EndDistance) const
+{
+	if (Samples.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	const int32 First = FMath::Clamp(FMath::FloorToInt(FMath::Max(StartDistance, 0.0f) / Step), 0, Samples.Num() - 1);
+	const int32 Last = FMath::Clamp(FMath::CeilToInt(FMath::Min(EndDistance, Length) / Step), First, Samples.Num() - 1);
+
+	float MaxCurvature = 0.0f;
+	for (int32 Index = First; Index <= Last; ++Index)
+	{
+		MaxCurvature = FMath::Max(MaxCurvature, Samples[Index].Curvature);
+	}
+	return MaxCurvature;
+}
+
+float FOPM_SplineCache::GetInputKeyAtDistance(float Distance) const
+{
+	if (Samples.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	int32 Index;
+	float Alpha;
+	FindInterval(Distance, Index, Alpha);
+	return FMath::Lerp(Samples[Index].InputKey, Samples[Index + 1].InputKey, Alpha);
+}
+
+// Private helper methods
+
+void FOPM_SplineCache::FindInterval(float Distance, int32& OutIndex, float& OutAlpha) const
+{
+	const float Position = FMath::Clamp(Distance, 0.0f, Length) / Step;
+	OutIndex = FMath::Clamp(FMath::FloorToInt(Position), 0, Samples.Num() - 2);
+	OutAlpha = FMath::Clamp(Position - OutIndex, 0.0f, 1.0f);
+}
+
+void FOPM_SplineCache::ComputeRotationMinimizingFrames(const FVector& InitialUp, bool bClosedLoop)
+{
+	// Start from the spline's own up vector, made orthogonal to the first direction
+	const FVector FirstDirection = Samples[0].Direction;
+	FVector Up = (InitialUp - FirstDirection * FVector::DotProduct(InitialUp, FirstDirection)).GetSafeNormal();
+	if (Up.IsZero())
+	{
+		Up = FVector::CrossProduct(FirstDirection, FVector::RightVector).GetSafeNormal();
+	}
+	Samples[0].Up = Up;
+
+	// Double reflection method (Wang et al. 2008)
+	for (int32 Index = 0; Index < Samples.Num() - 1; ++Index)
+	{
+		const FSample& Current = Samples[Index];
+		FSample& Next = Samples[Index + 1];
+
+		const FVector V1 = Next.Location - Current.Location;
+		const double C1 = FVector::DotProduct(V1, V1);
+		if (C1 < KINDA_SMALL_NUMBER)
+		{
+			Next.Up = Current.Up;
+			continue;
+		}
+
+		const FVector ReflectedUp = Current.Up - (2.0 / C1) * FVector::DotProduct(V1, Current.Up) * V1;
+		const FVector ReflectedDirection = Current.Direction - (2.0 / C1) * FVector::DotProduct(V1, Current.Direction) * V1;
+
+		const FVector V2 = Next.Direction - ReflectedDirection;
+		const double C2 = FVector::DotProduct(V2, V2);
+		Next.Up = C2 < KINDA_SMALL_NUMBER
+			? ReflectedUp
+			: ReflectedUp - (2.0 / C2) * FVector::DotProduct(V2, ReflectedUp) * V2;
+		Next.Up.Normalize();
+	}
+
+	// Closed loops accumulate a holonomy twist, spread it evenly so the frame meets itself at the seam
+	if (bClosedLoop && Samples.Num() > 2)
+	{
+		const FSample& Last = Samples.Last();
+		const FVector StartUp = (Samples[0].Up - Last.Direction * FVector::DotProduct(Samples[0].Up, Last.Direction)).GetSafeNormal();
+		const double Twist = FMath::Atan2(
+			FVector::DotProduct(FVector::CrossProduct(Last.Up, StartUp), Last.Direction),
+			FVector::DotProduct(Last.Up, StartUp));
+
+		const int32 LastIndex = Samples.Num() - 1;
+		for (int32 Index = 1; Index <= LastIndex; ++Index)
+		{
+			FSample& Sample = Samples[Index];
+			const double Angle = Twist * Index / LastIndex;
+			Sample.Up = Sample.Up.RotateAngleAxisRad(Angle, Sample.Direction);
+		}
+	}
+}
@@ -0,0 +1,337 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SplineNetwork.h"
+#include "SplineUtilities.h"
+#include "SplineEvaluationCache.h"
+#include "Components/SplineComponent.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+
+namespace OPMSplineNetwork
+{
+	/** Chord length bounds when flattening splines, the chord tolerance decides within them */
+	const float MinChordLength = 25.0f;
+	const float MaxChordLength = 500.0f;
+
+	/** Chords per hierarchy leaf */
+	const int32 LeafSize = 4;
+
+	/** Chords queried per parallel task */
+	const int32 BatchSize = 256;
+
+	/** Intersections closer than this many tolerances are merged into one junction */
+	const float JunctionMergeFactor = 4.0f;
+
+	FBox GetChordBounds(const FVector& Start, const FVector& End)
+	{
+		FBox Bounds(ForceInit);
+		Bounds += Start;
+		Bounds += End;
+		return Bounds;
+	}
+}
+
+void FOPM_SplineNetwork::Build(TArrayView<USplineComponent* const> InSplines, float InTolerance)
+{
+	Splines.Reset();
+	Splines.Append(InSplines.GetData(), InSplines.Num());
+	Tolerance = FMath::Max(InTolerance, KINDA_SMALL_NUMBER);
+	Chords.Reset();
+	Nodes.Reset();
+	Intersections.Reset();
+	Junctions.Reset();
+	JunctionDistances.Reset();
+	JunctionDistances.SetNum(Splines.Num());
+
+	// Flatten each spline so its polyline stays within half the tolerance of the curve
+	for (int32 SplineIndex = 0; SplineIndex < Splines.Num(); ++SplineIndex)
+	{
+		const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(Splines[SplineIndex]);
+		if (!Cache)
+		{
+			continue;
+		}
+
+		const TArray<float> Distances = UOPM_SplineUtilities::GetAdaptiveDistances(
+			Splines[SplineIndex], OPMSplineNetwork::MinChordLength, OPMSplineNetwork::MaxChordLength, Tolerance * 0.5f);
+
+		FVector Previous = Distances.Num() > 0 ? Cache->GetLocationAtDistance(Distances[0]) : FVector::ZeroVector;
+		for (int32 Index = 1; Index < Distances.Num(); ++Index)
+		{
+			const FVector Current = Cache->GetLocationAtDistance(Distances[Index]);
+
+			FChord& Chord = Chords.AddDefaulted_GetRef();
+			Chord.Start = Previous;
+			Chord.End = Current;
+			Chord.StartDistance = Distances[Index - 1];
+			Chord.EndDistance = Distances[Index];
+			Chord.Spline = SplineIndex;
+
+			Previous = Current;
+		}
+	}
+
+	if (Chords.Num() == 0)
+	{
+		return;
+	}
+
+	Nodes.Reserve(2 * FMath::DivideAndRoundUp(Chords.Num(), OPMSplineNetwork::LeafSize));
+	BuildNode(0, Chords.Num());
+
+	FindIntersections();
+	MergeJunctions();
+}
+
+bool FOPM_SplineNetwork::IsInJunctionZone(int32 SplineIndex, float Distance, float Clearance) const
+{
+	if (!JunctionDistances.IsValidIndex(SplineIndex))
+	{
+		return false;
+	}
+
+	const TArray<float>& Distances = JunctionDistances[SplineIndex];
+	const int32 Index = Algo::LowerBound(Distances, Distance - Clearance);
+	return Distances.IsValidIndex(Index) && Distances[Index] <= Distance + Clearance;
+}
+
+void FOPM_SplineNetwork::RemoveJunctionDistances(int32 SplineIndex, TArray<float>& Distances, float Clearance) const
+{
+	Distances.RemoveAll([this, SplineIndex, Clearance](float Distance)
+	{
+		return IsInJunctionZone(SplineIndex, Distance, Clearance);
+	});
+}
+
+// Private helper methods
+
+int32 FOPM_SplineNetwork::BuildNode(int32 First, int32 Count)
+{
+	const int32 NodeIndex = Nodes.AddDefaulted();
+
+	FBox Bounds(ForceInit);
+	FBox Centers(ForceInit);
+	for (int32 Index = First; Index < First + Count; ++Index)
+	{
+		Bounds += Chords[Index].Start;
+		Bounds += Chords[Index].End;
+		Centers += (Chords[Index].Start + Chords[Index].End) * 0.5f;
+	}
+
+	// Padding the nodes lets queries use the exact chord bounds
+	Nodes[NodeIndex].Bounds = Bounds.ExpandBy(Tolerance);
+
+	if (Count <= OPMSplineNetwork::LeafSize)
+	{
+		Nodes[NodeIndex].FirstChord = First;
+		Nodes[NodeIndex].ChordCount = Count;
+		return NodeIndex;
+	}
+
+	// Median split along the widest axis of the chord centers keeps the tree balanced
+	const FVector Extent = Centers.GetSize();
+	const int32 Axis = Extent.X >= Extent.Y && Extent.X >= Extent.Z ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+	const int32 Half = Count / 2;
+
+	Algo::Sort(MakeArrayView(Chords.GetData() + First, Count), [Axis](const FChord& A, const FChord& B)
+	{
+		return A.Start[Axis] + A.End[Axis] < B.Start[Axis] + B.End[Axis];
+	});
+
+	// The first child always directly follows its parent
+	BuildNode(First, Half);
+	const int32 SecondChild = BuildNode(First + Half, Count - Half);
+	Nodes[NodeIndex].SecondChild = SecondChild;
+
+	return NodeIndex;
+}
+
+void FOPM_SplineNetwork::QueryChords(const FBox& Box, TArray<int32>& OutChords) const
+{
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(0);
+
+	while (Stack.Num() > 0)
+	{
+		const int32 NodeIndex = Stack.Pop(false);
+		const FNode& Node = Nodes[NodeIndex];
+		if (!Node.Bounds.Intersect(Box))
+		{
+			continue;
+		}
+
+		if (Node.SecondChild == INDEX_NONE)
+		{
+			for (int32 Index = Node.FirstChord; Index < Node.FirstChord + Node.ChordCount; ++Index)
+			{
+				OutChords.Add(Index);
+			}
+		}
+		else
+		{
+			Stack.Add(NodeIndex + 1);
+			Stack.Add(Node.SecondChild);
+		}
+	}
+}
+
+void FOPM_SplineNetwork::FindIntersections()
+{
+	const int32 NumBatches = FMath::DivideAndRoundUp(Chords.Num(), OPMSplineNetwork::BatchSize);
+	TArray<TArray<FOPM_SplineIntersection>> BatchIntersections;
+	BatchIntersections.SetNum(NumBatches);
+
+	const float ToleranceSquared = Tolerance * Tolerance;
+
+	ParallelFor(NumBatches, [&](int32 Batch)
+	{
+		const int32 First = Batch * OPMSplineNetwork::BatchSize;
+		const int32 Last = FMath::Min(First + OPMSplineNetwork::BatchSize, Chords.Num());
+
+		TArray<int32> Candidates;
+		for (int32 ChordIndex = First; ChordIndex < Last; ++ChordIndex)
+		{
+			const FChord& A = Chords[ChordIndex];
+
+			Candidates.Reset();
+			QueryChords(OPMSplineNetwork::GetChordBounds(A.Start, A.End), Candidates);
+
+			for (int32 OtherIndex : Candidates)
+			{
+				// Each pair is tested once, from its lower chord index
+				const FChord& B = Chords[OtherIndex];
+				if (OtherIndex <= ChordIndex || B.Spline == A.Spline)
+				{
+					continue;
+				}
+
+				FVector PointA;
+				FVector PointB;
+				FMath::SegmentDistToSegmentSafe(A.Start, A.End, B.Start, B.End, PointA, PointB);
+				if (FVector::DistSquared(PointA, PointB) > ToleranceSquared)
+				{
+					continue;
+				}
+
+				auto GetDistance = [](const FChord& Chord, const FVector& Point)
+				{
+					const float ChordLength = FVector::Dist(Chord.Start, Chord.End);
+					const float Alpha = ChordLength > KINDA_SMALL_NUMBER ? FVector::Dist(Chord.Start, Point) / ChordLength : 0.0f;
+					return FMath::Lerp(Chord.StartDistance, Chord.EndDistance, Alpha);
+				};
+
+				const bool bSwap = B.Spline < A.Spline;
+				FOPM_SplineIntersection& Intersection = BatchIntersections[Batch].AddDefaulted_GetRef();
+				Intersection.SplineA = bSwap ? B.Spline : A.Spline;
+				Intersection.SplineB = bSwap ? A.Spline : B.Spline;
+				Intersection.DistanceA = bSwap ? GetDistance(B, PointB) : GetDistance(A, PointA);
+				Intersection.DistanceB = bSwap ? GetDistance(A, PointA) : GetDistance(B, PointB);
+				Intersection.Location = (PointA + PointB) * 0.5f;
+			}
+		}
+	}, NumBatches <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	TArray<FOPM_SplineIntersection> Found;
+	for (TArray<FOPM_SplineIntersection>& Batch : BatchIntersections)
+	{
+		Found.Append(MoveTemp(Batch));
+	}
+
+	// A crossing near a polyline vertex is reported by both chords on either side, keep one
+	Found.Sort([](const FOPM_SplineIntersection& A, const FOPM_SplineIntersection& B)
+	{
+		if (A.SplineA != B.SplineA)
+		{
+			return A.SplineA < B.SplineA;
+		}
+		if (A.SplineB != B.SplineB)
+		{
+			return A.SplineB < B.SplineB;
+		}
+		return A.DistanceA < B.DistanceA;
+	});
+
+	for (const FOPM_SplineIntersection& Intersection : Found)
+	{
+		if (Intersections.Num() > 0)
+		{
+			const FOPM_SplineIntersection& Last = Intersections.Last();
+			if (Last.SplineA == Intersection.SplineA &&
+				Last.SplineB == Intersection.SplineB &&
+				Intersection.DistanceA - Last.DistanceA <= Tolerance * 2.0f)
+			{
+				continue;
+			}
+		}
+
+		Intersections.Add(Intersection);
+	}
+}
+
+void FOPM_SplineNetwork::MergeJunctions()
+{
+	// Bucket junctions on a grid as large as the merge distance so only neighbouring cells are searched
+	const float MergeDistance = Tolerance * OPMSplineNetwork::JunctionMergeFactor;
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	auto GetCell = [MergeDistance](const FVector& Location)
+	{
+		return FIntVector(
+			FMath::FloorToInt(Location.X / MergeDistance),
+			FMath::FloorToInt(Location.Y / MergeDistance),
+			FMath::FloorToInt(Location.Z / MergeDistance));
+	};
+
+	for (int32 IntersectionIndex = 0; IntersectionIndex < Intersections.Num(); ++IntersectionIndex)
+	{
+		const FOPM_SplineIntersection& Intersection = Intersections[IntersectionIndex];
+		const FIntVector Cell = GetCell(Intersection.Location);
+
+		int32 JunctionIndex = INDEX_NONE;
+		for (int32 X = -1; X <= 1 && JunctionIndex == INDEX_NONE; ++X)
+		{
+			for (int32 Y = -1; Y <= 1 && JunctionIndex == INDEX_NONE; ++Y)
+			{
+				for (int32 Z = -1; Z <= 1 && JunctionIndex == INDEX_NONE; ++Z)
+				{
+					if (const TArray<int32>* Candidates = Cells.Find(Cell + FIntVector(X, Y, Z)))
+					{
+						for (int32 Candidate : *Candidates)
+						{
+							if (FVector::Dist(Junctions[Candidate].Location, Intersection.Location) <= MergeDistance)
+							{
+								JunctionIndex = Candidate;
+								break;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		if (JunctionIndex == INDEX_NONE)
+		{
+			JunctionIndex = Junctions.AddDefaulted();
+			Junctions[JunctionIndex].Location = Intersection.Location;
+			Cells.FindOrAdd(Cell).Add(JunctionIndex);
+		}
+
+		FOPM_SplineJunction& Junction = Junctions[JunctionIndex];
+		Junction.Intersections.Add(IntersectionIndex);
+		Junction.Splines.AddUnique(Intersection.SplineA);
+		Junction.Splines.AddUnique(Intersection.SplineB);
+
+		// Keep the junction centred on all of its intersections
+		const int32 NumMerged = Junction.Intersections.Num();
+		Junction.Location += (Intersection.Location - Junction.Location) / NumMerged;
+
+		JunctionDistances[Intersection.SplineA].Add(Intersection.DistanceA);
+		JunctionDistances[Intersection.SplineB].Add(Intersection.DistanceB);
+	}
+
+	for (TArray<float>& Distances : JunctionDistances)
+	{
+		Distances.Sort();
+	}
+}
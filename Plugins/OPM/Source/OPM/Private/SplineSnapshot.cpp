@@ -0,0 +1,247 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SplineSnapshot.h"
+#include "SplineEvaluationCache.h"
+#include "Components/SplineComponent.h"
+#include "Async/ParallelFor.h"
+
+namespace OPMSplineSnapshot
+{
+	/** Distances evaluated per parallel task */
+	const int32 BatchSize = 256;
+
+	/** Distances evaluated together in one vector register */
+	const int32 NumLanes = 4;
+
+	/** Helper to load one value per lane, Offset 1 reads the sample ending each lane's interval */
+	FORCEINLINE VectorRegister4Float Gather(const TArray<float>& Values, const int32* Intervals, int32 Offset = 0)
+	{
+		return MakeVectorRegisterFloat(
+			Values[Intervals[0] + Offset],
+			Values[Intervals[1] + Offset],
+			Values[Intervals[2] + Offset],
+			Values[Intervals[3] + Offset]);
+	}
+
+	/** Helper to interpolate table samples linearly across each lane's interval */
+	FORCEINLINE VectorRegister4Float Lerp(const TArray<float>& Values, const int32* Intervals, const VectorRegister4Float& Alpha)
+	{
+		const VectorRegister4Float From = Gather(Values, Intervals);
+		return VectorMultiplyAdd(VectorSubtract(Gather(Values, Intervals, 1), From), Alpha, From);
+	}
+
+	/** Helper to evaluate each lane's offset polynomial with Horner's rule */
+	FORCEINLINE VectorRegister4Float Horner(const TArray<float>& A, const TArray<float>& B, const TArray<float>& C, const int32* Intervals, const VectorRegister4Float& T)
+	{
+		const VectorRegister4Float Inner = VectorMultiplyAdd(Gather(A, Intervals), T, Gather(B, Intervals));
+		return VectorMultiply(VectorMultiplyAdd(Inner, T, Gather(C, Intervals)), T);
+	}
+
+	/** Helper to normalize four vectors held one axis per register, near-zero vectors become zero as with GetSafeNormal */
+	FORCEINLINE void Normalize(VectorRegister4Float& X, VectorRegister4Float& Y, VectorRegister4Float& Z)
+	{
+		const VectorRegister4Float SizeSquared = VectorMultiplyAdd(X, X, VectorMultiplyAdd(Y, Y, VectorMultiply(Z, Z)));
+		const VectorRegister4Float Tiny = VectorSetFloat1(SMALL_NUMBER);
+		const VectorRegister4Float InvSize = VectorSelect(
+			VectorCompareGT(SizeSquared, Tiny),
+			VectorReciprocalSqrt(VectorMax(SizeSquared, Tiny)),
+			VectorZeroFloat());
+
+		X = VectorMultiply(X, InvSize);
+		Y = VectorMultiply(Y, InvSize);
+		Z = VectorMultiply(Z, InvSize);
+	}
+
+	/** Lanes of three registers stored back to memory for the per-sample writes */
+	struct FLaneVectors
+	{
+		float X[NumLanes];
+		float Y[NumLanes];
+		float Z[NumLanes];
+
+		void Store(const VectorRegister4Float& InX, const VectorRegister4Float& InY, const VectorRegister4Float& InZ)
+		{
+			VectorStore(InX, X);
+			VectorStore(InY, Y);
+			VectorStore(InZ, Z);
+		}
+
+		FVector Get(int32 Lane) const
+		{
+			return FVector(X[Lane], Y[Lane], Z[Lane]);
+		}
+	};
+}
+
+bool FOPM_SplineSnapshot::Capture(USplineComponent* SplineComponent)
+{
+	check(IsInGameThread());
+
+	NumIntervals = 0;
+
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache || Cache->Samples.Num() < 2)
+	{
+		return false;
+	}
+
+	const TArray<FOPM_SplineCache::FSample>& Samples = Cache->Samples;
+	const int32 NumSamples = Samples.Num();
+
+	Length = Cache->Length;
+	Step = Cache->Step;
+
+	Directions.SetNumUninitialized(NumSamples);
+	UpVectors.SetNumUninitialized(NumSamples);
+	Scales.SetNumUninitialized(NumSamples);
+	Curvatures.SetNumUninitialized(NumSamples);
+
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		Directions.Set(Index, Samples[Index].Direction);
+		UpVectors.Set(Index, Samples[Index].Up);
+		Scales.Set(Index, Samples[Index].Scale);
+		Curvatures[Index] = Samples[Index].Curvature;
+	}
+
+	// Expand each Hermite span of the cache, tangents scaled to the interval's world chord, into
+	// polynomial coefficients relative to its start so the offsets stay small enough for floats
+	const int32 NumSpans = NumSamples - 1;
+	Origins.SetNumUninitialized(NumSpans);
+	PositionA.SetNumUninitialized(NumSpans);
+	PositionB.SetNumUninitialized(NumSpans);
+	PositionC.SetNumUninitialized(NumSpans);
+
+	for (int32 Index = 0; Index < NumSpans; ++Index)
+	{
+		const FOPM_SplineCache::FSample& From = Samples[Index];
+		const FOPM_SplineCache::FSample& To = Samples[Index + 1];
+
+		const FVector Delta = To.Location - From.Location;
+		const FVector LeaveTangent = From.Direction * From.ChordLength;
+		const FVector ArriveTangent = To.Direction * From.ChordLength;
+
+		Origins[Index] = From.Location;
+		PositionA.Set(Index, LeaveTangent - 2.0 * Delta + ArriveTangent);
+		PositionB.Set(Index, 3.0 * Delta - 2.0 * LeaveTangent - ArriveTangent);
+		PositionC.Set(Index, LeaveTangent);
+	}
+
+	NumIntervals = NumSpans;
+	return true;
+}
+
+void FOPM_SplineSamples::SetNumUninitialized(int32 Num)
+{
+	Locations.SetNumUninitialized(Num);
+	Directions.SetNumUninitialized(Num);
+	UpVectors.SetNumUninitialized(Num);
+	Scales.SetNumUninitialized(Num);
+	Curvatures.SetNumUninitialized(Num);
+}
+
+void FOPM_SplineSnapshot::Evaluate(TArrayView<const float> Distances, FOPM_SplineSamples& OutSamples) const
+{
+	const int32 NumDistances = Distances.Num();
+	OutSamples.SetNumUninitialized(NumDistances);
+
+	if (!IsValid())
+	{
+		for (int32 Index = 0; Index < NumDistances; ++Index)
+		{
+			OutSamples.Locations[Index] = FVector::ZeroVector;
+			OutSamples.Directions[Index] = FVector::ForwardVector;
+			OutSamples.UpVectors[Index] = FVector::UpVector;
+			OutSamples.Scales[Index] = FVector::OneVector;
+			OutSamples.Curvatures[Index] = 0.0f;
+		}
+		return;
+	}
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumDistances, OPMSplineSnapshot::BatchSize);
+	ParallelFor(NumBatches, [&](int32 Batch)
+	{
+		const int32 Start = Batch * OPMSplineSnapshot::BatchSize;
+		const int32 End = FMath::Min(Start + OPMSplineSnapshot::BatchSize, NumDistances);
+		EvaluateRange(Distances, Start, End, OutSamples);
+	}, NumBatches <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void FOPM_SplineSnapshot::EvaluateRange(TArrayView<const float> Distances, int32 Start, int32 End, FOPM_SplineSamples& OutSamples) const
+{
+	using namespace OPMSplineSnapshot;
+
+	for (int32 First = Start; First < End; First += NumLanes)
+	{
+		const int32 UsedLanes = FMath::Min(NumLanes, End - First);
+
+		// Locate each lane's interval, spare lanes repeat the last distance and are not written
+		int32 Intervals[NumLanes];
+		float Alphas[NumLanes];
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			const float Position = FMath::Clamp(Distances[First + FMath::Min(Lane, UsedLanes - 1)], 0.0f, Length) / Step;
+			Intervals[Lane] = FMath::Clamp(FMath::FloorToInt(Position), 0, NumIntervals - 1);
+			Alphas[Lane] = FMath::Clamp(Position - Intervals[Lane], 0.0f, 1.0f);
+		}
+
+		const VectorRegister4Float T = VectorLoad(Alphas);
+
+		FLaneVectors Offsets;
+		Offsets.Store(
+			Horner(PositionA.X, PositionB.X, PositionC.X, Intervals, T),
+			Horner(PositionA.Y, PositionB.Y, PositionC.Y, Intervals, T),
+			Horner(PositionA.Z, PositionB.Z, PositionC.Z, Intervals, T));
+
+		VectorRegister4Float DirectionX = Lerp(Directions.X, Intervals, T);
+		VectorRegister4Float DirectionY = Lerp(Directions.Y, Intervals, T);
+		VectorRegister4Float DirectionZ = Lerp(Directions.Z, Intervals, T);
+		Normalize(DirectionX, DirectionY, DirectionZ);
+
+		FLaneVectors LaneDirections;
+		LaneDirections.Store(DirectionX, DirectionY, DirectionZ);
+
+		VectorRegister4Float UpX = Lerp(UpVectors.X, Intervals, T);
+		VectorRegister4Float UpY = Lerp(UpVectors.Y, Intervals, T);
+		VectorRegister4Float UpZ = Lerp(UpVectors.Z, Intervals, T);
+		Normalize(UpX, UpY, UpZ);
+
+		FLaneVectors LaneUpVectors;
+		LaneUpVectors.Store(UpX, UpY, UpZ);
+
+		FLaneVectors LaneScales;
+		LaneScales.Store(
+			Lerp(Scales.X, Intervals, T),
+			Lerp(Scales.Y, Intervals, T),
+			Lerp(Scales.Z, Intervals, T));
+
+		float LaneCurvatures[NumLanes];
+		VectorStore(Lerp(Curvatures, Intervals, T), LaneCurvatures);
+
+		for (int32 Lane = 0; Lane < UsedLanes; ++Lane)
+		{
+			const int32 OutIndex = First + Lane;
+			OutSamples.Locations[OutIndex] = Origins[Intervals[Lane]] + Offsets.Get(Lane);
+			OutSamples.Directions[OutIndex] = LaneDirections.Get(Lane);
+			OutSamples.UpVectors[OutIndex] = LaneUpVectors.Get(Lane);
+			OutSamples.Scales[OutIndex] = LaneScales.Get(Lane);
+			OutSamples.Curvatures[OutIndex] = LaneCurvatures[Lane];
+		}
+	}
+}
+
+// Private helper methods
+
+void FOPM_SplineSnapshot::FAxisArrays::SetNumUninitialized(int32 Num)
+{
+	X.SetNumUninitialized(Num);
+	Y.SetNumUninitialized(Num);
+	Z.SetNumUninitialized(Num);
+}
+
+void FOPM_SplineSnapshot::FAxisArrays::Set(int32 Index, const FVector& Value)
+{
+	X[Index] = static_cast<float>(Value.X);
+	Y[Index] = static_cast<float>(Value.Y);
+	Z[Index] = static_cast<float>(Value.Z);
+}
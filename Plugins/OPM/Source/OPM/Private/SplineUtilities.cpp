@@ -1,30 +1,113 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SplineUtilities.h"
+#include "SplineEvaluationCache.h"
+#include "SplineSnapshot.h"
+#include "CatenarySolver.h"
+#include "SplineWatchSubsystem.h"
+#include "SplineNetwork.h"
+#include "LandscapeIntegrationUtilities.h"
+#include "LandscapeHeightSnapshot.h"
 #include "Engine/World.h"
 #include "Components/SplineComponent.h"
 #include "GameFramework/Actor.h"
 #include "DrawDebugHelpers.h"
+#include "Async/ParallelFor.h"
+#include "Components/SplineMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+
+namespace OPMSplineUtilities
+{
+	/** Placement counts at which transforms are evaluated from a vectorized snapshot, beyond one batch also on worker threads */
+	const int32 SnapshotEvaluationThreshold = 256;
+
+	/** Component tag of segments built by PlaceSplineMeshesAlongSpline */
+	const FName SplineMeshTag(TEXT("OPM_SplineMesh"));
+
+	/** Component tags of the parts built by the composite generators */
+	const FName RoadSurfaceTag(TEXT("OPM_RoadSurface"));
+	const FName RoadPropTag(TEXT("OPM_RoadProp"));
+	const FName FencePostTag(TEXT("OPM_FencePost"));
+	const FName FencePanelTag(TEXT("OPM_FencePanel"));
+	const FName CableSupportTag(TEXT("OPM_CableSupport"));
+	const FName CableTag(TEXT("OPM_Cable"));
+
+	/** Spline mesh pieces per cable span */
+	const int32 CableSubdivisions = 16;
+
+	/** Stretched actors per cable span when routing cables with actor classes */
+	const int32 CableActorPieces = 8;
+
+	/** Length along X assumed for stretched actors without any bounds */
+	const float DefaultStretchLength = 100.0f;
+
+	/** Side offset of road props, matching GenerateRoadAlongSpline */
+	const float RoadPropOffset = 300.0f;
+
+	/** Component tag of instances built by PlaceInstancesAlongSplines */
+	const FName SplineInstanceTag(TEXT("OPM_SplineInstance"));
+
+	/** Distances per parallel task when evaluating several splines in one job */
+	const int32 MultiSplineBlockSize = 256;
+
+	/** Height above and below a sample covered by terrain traces */
+	const float TerrainTraceExtent = 10000.0f;
+
+	/** Border added around the spline when capturing landscape heights */
+	const float TerrainSnapshotMargin = 500.0f;
+
+	/** Samples per axis of each landscape height tile captured along the spline */
+	const int32 TerrainSnapshotResolution = 2048;
+
+	/** Samples per original segment when checking a simplified spline */
+	const int32 SimplifySamplesPerSegment = 8;
+
+	/** Passes restoring points where a simplified spline strays from the original */
+	const int32 SimplifyRefinePasses = 16;
+
+	/** Distance queries timed when reporting evaluation cost */
+	const int32 EvaluationTimingQueries = 1000;
+}
 
 TArray<AActor*> UOPM_SplineUtilities::PlaceActorsAlongSpline(
 	UClass* ActorClass,
 	USplineComponent* SplineComponent,
 	const FSplinePlacementSettings& Settings,
-	UWorld* World)
+	UWorld* World,
+	bool bWatchSpline)
 {
 	TArray<AActor*> SpawnedActors;
 
-	if (!ActorClass || !SplineComponent || !World)
+	if (!SplineComponent || !World)
+	{
+		return SpawnedActors;
+	}
+
+	if (Settings.OutputMode == ESplineOutputMode::SplineMeshes)
+	{
+		if (AActor* Host = PlaceSplineMeshesAlongSpline(Settings.SegmentMesh, SplineComponent, Settings, World))
+		{
+			SpawnedActors.Add(Host);
+		}
+		return SpawnedActors;
+	}
+
+	if (!ActorClass)
 	{
 		return SpawnedActors;
 	}
 
 	// Generate transforms along spline
-	TArray<FTransform> Transforms = GenerateTransformsAlongSpline(SplineComponent, Settings);
+	TArray<float> Distances = GetPlacementDistances(SplineComponent, Settings);
+	TArray<FTransform> Transforms = GenerateTransformsAtDistances(SplineComponent, Distances, Settings);
+	TArray<float> SpawnedDistances;
 
 	// Spawn actors at each transform
-	for (const FTransform& Transform : Transforms)
+	for (int32 Index = 0; Index < Transforms.Num(); ++Index)
 	{
+		const FTransform& Transform = Transforms[Index];
+
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
@@ -39,25 +122,82 @@ TArray<AActor*> UOPM_SplineUtilities::PlaceActorsAlongSpline(
 		{
 			SpawnedActor->SetActorScale3D(Transform.GetScale3D());
 			SpawnedActors.Add(SpawnedActor);
+			SpawnedDistances.Add(Distances[Index]);
 		}
 	}
 
+	// Regenerate the affected segments when the spline is edited later. Generators placing several
+	// parts along one spline leave this off, re-placing one part alone would strand the others
+	UOPM_SplineWatchSubsystem* WatchSubsystem = bWatchSpline ? UOPM_SplineWatchSubsystem::Get() : nullptr;
+	if (WatchSubsystem)
+	{
+		WatchSubsystem->WatchPlacement(SplineComponent, ActorClass, Settings, SpawnedActors, SpawnedDistances);
+	}
+
 	return SpawnedActors;
 }
 
+AActor* UOPM_SplineUtilities::PlaceSplineMeshesAlongSpline(
+	UStaticMesh* Mesh,
+	USplineComponent* SplineComponent,
+	const FSplinePlacementSettings& Settings,
+	UWorld* World,
+	AActor* TargetActor)
+{
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Mesh || !Cache || !World)
+	{
+		return nullptr;
+	}
+
+	const float SplineLength = Cache->GetLength();
+	const float StartDistance = FMath::Clamp(Settings.StartOffset, 0.0f, SplineLength);
+	const float EndDistance = FMath::Clamp(SplineLength - Settings.EndOffset, StartDistance, SplineLength);
+	if (EndDistance - StartDistance <= KINDA_SMALL_NUMBER)
+	{
+		return nullptr;
+	}
+
+	const float NominalLength = Settings.Spacing > 0.0f ? Settings.Spacing : Mesh->GetBounds().BoxExtent.X * 2.0f;
+	const TArray<float> Breaks = GetFittedBreaks(StartDistance, EndDistance, NominalLength);
+
+	AActor* Host = TargetActor;
+	if (!Host)
+	{
+		Host = SpawnComponentHost(World, Cache->GetLocationAtDistance(StartDistance), Mesh->GetName() + TEXT("_Spline"));
+	}
+
+	if (!Host || !Host->GetRootComponent())
+	{
+		return nullptr;
+	}
+
+	TArray<FSplineMeshSpan> Spans;
+	MakeSplineMeshSpans(*Cache, Breaks, Settings, Spans);
+	BuildSplineMeshSegments(Host, Mesh, Spans, OPMSplineUtilities::SplineMeshTag);
+	return Host;
+}
+
 TArray<FTransform> UOPM_SplineUtilities::GenerateTransformsAlongSpline(
 	USplineComponent* SplineComponent,
 	const FSplinePlacementSettings& Settings)
 {
-	TArray<FTransform> Transforms;
+	return GenerateTransformsAtDistances(SplineComponent, GetPlacementDistances(SplineComponent, Settings), Settings);
+}
 
-	if (!SplineComponent)
+TArray<float> UOPM_SplineUtilities::GetPlacementDistances(
+	USplineComponent* SplineComponent,
+	const FSplinePlacementSettings& Settings)
+{
+	TArray<float> Distances;
+
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache)
 	{
-		return Transforms;
+		return Distances;
 	}
 
-	float SplineLength = GetSplineLength(SplineComponent);
-	TArray<float> Distances;
+	float SplineLength = Cache->GetLength();
 
 	// Get distances based on placement mode
 	switch (Settings.PlacementMode)
@@ -72,17 +212,53 @@ TArray<FTransform> UOPM_SplineUtilities::GenerateTransformsAlongSpline(
 			Distances = GetSplinePointDistances(SplineComponent);
 			break;
 		case ESplinePlacementMode::Adaptive:
-			Distances = GetAdaptiveDistances(SplineComponent, Settings.Spacing * 0.5f, Settings.Spacing * 2.0f);
+			Distances = GetAdaptiveDistances(SplineComponent, Settings.Spacing * 0.5f, Settings.Spacing * 2.0f, Settings.ChordTolerance);
 			break;
 		default:
 			Distances = GetUniformDistances(SplineLength, Settings.Spacing, Settings.StartOffset, Settings.EndOffset);
 			break;
 	}
 
+	return Distances;
+}
+
+TArray<FTransform> UOPM_SplineUtilities::GenerateTransformsAtDistances(
+	USplineComponent* SplineComponent,
+	const TArray<float>& Distances,
+	const FSplinePlacementSettings& Settings)
+{
+	TArray<FTransform> Transforms;
+
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache)
+	{
+		return Transforms;
+	}
+
+	// Many placements are evaluated four at a time from a flattened copy of the cache table, matching the path below to float precision
+	if (Distances.Num() >= OPMSplineUtilities::SnapshotEvaluationThreshold)
+	{
+		FOPM_SplineSnapshot Snapshot;
+		if (Snapshot.Capture(SplineComponent))
+		{
+			FOPM_SplineSamples Samples;
+			Snapshot.Evaluate(Distances, Samples);
+
+			Transforms.SetNum(Distances.Num());
+			ParallelFor(Distances.Num(), [&](int32 Index)
+			{
+				Transforms[Index] = MakeSampledTransform(Samples, Index, Settings);
+			});
+
+			return Transforms;
+		}
+	}
+
 	// Generate transforms at each distance
+	Transforms.Reserve(Distances.Num());
 	for (float Distance : Distances)
 	{
-		FTransform Transform = GetTransformAtDistance(SplineComponent, Distance, Settings.Alignment);
+		FTransform Transform = GetCachedTransform(*Cache, Distance, Settings.Alignment);
 		
 		// Apply offset
 		Transform = ApplyOffsetToTransform(Transform, Settings.Offset);
@@ -90,9 +266,7 @@ TArray<FTransform> UOPM_SplineUtilities::GenerateTransformsAlongSpline(
 		// Apply scale
 		if (Settings.bScaleBySpline)
 		{
-			float Alpha = Distance / FMath::Max(SplineLength, 1.0f);
-			FVector Scale = SplineComponent->GetScaleAtDistanceAlongSpline(Distance);
-			Transform.SetScale3D(Scale);
+			Transform.SetScale3D(Cache->GetScaleAtDistance(Distance));
 		}
 
 		Transforms.Add(Transform);
@@ -167,42 +341,36 @@ TArray<AActor*> UOPM_SplineUtilities::GenerateFenceAlongSpline(
 {
 	TArray<AActor*> FenceActors;
 
-	if (!SplineComponent || !PostActorClass || !World)
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache || !PostActorClass || !World || PostSpacing <= 0.0f)
 	{
 		return FenceActors;
 	}
 
-	// Place fence posts
-	FSplinePlacementSettings PostSettings;
-	PostSettings.PlacementMode = ESplinePlacementMode::Uniform;
-	PostSettings.Spacing = PostSpacing;
-	PostSettings.Alignment = ESplineAlignment::Tangent;
+	// Posts land on both spline ends, as GenerateFenceComposite places them
+	const TArray<float> PostDistances = GetFittedBreaks(0.0f, Cache->GetLength(), PostSpacing);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-	TArray<AActor*> Posts = PlaceActorsAlongSpline(PostActorClass, SplineComponent, PostSettings, World);
+	TArray<AActor*> Posts;
+	Posts.Reserve(PostDistances.Num());
+	for (float Distance : PostDistances)
+	{
+		if (AActor* Post = World->SpawnActor<AActor>(PostActorClass, GetCachedTransform(*Cache, Distance, ESplineAlignment::Tangent), SpawnParams))
+		{
+			Posts.Add(Post);
+		}
+	}
 	FenceActors.Append(Posts);
 
-	// Place fence panels between posts if provided
+	// Panels are stretched by their own measured length to fill each gap between posts
 	if (PanelActorClass && Posts.Num() > 1)
 	{
 		for (int32 i = 0; i < Posts.Num() - 1; ++i)
 		{
-			FVector Start = Posts[i]->GetActorLocation();
-			FVector End = Posts[i + 1]->GetActorLocation();
-			FVector MidPoint = (Start + End) * 0.5f;
-			FRotator Rotation = (End - Start).Rotation();
-
-			FActorSpawnParameters SpawnParams;
-			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-			AActor* Panel = World->SpawnActor<AActor>(PanelActorClass, MidPoint, Rotation, SpawnParams);
-			if (Panel)
+			if (AActor* Panel = SpawnStretchedActor(World, PanelActorClass, Posts[i]->GetActorLocation(), Posts[i + 1]->GetActorLocation()))
 			{
-				// Scale panel to fit between posts
-				float Distance = FVector::Dist(Start, End);
-				FVector Scale = Panel->GetActorScale3D();
-				Scale.X = Distance / 100.0f; // Assume default panel is 100 units
-				Panel->SetActorScale3D(Scale);
-
 				FenceActors.Add(Panel);
 			}
 		}
@@ -217,63 +385,253 @@ TArray<AActor*> UOPM_SplineUtilities::GenerateCableRoutingAlongSpline(
 	UClass* SupportsActorClass,
 	float SupportSpacing,
 	float SagAmount,
-	UWorld* World)
+	UWorld* World,
+	float TensionRatio)
 {
 	TArray<AActor*> CableActors;
 
-	if (!SplineComponent || !World)
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache || !World || SupportSpacing <= 0.0f)
 	{
 		return CableActors;
 	}
 
-	// Place support structures
-	if (SupportsActorClass)
+	// Supports land on both spline ends, so every span has a support at each end
+	const TArray<float> SupportDistances = GetFittedBreaks(0.0f, Cache->GetLength(), SupportSpacing);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	TArray<FVector> SupportLocations;
+	SupportLocations.Reserve(SupportDistances.Num());
+	for (float Distance : SupportDistances)
 	{
-		FSplinePlacementSettings SupportSettings;
-		SupportSettings.PlacementMode = ESplinePlacementMode::Uniform;
-		SupportSettings.Spacing = SupportSpacing;
-		SupportSettings.Alignment = ESplineAlignment::Up;
+		const FTransform Transform = GetCachedTransform(*Cache, Distance, ESplineAlignment::Up);
+		SupportLocations.Add(Transform.GetLocation());
 
-		TArray<AActor*> Supports = PlaceActorsAlongSpline(SupportsActorClass, SplineComponent, SupportSettings, World);
-		CableActors.Append(Supports);
+		if (SupportsActorClass)
+		{
+			if (AActor* Support = World->SpawnActor<AActor>(SupportsActorClass, Transform, SpawnParams))
+			{
+				CableActors.Add(Support);
+			}
+		}
 	}
 
-	// Place cable segments with sag
-	if (CableActorClass)
+	// Follow each solved catenary with a chain of pieces meeting end to end, every span solved in one pass
+	if (CableActorClass && SupportLocations.Num() > 1)
 	{
-		float SplineLength = GetSplineLength(SplineComponent);
-		int32 NumSegments = FMath::CeilToInt(SplineLength / SupportSpacing);
-		
-		for (int32 i = 0; i < NumSegments; ++i)
+		const int32 NumSpans = SupportLocations.Num() - 1;
+		const int32 NumPieces = OPMSplineUtilities::CableActorPieces;
+
+		TArray<FVector> CablePoints;
+		SolveCableSpans(
+			TArrayView<const FVector>(SupportLocations.GetData(), NumSpans),
+			TArrayView<const FVector>(SupportLocations.GetData() + 1, NumSpans),
+			SagAmount,
+			TensionRatio,
+			NumPieces,
+			CablePoints);
+
+		for (int32 SpanIndex = 0; SpanIndex < NumSpans; ++SpanIndex)
 		{
-			float StartDist = i * SupportSpacing;
-			float EndDist = FMath::Min((i + 1) * SupportSpacing, SplineLength);
-			
-			FTransform StartTransform = GetTransformAtDistance(SplineComponent, StartDist, ESplineAlignment::None);
-			FTransform EndTransform = GetTransformAtDistance(SplineComponent, EndDist, ESplineAlignment::None);
+			const FVector* SpanPoints = CablePoints.GetData() + SpanIndex * (NumPieces + 1);
+			for (int32 Piece = 0; Piece < NumPieces; ++Piece)
+			{
+				if (AActor* Cable = SpawnStretchedActor(World, CableActorClass, SpanPoints[Piece], SpanPoints[Piece + 1]))
+				{
+					CableActors.Add(Cable);
+				}
+			}
+		}
+	}
+
+	return CableActors;
+}
+
+AActor* UOPM_SplineUtilities::GenerateRoadComposite(
+	USplineComponent* SplineComponent,
+	UStaticMesh* RoadMesh,
+	const TArray<UStaticMesh*>& PropMeshes,
+	float PropSpacing,
+	UWorld* World,
+	AActor* TargetActor)
+{
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache || !RoadMesh || !World)
+	{
+		return nullptr;
+	}
 
-			// Create cable segment at midpoint with sag
-			FVector MidPoint = CalculateCableSag(
-				StartTransform.GetLocation(),
-				EndTransform.GetLocation(),
-				0.5f,
-				SagAmount
-			);
+	AActor* Host = TargetActor ? TargetActor : SpawnComponentHost(World, Cache->GetLocationAtDistance(0.0f), TEXT("Road"));
+	if (!Host || !Host->GetRootComponent())
+	{
+		return nullptr;
+	}
 
-			FRotator Rotation = (EndTransform.GetLocation() - StartTransform.GetLocation()).Rotation();
+	Host->Modify();
 
-			FActorSpawnParameters SpawnParams;
-			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	// Road surface: continuous spline meshes, one per mesh length
+	FSplinePlacementSettings SurfaceSettings;
+	const float SurfaceLength = RoadMesh->GetBounds().BoxExtent.X * 2.0f;
+	const TArray<float> SurfaceBreaks = GetFittedBreaks(0.0f, Cache->GetLength(), SurfaceLength > 1.0f ? SurfaceLength : 200.0f);
 
-			AActor* Cable = World->SpawnActor<AActor>(CableActorClass, MidPoint, Rotation, SpawnParams);
-			if (Cable)
-			{
-				CableActors.Add(Cable);
-			}
+	TArray<FSplineMeshSpan> SurfaceSpans;
+	MakeSplineMeshSpans(*Cache, SurfaceBreaks, SurfaceSettings, SurfaceSpans);
+	BuildSplineMeshSegments(Host, RoadMesh, SurfaceSpans, OPMSplineUtilities::RoadSurfaceTag);
+
+	// Props on both sides, every prop mesh shares one instanced component
+	TArray<FTransform> PropTransforms;
+	const TArray<float> PropDistances = GetUniformDistances(Cache->GetLength(), PropSpacing);
+	PropTransforms.Reserve(PropDistances.Num() * 2);
+	for (float Distance : PropDistances)
+	{
+		const FTransform Base = GetCachedTransform(*Cache, Distance, ESplineAlignment::Tangent);
+		PropTransforms.Add(ApplyOffsetToTransform(Base, FVector(0, OPMSplineUtilities::RoadPropOffset, 0)));
+		PropTransforms.Add(ApplyOffsetToTransform(Base, FVector(0, -OPMSplineUtilities::RoadPropOffset, 0)));
+	}
+
+	TSet<UInstancedStaticMeshComponent*> UsedComponents;
+	for (UStaticMesh* PropMesh : PropMeshes)
+	{
+		if (UInstancedStaticMeshComponent* Props = FindOrAddInstancedComponent(Host, PropMesh, OPMSplineUtilities::RoadPropTag))
+		{
+			UpdateInstances(Props, PropTransforms);
+			UsedComponents.Add(Props);
 		}
 	}
+	RemoveUnusedInstancedComponents(Host, OPMSplineUtilities::RoadPropTag, UsedComponents);
 
-	return CableActors;
+	return Host;
+}
+
+AActor* UOPM_SplineUtilities::GenerateFenceComposite(
+	USplineComponent* SplineComponent,
+	UStaticMesh* PostMesh,
+	UStaticMesh* PanelMesh,
+	float PostSpacing,
+	UWorld* World,
+	AActor* TargetActor)
+{
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache || !PostMesh || !World || PostSpacing <= 0.0f)
+	{
+		return nullptr;
+	}
+
+	AActor* Host = TargetActor ? TargetActor : SpawnComponentHost(World, Cache->GetLocationAtDistance(0.0f), TEXT("Fence"));
+	if (!Host || !Host->GetRootComponent())
+	{
+		return nullptr;
+	}
+
+	Host->Modify();
+
+	// Posts land on both spline ends, panels fill each gap exactly
+	const TArray<float> PostDistances = GetFittedBreaks(0.0f, Cache->GetLength(), PostSpacing);
+
+	TArray<FTransform> PostTransforms;
+	PostTransforms.Reserve(PostDistances.Num());
+	for (float Distance : PostDistances)
+	{
+		PostTransforms.Add(GetCachedTransform(*Cache, Distance, ESplineAlignment::Tangent));
+	}
+
+	TSet<UInstancedStaticMeshComponent*> UsedComponents;
+	if (UInstancedStaticMeshComponent* Posts = FindOrAddInstancedComponent(Host, PostMesh, OPMSplineUtilities::FencePostTag))
+	{
+		UpdateInstances(Posts, PostTransforms);
+		UsedComponents.Add(Posts);
+	}
+	RemoveUnusedInstancedComponents(Host, OPMSplineUtilities::FencePostTag, UsedComponents);
+
+	TArray<FSplineMeshSpan> PanelSpans;
+	if (PanelMesh)
+	{
+		MakeSplineMeshSpans(*Cache, PostDistances, FSplinePlacementSettings(), PanelSpans);
+	}
+	BuildSplineMeshSegments(Host, PanelMesh, PanelSpans, OPMSplineUtilities::FencePanelTag);
+
+	return Host;
+}
+
+AActor* UOPM_SplineUtilities::GenerateCableComposite(
+	USplineComponent* SplineComponent,
+	UStaticMesh* CableMesh,
+	UStaticMesh* SupportMesh,
+	float SupportSpacing,
+	float SagAmount,
+	UWorld* World,
+	AActor* TargetActor,
+	float TensionRatio)
+{
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache || !World || SupportSpacing <= 0.0f)
+	{
+		return nullptr;
+	}
+
+	AActor* Host = TargetActor ? TargetActor : SpawnComponentHost(World, Cache->GetLocationAtDistance(0.0f), TEXT("Cable"));
+	if (!Host || !Host->GetRootComponent())
+	{
+		return nullptr;
+	}
+
+	Host->Modify();
+
+	const TArray<float> SupportDistances = GetFittedBreaks(0.0f, Cache->GetLength(), SupportSpacing);
+
+	TSet<UInstancedStaticMeshComponent*> UsedComponents;
+	if (SupportMesh)
+	{
+		TArray<FTransform> SupportTransforms;
+		SupportTransforms.Reserve(SupportDistances.Num());
+		for (float Distance : SupportDistances)
+		{
+			SupportTransforms.Add(GetCachedTransform(*Cache, Distance, ESplineAlignment::Up));
+		}
+
+		if (UInstancedStaticMeshComponent* Supports = FindOrAddInstancedComponent(Host, SupportMesh, OPMSplineUtilities::CableSupportTag))
+		{
+			UpdateInstances(Supports, SupportTransforms);
+			UsedComponents.Add(Supports);
+		}
+	}
+	RemoveUnusedInstancedComponents(Host, OPMSplineUtilities::CableSupportTag, UsedComponents);
+
+	// One continuous chain of spline meshes per span, all spans solved as catenaries in one parallel pass
+	TArray<FSplineMeshSpan> CableSpans;
+	if (CableMesh && SupportDistances.Num() > 1)
+	{
+		const int32 NumSpans = SupportDistances.Num() - 1;
+		TArray<FVector> SupportLocations;
+		SupportLocations.Reserve(SupportDistances.Num());
+		for (float Distance : SupportDistances)
+		{
+			SupportLocations.Add(Cache->GetLocationAtDistance(Distance));
+		}
+
+		TArray<FVector> CablePoints;
+		SolveCableSpans(
+			TArrayView<const FVector>(SupportLocations.GetData(), NumSpans),
+			TArrayView<const FVector>(SupportLocations.GetData() + 1, NumSpans),
+			SagAmount,
+			TensionRatio,
+			OPMSplineUtilities::CableSubdivisions,
+			CablePoints);
+
+		const int32 Stride = OPMSplineUtilities::CableSubdivisions + 1;
+		TArray<FVector> SpanPoints;
+		for (int32 SpanIndex = 0; SpanIndex < NumSpans; ++SpanIndex)
+		{
+			SpanPoints.Reset();
+			SpanPoints.Append(CablePoints.GetData() + SpanIndex * Stride, Stride);
+			MakePolylineSpans(SpanPoints, CableSpans);
+		}
+	}
+	BuildSplineMeshSegments(Host, CableMesh, CableSpans, OPMSplineUtilities::CableTag);
+
+	return Host;
 }
 
 float UOPM_SplineUtilities::GetSplineLength(USplineComponent* SplineComponent)
@@ -291,32 +649,13 @@ FTransform UOPM_SplineUtilities::GetTransformAtDistance(
 	float Distance,
 	ESplineAlignment Alignment)
 {
-	if (!SplineComponent)
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache)
 	{
 		return FTransform::Identity;
 	}
 
-	FVector Location = SplineComponent->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
-	FRotator Rotation;
-
-	switch (Alignment)
-	{
-		case ESplineAlignment::Tangent:
-			Rotation = GetTangentRotation(SplineComponent, Distance);
-			break;
-		case ESplineAlignment::Normal:
-			Rotation = GetNormalRotation(SplineComponent, Distance);
-			break;
-		case ESplineAlignment::Up:
-			Rotation = FRotator(0, SplineComponent->GetRotationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World).Yaw, 0);
-			break;
-		case ESplineAlignment::None:
-		default:
-			Rotation = FRotator::ZeroRotator;
-			break;
-	}
-
-	return FTransform(Rotation, Location, FVector::OneVector);
+	return GetCachedTransform(*Cache, Distance, Alignment);
 }
 
 TArray<float> UOPM_SplineUtilities::GetUniformDistances(
@@ -374,33 +713,50 @@ TArray<float> UOPM_SplineUtilities::GetSplinePointDistances(USplineComponent* Sp
 TArray<float> UOPM_SplineUtilities::GetAdaptiveDistances(
 	USplineComponent* SplineComponent,
 	float MinSpacing,
-	float MaxSpacing)
+	float MaxSpacing,
+	float ChordTolerance)
 {
 	TArray<float> Distances;
 
-	if (!SplineComponent)
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache || MaxSpacing <= 0.0f)
 	{
 		return Distances;
 	}
 
-	float SplineLength = GetSplineLength(SplineComponent);
+	MinSpacing = FMath::Clamp(MinSpacing, 1.0f, MaxSpacing);
+	ChordTolerance = FMath::Max(ChordTolerance, KINDA_SMALL_NUMBER);
+
+	float SplineLength = Cache->GetLength();
 	float CurrentDistance = 0.0f;
 
 	while (CurrentDistance < SplineLength)
 	{
 		Distances.Add(CurrentDistance);
 
-		// Calculate curvature at current point
-		float Curvature = GetCurvatureAtDistance(SplineComponent, CurrentDistance);
-		
-		// More curvature = smaller spacing
-		// Curvature typically ranges from 0 (straight) to 1+ (curved)
-		float NormalizedCurvature = FMath::Clamp(Curvature, 0.0f, 1.0f);
-		float Spacing = FMath::Lerp(MaxSpacing, MinSpacing, NormalizedCurvature);
+		// Shrink the step until the sharpest bend it spans keeps the chord within tolerance.
+		// Each pass only looks at a shorter span, so the peak curvature can only drop and this settles quickly.
+		float Spacing = MaxSpacing;
+		for (int32 Iteration = 0; Iteration < 8; ++Iteration)
+		{
+			const float AllowedSpacing = GetChordLengthForTolerance(
+				Cache->GetMaxCurvature(CurrentDistance, CurrentDistance + Spacing), ChordTolerance, MinSpacing, MaxSpacing);
+			if (AllowedSpacing >= Spacing)
+			{
+				break;
+			}
+			Spacing = AllowedSpacing;
+		}
 
 		CurrentDistance += Spacing;
 	}
 
+	// Close the last chord at the spline end so the tail is covered by the bound too
+	if (Distances.Num() > 0 && SplineLength - Distances.Last() > KINDA_SMALL_NUMBER)
+	{
+		Distances.Add(SplineLength);
+	}
+
 	return Distances;
 }
 
@@ -408,29 +764,13 @@ float UOPM_SplineUtilities::GetCurvatureAtDistance(
 	USplineComponent* SplineComponent,
 	float Distance)
 {
-	if (!SplineComponent)
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache)
 	{
 		return 0.0f;
 	}
 
-	// Sample tangents at nearby points to estimate curvature
-	const float SampleDistance = 10.0f;
-	
-	FVector Tangent1 = SplineComponent->GetTangentAtDistanceAlongSpline(
-		FMath::Max(0.0f, Distance - SampleDistance),
-		ESplineCoordinateSpace::World
-	).GetSafeNormal();
-
-	FVector Tangent2 = SplineComponent->GetTangentAtDistanceAlongSpline(
-		FMath::Min(GetSplineLength(SplineComponent), Distance + SampleDistance),
-		ESplineCoordinateSpace::World
-	).GetSafeNormal();
-
-	// Curvature is related to how much the tangent changes
-	float AngleChange = FMath::Acos(FVector::DotProduct(Tangent1, Tangent2));
-	
-	// Normalize to a reasonable range
-	return FMath::RadiansToDegrees(AngleChange) / 180.0f;
+	return NormalizeCurvature(Cache->GetCurvatureAtDistance(Distance));
 }
 
 void UOPM_SplineUtilities::SmoothSpline(
@@ -466,51 +806,153 @@ void UOPM_SplineUtilities::SmoothSpline(
 	SplineComponent->UpdateSpline();
 }
 
-TArray<AActor*> UOPM_SplineUtilities::PlaceActorsWithVariableDensity(
-	UClass* ActorClass,
+FSplineSimplificationResult UOPM_SplineUtilities::SimplifySpline(
 	USplineComponent* SplineComponent,
-	float BaseDensity,
-	float CurvatureFactor,
-	UWorld* World)
+	float Tolerance)
 {
-	TArray<AActor*> SpawnedActors;
+	FSplineSimplificationResult Result;
 
-	if (!ActorClass || !SplineComponent || !World)
+	if (!SplineComponent)
 	{
-		return SpawnedActors;
+		return Result;
 	}
 
-	float SplineLength = GetSplineLength(SplineComponent);
-	float CurrentDistance = 0.0f;
+	const int32 NumPoints = SplineComponent->GetNumberOfSplinePoints();
+	Result.OriginalPointCount = NumPoints;
+	Result.PointCount = NumPoints;
 
-	while (CurrentDistance < SplineLength)
+	if (NumPoints < 3)
 	{
-		FTransform Transform = GetTransformAtDistance(SplineComponent, CurrentDistance, ESplineAlignment::Tangent);
+		return Result;
+	}
 
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	Tolerance = FMath::Max(Tolerance, KINDA_SMALL_NUMBER);
+	Result.EvaluationTimeBefore = MeasureEvaluationTime(SplineComponent);
 
-		AActor* SpawnedActor = World->SpawnActor<AActor>(
-			ActorClass,
-			Transform.GetLocation(),
-			Transform.GetRotation().Rotator(),
-			SpawnParams
-		);
+	const bool bClosedLoop = SplineComponent->IsClosedLoop();
+	const FInterpCurveVector Original = SplineComponent->SplineCurves.Position;
+	const int32 NumSegments = bClosedLoop ? NumPoints : NumPoints - 1;
 
-		if (SpawnedActor)
+	// Reference samples of the original curve, tagged with the segment they lie on
+	TArray<FVector> Samples;
+	TArray<int32> SampleSegments;
+	Samples.Reserve(NumSegments * OPMSplineUtilities::SimplifySamplesPerSegment);
+	SampleSegments.Reserve(Samples.Max());
+	for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+	{
+		for (int32 Step = 0; Step < OPMSplineUtilities::SimplifySamplesPerSegment; ++Step)
 		{
-			SpawnedActors.Add(SpawnedActor);
+			Samples.Add(Original.Eval(Segment + static_cast<float>(Step) / OPMSplineUtilities::SimplifySamplesPerSegment));
+			SampleSegments.Add(Segment);
 		}
+	}
 
-		// Calculate next distance based on curvature
-		float Curvature = GetCurvatureAtDistance(SplineComponent, CurrentDistance);
-		float DensityMultiplier = 1.0f + (Curvature * CurvatureFactor);
-		float Spacing = (1.0f / BaseDensity) / DensityMultiplier;
+	// Start from a Douglas-Peucker pass over the control points themselves
+	TArray<FVector> Locations;
+	Locations.Reserve(NumPoints + 1);
+	for (const FInterpCurvePoint<FVector>& Point : Original.Points)
+	{
+		Locations.Add(Point.OutVal);
+	}
+	if (bClosedLoop)
+	{
+		Locations.Add(Locations[0]);
+	}
 
-		CurrentDistance += FMath::Max(Spacing, 10.0f); // Minimum 10 units
+	TArray<int32> Kept;
+	SimplifyPolyline(Locations, Tolerance, Kept);
+	if (bClosedLoop)
+	{
+		Kept.Pop();
 	}
 
-	return SpawnedActors;
+	// Rebuilt tangents bend the curve away from the chords, so restore points where it strays too far
+	FInterpCurveVector Candidate;
+	Result.MaxDeviation = RefineSubsetCurve(Original, Samples, SampleSegments, Tolerance, bClosedLoop, SplineComponent->bStationaryEndpoints, Kept, Candidate);
+
+	if (Kept.Num() >= NumPoints)
+	{
+		Result.EvaluationTimeAfter = Result.EvaluationTimeBefore;
+		Result.MaxDeviation = 0.0f;
+		return Result;
+	}
+
+	// Copy the kept points with their own rotation, scale and type before clearing the spline,
+	// tangents come from the checked curve so custom tangents keep their rescaled length
+	TArray<FSplinePoint> NewPoints;
+	NewPoints.Reserve(Kept.Num());
+	for (int32 Index = 0; Index < Kept.Num(); ++Index)
+	{
+		const int32 PointIndex = Kept[Index];
+		const FInterpCurvePoint<FVector>& Point = Candidate.Points[Index];
+		NewPoints.Emplace(
+			static_cast<float>(Index),
+			Point.OutVal,
+			Point.ArriveTangent,
+			Point.LeaveTangent,
+			SplineComponent->GetRotationAtSplinePoint(PointIndex, ESplineCoordinateSpace::Local),
+			SplineComponent->GetScaleAtSplinePoint(PointIndex),
+			SplineComponent->GetSplinePointType(PointIndex));
+	}
+
+	SplineComponent->ClearSplinePoints(false);
+	SplineComponent->AddPoints(NewPoints, false);
+	SplineComponent->SetClosedLoop(bClosedLoop, false);
+	SplineComponent->UpdateSpline();
+
+	Result.PointCount = SplineComponent->GetNumberOfSplinePoints();
+	Result.PointsRemoved = NumPoints - Result.PointCount;
+	Result.EvaluationTimeAfter = MeasureEvaluationTime(SplineComponent);
+	Result.EvaluationTimeSaved = Result.EvaluationTimeBefore - Result.EvaluationTimeAfter;
+
+	return Result;
+}
+
+TArray<AActor*> UOPM_SplineUtilities::PlaceActorsWithVariableDensity(
+	UClass* ActorClass,
+	USplineComponent* SplineComponent,
+	float BaseDensity,
+	float CurvatureFactor,
+	UWorld* World)
+{
+	TArray<AActor*> SpawnedActors;
+
+	if (!ActorClass || !SplineComponent || !World)
+	{
+		return SpawnedActors;
+	}
+
+	float SplineLength = GetSplineLength(SplineComponent);
+	float CurrentDistance = 0.0f;
+
+	while (CurrentDistance < SplineLength)
+	{
+		FTransform Transform = GetTransformAtDistance(SplineComponent, CurrentDistance, ESplineAlignment::Tangent);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		AActor* SpawnedActor = World->SpawnActor<AActor>(
+			ActorClass,
+			Transform.GetLocation(),
+			Transform.GetRotation().Rotator(),
+			SpawnParams
+		);
+
+		if (SpawnedActor)
+		{
+			SpawnedActors.Add(SpawnedActor);
+		}
+
+		// Calculate next distance based on curvature
+		float Curvature = GetCurvatureAtDistance(SplineComponent, CurrentDistance);
+		float DensityMultiplier = 1.0f + (Curvature * CurvatureFactor);
+		float Spacing = (1.0f / BaseDensity) / DensityMultiplier;
+
+		CurrentDistance += FMath::Max(Spacing, 10.0f); // Minimum 10 units
+	}
+
+	return SpawnedActors;
 }
 
 void UOPM_SplineUtilities::CreateParallelSpline(
@@ -575,6 +1017,275 @@ void UOPM_SplineUtilities::SnapSplineToTerrain(
 	SplineComponent->UpdateSpline();
 }
 
+int32 UOPM_SplineUtilities::SnapSplineToTerrainDense(
+	USplineComponent* SplineComponent,
+	UWorld* World,
+	float HeightOffset,
+	float SampleSpacing,
+	float Tolerance)
+{
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache || !World || Cache->GetLength() <= KINDA_SMALL_NUMBER)
+	{
+		return SplineComponent ? SplineComponent->GetNumberOfSplinePoints() : 0;
+	}
+
+	const bool bClosedLoop = SplineComponent->IsClosedLoop();
+	const float SplineLength = Cache->GetLength();
+	const FInterpCurveVector Original = SplineComponent->SplineCurves.Position;
+	const int32 NumOriginal = Original.Points.Num();
+	const TArray<float> PointDistances = GetSplinePointDistances(SplineComponent);
+	Tolerance = FMath::Max(Tolerance, KINDA_SMALL_NUMBER);
+
+	// Sample evenly, always including the original control points so sharp corners survive
+	const int32 NumSteps = FMath::Max(FMath::CeilToInt(SplineLength / FMath::Max(SampleSpacing, 1.0f)), 1);
+	TArray<TPair<float, int32>> TaggedDistances;
+	TaggedDistances.Reserve(NumOriginal + NumSteps + 1);
+	for (int32 PointIndex = 0; PointIndex < NumOriginal; ++PointIndex)
+	{
+		TaggedDistances.Emplace(PointDistances[PointIndex], PointIndex);
+	}
+	for (int32 Step = 0; Step <= NumSteps; ++Step)
+	{
+		TaggedDistances.Emplace(SplineLength * Step / NumSteps, INDEX_NONE);
+	}
+	TaggedDistances.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	// Remember which control point each sample is, a control point wins over an even sample at the same distance
+	TArray<float> Distances;
+	TArray<int32> SourcePoints;
+	Distances.Reserve(TaggedDistances.Num());
+	SourcePoints.Reserve(TaggedDistances.Num());
+	for (const TPair<float, int32>& Tagged : TaggedDistances)
+	{
+		if (Distances.Num() > 0 && Tagged.Key - Distances.Last() <= KINDA_SMALL_NUMBER)
+		{
+			if (Tagged.Value != INDEX_NONE && SourcePoints.Last() == INDEX_NONE)
+			{
+				Distances.Last() = Tagged.Key;
+				SourcePoints.Last() = Tagged.Value;
+			}
+			continue;
+		}
+
+		Distances.Add(Tagged.Key);
+		SourcePoints.Add(Tagged.Value);
+	}
+
+	// The loop's last sample duplicates its first point
+	if (bClosedLoop && Distances.Num() > 1)
+	{
+		Distances.Pop();
+		SourcePoints.Pop();
+	}
+
+	TArray<FVector> Points;
+	Points.Reserve(Distances.Num());
+	for (float Distance : Distances)
+	{
+		Points.Add(Cache->GetLocationAtDistance(Distance));
+	}
+
+	// Snap samples against bulk height reads, off the game thread
+	TArray<bool> Snapped;
+	Snapped.SetNumZeroed(Points.Num());
+
+	ALandscape* Landscape = UOPM_LandscapeIntegrationUtilities::FindLandscapeInWorld(World);
+	if (Landscape)
+	{
+		// Capture in tiles along the spline so long roads keep one sample per landscape quad, the two
+		// spare quads cover the capture rounding out to whole quads
+		const FVector LandscapeScale = Landscape->GetActorScale3D().GetAbs();
+		const float QuadSize = FMath::Max(FMath::Min(LandscapeScale.X, LandscapeScale.Y), KINDA_SMALL_NUMBER);
+		const float TileExtent = FMath::Max(QuadSize * (OPMSplineUtilities::TerrainSnapshotResolution - 3) - 2.0f * OPMSplineUtilities::TerrainSnapshotMargin, QuadSize);
+
+		FOPM_LandscapeHeightSnapshot Snapshot;
+		int32 TileStart = 0;
+		while (TileStart < Points.Num())
+		{
+			FBox TileBounds(Points[TileStart], Points[TileStart]);
+			int32 TileEnd = TileStart + 1;
+			for (; TileEnd < Points.Num(); ++TileEnd)
+			{
+				const FVector GrownSize = (TileBounds + Points[TileEnd]).GetSize();
+				if (FMath::Max(GrownSize.X, GrownSize.Y) > TileExtent)
+				{
+					break;
+				}
+				TileBounds += Points[TileEnd];
+			}
+
+			if (Snapshot.Capture(Landscape, TileBounds.ExpandBy(OPMSplineUtilities::TerrainSnapshotMargin), OPMSplineUtilities::TerrainSnapshotResolution))
+			{
+				ParallelFor(TileEnd - TileStart, [&](int32 Offset)
+				{
+					const int32 Index = TileStart + Offset;
+					float Height = 0.0f;
+					if (Snapshot.SampleHeight(Points[Index], Height))
+					{
+						Points[Index].Z = Height + HeightOffset;
+						Snapped[Index] = true;
+					}
+				});
+			}
+
+			TileStart = TileEnd;
+		}
+	}
+
+	// Samples the snapshot missed fall back to streamed landscape tiles, then to a trace
+	FCollisionQueryParams QueryParams;
+	QueryParams.bTraceComplex = false;
+
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		if (Snapped[Index])
+		{
+			continue;
+		}
+
+		float Height = 0.0f;
+		if (UOPM_LandscapeIntegrationUtilities::SampleLandscapeHeight(Landscape, Points[Index], Height))
+		{
+			Points[Index].Z = Height + HeightOffset;
+			continue;
+		}
+
+		const FVector Start = Points[Index] + FVector(0.0f, 0.0f, OPMSplineUtilities::TerrainTraceExtent);
+		const FVector End = Points[Index] - FVector(0.0f, 0.0f, OPMSplineUtilities::TerrainTraceExtent);
+
+		FHitResult HitResult;
+		if (World->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, QueryParams))
+		{
+			Points[Index] = HitResult.Location + FVector(0.0f, 0.0f, HeightOffset);
+		}
+	}
+
+	// Build the snapped samples into a curve in the spline's space, samples inside a segment keep its
+	// interpolation and control points keep their own, with custom tangents rescaled to the sample spacing
+	auto GetSpanLength = [SplineLength](const TArray<float>& Along, int32 From)
+	{
+		return From + 1 < Along.Num() ? Along[From + 1] - Along[From] : SplineLength - Along[From] + Along[0];
+	};
+
+	const FTransform& ComponentTransform = SplineComponent->GetComponentTransform();
+	const int32 NumSamples = Points.Num();
+
+	FInterpCurveVector Dense;
+	TArray<ESplinePointType::Type> PointTypes;
+	Dense.Points.Reserve(NumSamples);
+	PointTypes.Reserve(NumSamples);
+
+	int32 SegmentStart = 0;
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const FVector Location = ComponentTransform.InverseTransformPosition(Points[Index]);
+		const int32 PointIndex = SourcePoints[Index];
+
+		if (PointIndex == INDEX_NONE)
+		{
+			const EInterpCurveMode Mode = Original.Points[SegmentStart].InterpMode;
+			const ESplinePointType::Type Type = SplineComponent->GetSplinePointType(SegmentStart);
+			Dense.Points.Emplace(static_cast<float>(Index), Location, FVector::ZeroVector, FVector::ZeroVector, Mode == CIM_CurveUser ? CIM_CurveAuto : Mode);
+			PointTypes.Add(Type == ESplinePointType::CurveCustomTangent ? ESplinePointType::Curve : Type);
+			continue;
+		}
+
+		SegmentStart = PointIndex;
+
+		FInterpCurvePoint<FVector> Point = Original.Points[PointIndex];
+		Point.InVal = static_cast<float>(Index);
+		Point.OutVal = Location;
+
+		if (Point.InterpMode == CIM_CurveUser)
+		{
+			const float ArriveLength = GetSpanLength(PointDistances, (PointIndex + NumOriginal - 1) % NumOriginal);
+			const float LeaveLength = GetSpanLength(PointDistances, PointIndex);
+			if ((Index > 0 || bClosedLoop) && ArriveLength > KINDA_SMALL_NUMBER)
+			{
+				Point.ArriveTangent *= GetSpanLength(Distances, (Index + NumSamples - 1) % NumSamples) / ArriveLength;
+			}
+			if ((Index + 1 < NumSamples || bClosedLoop) && LeaveLength > KINDA_SMALL_NUMBER)
+			{
+				Point.LeaveTangent *= GetSpanLength(Distances, Index) / LeaveLength;
+			}
+		}
+
+		Dense.Points.Add(Point);
+		PointTypes.Add(SplineComponent->GetSplinePointType(PointIndex));
+	}
+
+	// Reduce the dense polyline to the points needed to stay within tolerance of the terrain
+	TArray<FVector> Polyline;
+	Polyline.Reserve(NumSamples + 1);
+	for (const FInterpCurvePoint<FVector>& Point : Dense.Points)
+	{
+		Polyline.Add(Point.OutVal);
+	}
+	if (bClosedLoop && NumSamples > 0)
+	{
+		Polyline.Add(Polyline[0]);
+	}
+
+	TArray<int32> Kept;
+	SimplifyPolyline(Polyline, Tolerance, Kept);
+	if (bClosedLoop && Kept.Num() > 0)
+	{
+		Kept.Pop();
+	}
+
+	// Douglas-Peucker only bounds the polyline, check the rebuilt curve against every snapped sample
+	const int32 NumSegments = bClosedLoop ? NumSamples : NumSamples - 1;
+	TArray<FVector> Samples;
+	TArray<int32> SampleSegments;
+	Samples.Reserve(NumSegments);
+	SampleSegments.Reserve(NumSegments);
+	for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+	{
+		Samples.Add(Polyline[Segment + 1]);
+		SampleSegments.Add(Segment);
+	}
+
+	FInterpCurveVector Candidate;
+	RefineSubsetCurve(Dense, Samples, SampleSegments, Tolerance, bClosedLoop, SplineComponent->bStationaryEndpoints, Kept, Candidate);
+
+	// Kept control points carry over their rotation and scale, new points take the spline's where they were sampled
+	TArray<FSplinePoint> NewPoints;
+	NewPoints.Reserve(Kept.Num());
+	for (int32 Index = 0; Index < Kept.Num(); ++Index)
+	{
+		const int32 SampleIndex = Kept[Index];
+		const int32 PointIndex = SourcePoints[SampleIndex];
+		const FInterpCurvePoint<FVector>& Point = Candidate.Points[Index];
+
+		const FRotator Rotation = PointIndex != INDEX_NONE ?
+			SplineComponent->GetRotationAtSplinePoint(PointIndex, ESplineCoordinateSpace::Local) :
+			SplineComponent->GetRotationAtDistanceAlongSpline(Distances[SampleIndex], ESplineCoordinateSpace::Local);
+		const FVector Scale = PointIndex != INDEX_NONE ?
+			SplineComponent->GetScaleAtSplinePoint(PointIndex) :
+			SplineComponent->GetScaleAtDistanceAlongSpline(Distances[SampleIndex]);
+
+		NewPoints.Emplace(
+			static_cast<float>(Index),
+			Point.OutVal,
+			Point.ArriveTangent,
+			Point.LeaveTangent,
+			Rotation,
+			Scale,
+			PointTypes[SampleIndex]);
+	}
+
+	SplineComponent->ClearSplinePoints(false);
+	SplineComponent->AddPoints(NewPoints, false);
+	SplineComponent->SetClosedLoop(bClosedLoop, false);
+	SplineComponent->UpdateSpline();
+
+	return SplineComponent->GetNumberOfSplinePoints();
+}
+
 TArray<USplineComponent*> UOPM_SplineUtilities::CreateBranchingSplines(
 	USplineComponent* MainSpline,
 	const TArray<float>& BranchLocations,
@@ -618,35 +1329,802 @@ TArray<USplineComponent*> UOPM_SplineUtilities::CreateBranchingSplines(
 	return BranchSplines;
 }
 
+TArray<AActor*> UOPM_SplineUtilities::PlaceActorsAlongSplineNetwork(
+	UClass* ActorClass,
+	const TArray<USplineComponent*>& Splines,
+	const FSplinePlacementSettings& Settings,
+	float JunctionClearance,
+	UWorld* World)
+{
+	if (!ActorClass || !World)
+	{
+		return TArray<AActor*>();
+	}
+
+	FOPM_SplineNetwork Network;
+	Network.Build(Splines);
+
+	TArray<TArray<float>> SplineDistances;
+	SplineDistances.SetNum(Splines.Num());
+	for (int32 SplineIndex = 0; SplineIndex < Splines.Num(); ++SplineIndex)
+	{
+		SplineDistances[SplineIndex] = GetPlacementDistances(Splines[SplineIndex], Settings);
+		Network.RemoveJunctionDistances(SplineIndex, SplineDistances[SplineIndex], JunctionClearance);
+	}
+
+	TArray<int32> SplineIndices;
+	const TArray<FTransform> Transforms = GenerateTransformsAtSplineDistances(Splines, SplineDistances, Settings, SplineIndices);
+	return SpawnActorsAtTransforms(ActorClass, Transforms, World);
+}
+
+TArray<FVector> UOPM_SplineUtilities::FindSplineJunctions(
+	const TArray<USplineComponent*>& Splines,
+	float Tolerance)
+{
+	FOPM_SplineNetwork Network;
+	Network.Build(Splines, Tolerance);
+
+	TArray<FVector> Locations;
+	Locations.Reserve(Network.GetJunctions().Num());
+	for (const FOPM_SplineJunction& Junction : Network.GetJunctions())
+	{
+		Locations.Add(Junction.Location);
+	}
+
+	return Locations;
+}
+
+TArray<FTransform> UOPM_SplineUtilities::GenerateTransformsAlongSplines(
+	const TArray<USplineComponent*>& Splines,
+	const FSplinePlacementSettings& Settings,
+	TArray<int32>& OutSplineIndices)
+{
+	TArray<TArray<float>> SplineDistances;
+	SplineDistances.SetNum(Splines.Num());
+	for (int32 SplineIndex = 0; SplineIndex < Splines.Num(); ++SplineIndex)
+	{
+		SplineDistances[SplineIndex] = GetPlacementDistances(Splines[SplineIndex], Settings);
+	}
+
+	return GenerateTransformsAtSplineDistances(Splines, SplineDistances, Settings, OutSplineIndices);
+}
+
+TArray<FTransform> UOPM_SplineUtilities::GenerateTransformsAtSplineDistances(
+	const TArray<USplineComponent*>& Splines,
+	const TArray<TArray<float>>& SplineDistances,
+	const FSplinePlacementSettings& Settings,
+	TArray<int32>& OutSplineIndices)
+{
+	TArray<FTransform> Transforms;
+	OutSplineIndices.Reset();
+
+	struct FBlock
+	{
+		int32 Spline;
+		int32 Start;
+		int32 End;
+	};
+
+	// Snapshot every spline up front so worker threads never touch the components, and
+	// lay all distances out in one array cut into blocks that never straddle two splines
+	const int32 NumSplines = FMath::Min(Splines.Num(), SplineDistances.Num());
+	TArray<FOPM_SplineSnapshot> Snapshots;
+	Snapshots.SetNum(NumSplines);
+
+	TArray<float> Distances;
+	TArray<FBlock> Blocks;
+	for (int32 SplineIndex = 0; SplineIndex < NumSplines; ++SplineIndex)
+	{
+		const TArray<float>& Local = SplineDistances[SplineIndex];
+		if (Local.Num() == 0 || !Snapshots[SplineIndex].Capture(Splines[SplineIndex]))
+		{
+			continue;
+		}
+
+		const int32 Offset = Distances.Num();
+		for (int32 First = 0; First < Local.Num(); First += OPMSplineUtilities::MultiSplineBlockSize)
+		{
+			Blocks.Add({ SplineIndex, Offset + First, Offset + FMath::Min(First + OPMSplineUtilities::MultiSplineBlockSize, Local.Num()) });
+		}
+
+		Distances.Append(Local);
+		OutSplineIndices.Reserve(Distances.Num());
+		for (int32 Index = 0; Index < Local.Num(); ++Index)
+		{
+			OutSplineIndices.Add(SplineIndex);
+		}
+	}
+
+	FOPM_SplineSamples Samples;
+	Samples.SetNumUninitialized(Distances.Num());
+	Transforms.SetNumUninitialized(Distances.Num());
+
+	ParallelFor(Blocks.Num(), [&](int32 BlockIndex)
+	{
+		const FBlock& Block = Blocks[BlockIndex];
+		Snapshots[Block.Spline].EvaluateRange(Distances, Block.Start, Block.End, Samples);
+
+		for (int32 Index = Block.Start; Index < Block.End; ++Index)
+		{
+			Transforms[Index] = MakeSampledTransform(Samples, Index, Settings);
+		}
+	}, Blocks.Num() <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	return Transforms;
+}
+
+TArray<AActor*> UOPM_SplineUtilities::PlaceActorsAlongSplines(
+	UClass* ActorClass,
+	const TArray<USplineComponent*>& Splines,
+	const FSplinePlacementSettings& Settings,
+	UWorld* World)
+{
+	if (!ActorClass || !World)
+	{
+		return TArray<AActor*>();
+	}
+
+	TArray<int32> SplineIndices;
+	const TArray<FTransform> Transforms = GenerateTransformsAlongSplines(Splines, Settings, SplineIndices);
+	return SpawnActorsAtTransforms(ActorClass, Transforms, World);
+}
+
+AActor* UOPM_SplineUtilities::PlaceInstancesAlongSplines(
+	UStaticMesh* Mesh,
+	const TArray<USplineComponent*>& Splines,
+	const FSplinePlacementSettings& Settings,
+	UWorld* World,
+	AActor* TargetActor)
+{
+	if (!Mesh || !World)
+	{
+		return nullptr;
+	}
+
+	TArray<int32> SplineIndices;
+	const TArray<FTransform> Transforms = GenerateTransformsAlongSplines(Splines, Settings, SplineIndices);
+	if (Transforms.Num() == 0 && !TargetActor)
+	{
+		return nullptr;
+	}
+
+	AActor* Host = TargetActor ? TargetActor : SpawnComponentHost(World, Transforms[0].GetLocation(), Mesh->GetName() + TEXT("_Splines"));
+	if (!Host || !Host->GetRootComponent())
+	{
+		return nullptr;
+	}
+
+	TSet<UInstancedStaticMeshComponent*> UsedComponents;
+	if (UInstancedStaticMeshComponent* Instances = FindOrAddInstancedComponent(Host, Mesh, OPMSplineUtilities::SplineInstanceTag))
+	{
+		UpdateInstances(Instances, Transforms);
+		UsedComponents.Add(Instances);
+	}
+	RemoveUnusedInstancedComponents(Host, OPMSplineUtilities::SplineInstanceTag, UsedComponents);
+
+	return Host;
+}
+
 // Private helper methods
 
-FRotator UOPM_SplineUtilities::GetTangentRotation(
-	USplineComponent* SplineComponent,
-	float Distance)
+FTransform UOPM_SplineUtilities::GetCachedTransform(
+	const FOPM_SplineCache& Cache,
+	float Distance,
+	ESplineAlignment Alignment)
 {
-	if (!SplineComponent)
+	return MakeAlignedTransform(
+		Cache.GetLocationAtDistance(Distance),
+		Cache.GetDirectionAtDistance(Distance),
+		Cache.GetUpVectorAtDistance(Distance),
+		Alignment);
+}
+
+void UOPM_SplineUtilities::BuildSubsetCurve(
+	const FInterpCurveVector& Source,
+	const TArray<int32>& Kept,
+	bool bClosedLoop,
+	bool bStationaryEndpoints,
+	FInterpCurveVector& OutCurve)
+{
+	const int32 NumSource = Source.Points.Num();
+
+	OutCurve.Points.Reset(Kept.Num());
+	for (int32 Index = 0; Index < Kept.Num(); ++Index)
+	{
+		FInterpCurvePoint<FVector> Point = Source.Points[Kept[Index]];
+		Point.InVal = static_cast<float>(Index);
+
+		// Custom tangents are per source segment, stretch them over the segments each span now covers
+		if (Point.InterpMode == CIM_CurveUser)
+		{
+			const int32 PrevIndex = Index > 0 ? Kept[Index - 1] : (bClosedLoop ? Kept.Last() - NumSource : Kept[Index] - 1);
+			const int32 NextIndex = Index + 1 < Kept.Num() ? Kept[Index + 1] : (bClosedLoop ? Kept[0] + NumSource : Kept[Index] + 1);
+			Point.ArriveTangent *= static_cast<float>(Kept[Index] - PrevIndex);
+			Point.LeaveTangent *= static_cast<float>(NextIndex - Kept[Index]);
+		}
+
+		OutCurve.Points.Add(Point);
+	}
+
+	if (bClosedLoop)
+	{
+		OutCurve.SetLoopKey(static_cast<float>(Kept.Num()));
+	}
+	else
 	{
-		return FRotator::ZeroRotator;
+		OutCurve.ClearLoopKey();
 	}
 
-	FVector Tangent = SplineComponent->GetTangentAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
-	return Tangent.Rotation();
+	OutCurve.AutoSetTangents(0.0f, bStationaryEndpoints);
 }
 
-FRotator UOPM_SplineUtilities::GetNormalRotation(
-	USplineComponent* SplineComponent,
-	float Distance)
+float UOPM_SplineUtilities::RefineSubsetCurve(
+	const FInterpCurveVector& Source,
+	const TArray<FVector>& Samples,
+	const TArray<int32>& SampleSegments,
+	float Tolerance,
+	bool bClosedLoop,
+	bool bStationaryEndpoints,
+	TArray<int32>& Kept,
+	FInterpCurveVector& OutCurve)
 {
-	if (!SplineComponent)
+	const int32 NumPoints = Source.Points.Num();
+	const int32 NumSegments = bClosedLoop ? NumPoints : NumPoints - 1;
+	float MaxDeviation = 0.0f;
+
+	TArray<int32> SegmentSpans;
+	SegmentSpans.SetNum(NumSegments);
+
+	for (int32 Pass = 0; Pass < OPMSplineUtilities::SimplifyRefinePasses; ++Pass)
 	{
-		return FRotator::ZeroRotator;
+		BuildSubsetCurve(Source, Kept, bClosedLoop, bStationaryEndpoints, OutCurve);
+
+		for (int32 Span = 0; Span < Kept.Num(); ++Span)
+		{
+			const int32 SpanEnd = Kept.IsValidIndex(Span + 1) ? Kept[Span + 1] : NumSegments;
+			for (int32 Segment = Kept[Span]; Segment < SpanEnd; ++Segment)
+			{
+				SegmentSpans[Segment] = Span;
+			}
+		}
+
+		TArray<int32> WorstSegments;
+		TArray<float> WorstDeviations;
+		WorstSegments.Init(INDEX_NONE, Kept.Num());
+		WorstDeviations.Init(Tolerance, Kept.Num());
+		MaxDeviation = 0.0f;
+
+		for (int32 Index = 0; Index < Samples.Num(); ++Index)
+		{
+			const int32 Span = SegmentSpans[SampleSegments[Index]];
+			if (Span >= OutCurve.Points.Num() - (bClosedLoop ? 0 : 1))
+			{
+				continue;
+			}
+
+			float DistanceSquared = 0.0f;
+			OutCurve.InaccurateFindNearestOnSegment(Samples[Index], Span, DistanceSquared);
+
+			const float Deviation = FMath::Sqrt(DistanceSquared);
+			MaxDeviation = FMath::Max(MaxDeviation, Deviation);
+			if (Deviation > WorstDeviations[Span])
+			{
+				WorstDeviations[Span] = Deviation;
+				WorstSegments[Span] = SampleSegments[Index];
+			}
+		}
+
+		// Restore the dropped point nearest the worst sample of each span that strays,
+		// the last pass only measures so the reported deviation matches the result
+		TArray<int32> Restored;
+		for (int32 Span = 0; Span < Kept.Num() && Pass + 1 < OPMSplineUtilities::SimplifyRefinePasses; ++Span)
+		{
+			const int32 Segment = WorstSegments[Span];
+			if (Segment == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const int32 SpanEnd = Kept.IsValidIndex(Span + 1) ? Kept[Span + 1] : NumPoints;
+			const int32 Restore = Segment + 1 < SpanEnd ? Segment + 1 : Segment;
+			if (Restore > Kept[Span] && Restore < SpanEnd)
+			{
+				Restored.Add(Restore);
+			}
+		}
+
+		if (Restored.Num() == 0)
+		{
+			break;
+		}
+
+		Kept.Append(Restored);
+		Kept.Sort();
 	}
 
-	FVector Up = SplineComponent->GetUpVectorAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
-	FVector Tangent = SplineComponent->GetTangentAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
-	FVector Right = FVector::CrossProduct(Up, Tangent).GetSafeNormal();
-	
-	return FRotationMatrix::MakeFromXZ(Tangent, Up).Rotator();
+	return MaxDeviation;
+}
+
+float UOPM_SplineUtilities::MeasureEvaluationTime(USplineComponent* SplineComponent)
+{
+	const float SplineLength = SplineComponent->GetSplineLength();
+	const int32 NumQueries = OPMSplineUtilities::EvaluationTimingQueries;
+
+	FVector Accumulated = FVector::ZeroVector;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		Accumulated += SplineComponent->GetLocationAtDistanceAlongSpline(SplineLength * Index / (NumQueries - 1), ESplineCoordinateSpace::Local);
+	}
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	// Use the result so the queries cannot be optimized away
+	return Accumulated.ContainsNaN() ? 0.0f : static_cast<float>(Elapsed * 1000.0 * 1000.0 / NumQueries);
+}
+
+void UOPM_SplineUtilities::SimplifyPolyline(
+	const TArray<FVector>& Points,
+	float Tolerance,
+	TArray<int32>& OutKept)
+{
+	OutKept.Reset();
+
+	const int32 NumPoints = Points.Num();
+	if (NumPoints <= 2)
+	{
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			OutKept.Add(Index);
+		}
+		return;
+	}
+
+	TBitArray<> Keep(false, NumPoints);
+	Keep[0] = true;
+	Keep[NumPoints - 1] = true;
+
+	// Split each span at its worst point until every point is within tolerance of its chord
+	TArray<TPair<int32, int32>> Spans;
+	Spans.Emplace(0, NumPoints - 1);
+
+	while (Spans.Num() > 0)
+	{
+		const TPair<int32, int32> Span = Spans.Pop(false);
+
+		int32 WorstIndex = INDEX_NONE;
+		float WorstDistance = Tolerance;
+		for (int32 Index = Span.Key + 1; Index < Span.Value; ++Index)
+		{
+			const float Distance = FMath::PointDistToSegment(Points[Index], Points[Span.Key], Points[Span.Value]);
+			if (Distance > WorstDistance)
+			{
+				WorstDistance = Distance;
+				WorstIndex = Index;
+			}
+		}
+
+		if (WorstIndex != INDEX_NONE)
+		{
+			Keep[WorstIndex] = true;
+			Spans.Emplace(Span.Key, WorstIndex);
+			Spans.Emplace(WorstIndex, Span.Value);
+		}
+	}
+
+	for (TConstSetBitIterator<> It(Keep); It; ++It)
+	{
+		OutKept.Add(It.GetIndex());
+	}
+}
+
+TArray<AActor*> UOPM_SplineUtilities::SpawnActorsAtTransforms(
+	UClass* ActorClass,
+	const TArray<FTransform>& Transforms,
+	UWorld* World)
+{
+	TArray<AActor*> SpawnedActors;
+	SpawnedActors.Reserve(Transforms.Num());
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	for (const FTransform& Transform : Transforms)
+	{
+		AActor* SpawnedActor = World->SpawnActor<AActor>(
+			ActorClass,
+			Transform.GetLocation(),
+			Transform.GetRotation().Rotator(),
+			SpawnParams
+		);
+
+		if (SpawnedActor)
+		{
+			SpawnedActor->SetActorScale3D(Transform.GetScale3D());
+			SpawnedActors.Add(SpawnedActor);
+		}
+	}
+
+	return SpawnedActors;
+}
+
+FTransform UOPM_SplineUtilities::MakeSampledTransform(
+	const FOPM_SplineSamples& Samples,
+	int32 Index,
+	const FSplinePlacementSettings& Settings)
+{
+	FTransform Transform = MakeAlignedTransform(
+		Samples.Locations[Index], Samples.Directions[Index], Samples.UpVectors[Index], Settings.Alignment);
+	Transform = ApplyOffsetToTransform(Transform, Settings.Offset);
+
+	if (Settings.bScaleBySpline)
+	{
+		Transform.SetScale3D(Samples.Scales[Index]);
+	}
+
+	return Transform;
+}
+
+FTransform UOPM_SplineUtilities::MakeAlignedTransform(
+	const FVector& Location,
+	const FVector& Direction,
+	const FVector& Up,
+	ESplineAlignment Alignment)
+{
+	FRotator Rotation;
+
+	switch (Alignment)
+	{
+		case ESplineAlignment::Tangent:
+			Rotation = Direction.Rotation();
+			break;
+		case ESplineAlignment::Normal:
+			// Rotation-minimizing up vector, so long roads do not pick up twist between spline points
+			Rotation = FRotationMatrix::MakeFromXZ(Direction, Up).Rotator();
+			break;
+		case ESplineAlignment::Up:
+			Rotation = FRotator(0, Direction.Rotation().Yaw, 0);
+			break;
+		case ESplineAlignment::None:
+		default:
+			Rotation = FRotator::ZeroRotator;
+			break;
+	}
+
+	return FTransform(Rotation, Location, FVector::OneVector);
+}
+
+AActor* UOPM_SplineUtilities::SpawnStretchedActor(
+	UWorld* World,
+	UClass* ActorClass,
+	const FVector& Start,
+	const FVector& End)
+{
+	// Pieces must stay where they are put or chains would open up
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* Actor = World->SpawnActor<AActor>(ActorClass, (Start + End) * 0.5f, (End - Start).Rotation(), SpawnParams);
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	// Measure the actor's own length, unscaled in its local space, rather than assuming one
+	const float LocalLength = Actor->CalculateComponentsBoundingBoxInLocalSpace(true).GetSize().X;
+
+	FVector Scale = Actor->GetActorScale3D();
+	Scale.X = FVector::Dist(Start, End) / (LocalLength > KINDA_SMALL_NUMBER ? LocalLength : OPMSplineUtilities::DefaultStretchLength);
+	Actor->SetActorScale3D(Scale);
+
+	return Actor;
+}
+
+AActor* UOPM_SplineUtilities::SpawnComponentHost(
+	UWorld* World,
+	const FVector& Location,
+	const FString& Label)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* Host = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Location), SpawnParams);
+	if (!Host)
+	{
+		return nullptr;
+	}
+
+	USceneComponent* Root = NewObject<USceneComponent>(Host, TEXT("Root"), RF_Transactional);
+	Root->SetMobility(EComponentMobility::Static);
+	Host->SetRootComponent(Root);
+	Host->AddInstanceComponent(Root);
+	Root->RegisterComponent();
+	Root->SetWorldLocation(Location);
+
+#if WITH_EDITOR
+	Host->SetActorLabel(Label);
+#endif
+
+	return Host;
+}
+
+void UOPM_SplineUtilities::MakeSplineMeshSpans(
+	const FOPM_SplineCache& Cache,
+	const TArray<float>& Breaks,
+	const FSplinePlacementSettings& Settings,
+	TArray<FSplineMeshSpan>& OutSpans)
+{
+	OutSpans.Reserve(OutSpans.Num() + FMath::Max(Breaks.Num() - 1, 0));
+
+	for (int32 Index = 0; Index + 1 < Breaks.Num(); ++Index)
+	{
+		const float StartDistance = Breaks[Index];
+		const float EndDistance = Breaks[Index + 1];
+		const float SegmentLength = EndDistance - StartDistance;
+
+		const FVector StartDirection = Cache.GetDirectionAtDistance(StartDistance);
+		const FVector EndDirection = Cache.GetDirectionAtDistance(EndDistance);
+		const FVector StartUp = Cache.GetUpVectorAtDistance(StartDistance);
+		const FVector EndUp = Cache.GetUpVectorAtDistance(EndDistance);
+
+		FSplineMeshSpan& Span = OutSpans.AddDefaulted_GetRef();
+		Span.StartLocation = Cache.GetLocationAtDistance(StartDistance) + FRotationMatrix::MakeFromXZ(StartDirection, StartUp).TransformVector(Settings.Offset);
+		Span.EndLocation = Cache.GetLocationAtDistance(EndDistance) + FRotationMatrix::MakeFromXZ(EndDirection, EndUp).TransformVector(Settings.Offset);
+		Span.StartTangent = StartDirection * SegmentLength;
+		Span.EndTangent = EndDirection * SegmentLength;
+		Span.UpVector = StartUp;
+
+		// The segment frame follows the start up vector, roll at the end takes up the remaining twist
+		const FVector CarriedUp = (StartUp - EndDirection * FVector::DotProduct(StartUp, EndDirection)).GetSafeNormal();
+		Span.EndRoll = FMath::Atan2(
+			FVector::DotProduct(FVector::CrossProduct(CarriedUp, EndUp), EndDirection),
+			FVector::DotProduct(CarriedUp, EndUp));
+
+		if (Settings.bScaleBySpline)
+		{
+			const FVector StartScale = Cache.GetScaleAtDistance(StartDistance);
+			const FVector EndScale = Cache.GetScaleAtDistance(EndDistance);
+			Span.StartScale = FVector2D(StartScale.Y, StartScale.Z);
+			Span.EndScale = FVector2D(EndScale.Y, EndScale.Z);
+		}
+	}
+}
+
+void UOPM_SplineUtilities::MakePolylineSpans(
+	const TArray<FVector>& Points,
+	TArray<FSplineMeshSpan>& OutSpans)
+{
+	const int32 NumPoints = Points.Num();
+	OutSpans.Reserve(OutSpans.Num() + FMath::Max(NumPoints - 1, 0));
+
+	auto GetTangent = [&Points, NumPoints](int32 Index)
+	{
+		const FVector& Previous = Points[FMath::Max(Index - 1, 0)];
+		const FVector& Next = Points[FMath::Min(Index + 1, NumPoints - 1)];
+		const float Scale = (Index == 0 || Index == NumPoints - 1) ? 1.0f : 0.5f;
+		return (Next - Previous) * Scale;
+	};
+
+	for (int32 Index = 0; Index + 1 < NumPoints; ++Index)
+	{
+		FSplineMeshSpan& Span = OutSpans.AddDefaulted_GetRef();
+		Span.StartLocation = Points[Index];
+		Span.EndLocation = Points[Index + 1];
+		Span.StartTangent = GetTangent(Index);
+		Span.EndTangent = GetTangent(Index + 1);
+		Span.UpVector = FVector::UpVector;
+	}
+}
+
+void UOPM_SplineUtilities::BuildSplineMeshSegments(
+	AActor* Owner,
+	UStaticMesh* Mesh,
+	const TArray<FSplineMeshSpan>& Spans,
+	FName PoolTag)
+{
+	USceneComponent* Root = Owner ? Owner->GetRootComponent() : nullptr;
+	if (!Root)
+	{
+		return;
+	}
+
+	Owner->Modify();
+
+	TArray<USplineMeshComponent*> Pool;
+	Owner->GetComponents<USplineMeshComponent>(Pool);
+	Pool.RemoveAll([PoolTag](const USplineMeshComponent* Segment)
+	{
+		return !Segment->ComponentHasTag(PoolTag);
+	});
+
+	// Release segments the new layout no longer needs
+	const int32 NumSegments = Mesh ? Spans.Num() : 0;
+	for (int32 Index = NumSegments; Index < Pool.Num(); ++Index)
+	{
+		Owner->RemoveInstanceComponent(Pool[Index]);
+		Pool[Index]->DestroyComponent();
+	}
+	Pool.SetNum(FMath::Min(Pool.Num(), NumSegments));
+
+	const FTransform OwnerTransform = Owner->GetActorTransform();
+
+	for (int32 Index = 0; Index < NumSegments; ++Index)
+	{
+		USplineMeshComponent* Segment = Pool.IsValidIndex(Index) ? Pool[Index] : nullptr;
+		if (!Segment)
+		{
+			Segment = NewObject<USplineMeshComponent>(Owner, NAME_None, RF_Transactional);
+			Segment->ComponentTags.Add(PoolTag);
+			Segment->SetMobility(Root->Mobility);
+			Segment->SetupAttachment(Root);
+			Owner->AddInstanceComponent(Segment);
+			Segment->RegisterComponent();
+		}
+		else
+		{
+			Segment->Modify();
+		}
+
+		const FSplineMeshSpan& Span = Spans[Index];
+
+		Segment->SetStaticMesh(Mesh);
+		Segment->SetStartAndEnd(
+			OwnerTransform.InverseTransformPosition(Span.StartLocation),
+			OwnerTransform.InverseTransformVector(Span.StartTangent),
+			OwnerTransform.InverseTransformPosition(Span.EndLocation),
+			OwnerTransform.InverseTransformVector(Span.EndTangent),
+			false);
+		Segment->SetSplineUpDir(OwnerTransform.InverseTransformVectorNoScale(Span.UpVector), false);
+		Segment->SetStartRoll(0.0f, false);
+		Segment->SetEndRoll(Span.EndRoll, false);
+		Segment->SetStartScale(Span.StartScale, false);
+		Segment->SetEndScale(Span.EndScale, false);
+		Segment->UpdateMesh();
+	}
+}
+
+UInstancedStaticMeshComponent* UOPM_SplineUtilities::FindOrAddInstancedComponent(
+	AActor* Owner,
+	UStaticMesh* Mesh,
+	FName PoolTag)
+{
+	USceneComponent* Root = Owner ? Owner->GetRootComponent() : nullptr;
+	if (!Root || !Mesh)
+	{
+		return nullptr;
+	}
+
+	TArray<UInstancedStaticMeshComponent*> Existing;
+	Owner->GetComponents<UInstancedStaticMeshComponent>(Existing);
+	for (UInstancedStaticMeshComponent* Component : Existing)
+	{
+		if (Component->ComponentHasTag(PoolTag) && Component->GetStaticMesh() == Mesh)
+		{
+			Component->Modify();
+			return Component;
+		}
+	}
+
+	UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(Owner, NAME_None, RF_Transactional);
+	Component->ComponentTags.Add(PoolTag);
+	Component->SetStaticMesh(Mesh);
+	Component->SetMobility(Root->Mobility);
+	Component->SetupAttachment(Root);
+	Owner->AddInstanceComponent(Component);
+	Component->RegisterComponent();
+	return Component;
+}
+
+void UOPM_SplineUtilities::UpdateInstances(
+	UInstancedStaticMeshComponent* Component,
+	const TArray<FTransform>& WorldTransforms)
+{
+	if (!Component)
+	{
+		return;
+	}
+
+	const int32 ExistingCount = Component->GetInstanceCount();
+	const int32 NewCount = WorldTransforms.Num();
+	const int32 ReusedCount = FMath::Min(ExistingCount, NewCount);
+
+	// Overwrite the instances we already have, then grow or shrink the tail
+	if (ReusedCount > 0)
+	{
+		const TArray<FTransform> Reused(WorldTransforms.GetData(), ReusedCount);
+		Component->BatchUpdateInstancesTransforms(0, Reused, true, false, true);
+	}
+
+	if (NewCount > ExistingCount)
+	{
+		const TArray<FTransform> Added(WorldTransforms.GetData() + ExistingCount, NewCount - ExistingCount);
+		Component->AddInstances(Added, false, true);
+	}
+	else if (NewCount < ExistingCount)
+	{
+		TArray<int32> Removed;
+		Removed.Reserve(ExistingCount - NewCount);
+		for (int32 Index = ExistingCount - 1; Index >= NewCount; --Index)
+		{
+			Removed.Add(Index);
+		}
+		Component->RemoveInstances(Removed);
+	}
+
+	Component->MarkRenderStateDirty();
+}
+
+void UOPM_SplineUtilities::RemoveUnusedInstancedComponents(
+	AActor* Owner,
+	FName PoolTag,
+	const TSet<UInstancedStaticMeshComponent*>& UsedComponents)
+{
+	if (!Owner)
+	{
+		return;
+	}
+
+	TArray<UInstancedStaticMeshComponent*> Existing;
+	Owner->GetComponents<UInstancedStaticMeshComponent>(Existing);
+	for (UInstancedStaticMeshComponent* Component : Existing)
+	{
+		if (Component->ComponentHasTag(PoolTag) && !UsedComponents.Contains(Component))
+		{
+			Owner->RemoveInstanceComponent(Component);
+			Component->DestroyComponent();
+		}
+	}
+}
+
+TArray<float> UOPM_SplineUtilities::GetFittedBreaks(
+	float StartDistance,
+	float EndDistance,
+	float NominalLength)
+{
+	TArray<float> Breaks;
+
+	const float SpanLength = EndDistance - StartDistance;
+	if (SpanLength <= KINDA_SMALL_NUMBER)
+	{
+		return Breaks;
+	}
+
+	// Stretch the nominal length slightly so a whole number of pieces covers the span exactly
+	const int32 NumPieces = FMath::Max(1, FMath::RoundToInt(SpanLength / FMath::Max(NominalLength, 1.0f)));
+
+	Breaks.SetNumUninitialized(NumPieces + 1);
+	for (int32 Index = 0; Index <= NumPieces; ++Index)
+	{
+		Breaks[Index] = StartDistance + SpanLength * Index / NumPieces;
+	}
+
+	return Breaks;
+}
+
+float UOPM_SplineUtilities::GetChordLengthForTolerance(
+	float Curvature,
+	float Tolerance,
+	float MinLength,
+	float MaxLength)
+{
+	if (Curvature <= KINDA_SMALL_NUMBER)
+	{
+		return MaxLength;
+	}
+
+	// A chord of length L across an arc of radius R deviates by R (1 - cos(L / 2R)) at its midpoint
+	const float Radius = 1.0f / Curvature;
+	const float ChordLength = Tolerance >= Radius
+		? PI * Radius
+		: 2.0f * Radius * FMath::Acos(1.0f - Tolerance / Radius);
+
+	return FMath::Clamp(ChordLength, MinLength, MaxLength);
+}
+
+float UOPM_SplineUtilities::NormalizeCurvature(float Curvature)
+{
+	// Tangent angle change over +/-10 units, as a fraction of 180 degrees
+	const float SampleWindow = 20.0f;
+	return FMath::Min(Curvature * SampleWindow, PI) / PI;
 }
 
 FTransform UOPM_SplineUtilities::ApplyOffsetToTransform(
@@ -664,18 +2142,20 @@ FTransform UOPM_SplineUtilities::ApplyOffsetToTransform(
 	return Result;
 }
 
-FVector UOPM_SplineUtilities::CalculateCableSag(
-	const FVector& Start,
-	const FVector& End,
-	float Alpha,
-	float SagAmount)
+void UOPM_SplineUtilities::SolveCableSpans(
+	TArrayView<const FVector> Starts,
+	TArrayView<const FVector> Ends,
+	float SagAmount,
+	float TensionRatio,
+	int32 PointsPerSpan,
+	TArray<FVector>& OutPoints)
 {
-	// Interpolate between start and end
-	FVector LinearPoint = FMath::Lerp(Start, End, Alpha);
-	
-	// Apply catenary curve approximation (parabola)
-	float SagFactor = 4.0f * Alpha * (1.0f - Alpha); // Parabola: max sag at center
-	FVector SagOffset = FVector(0, 0, -SagAmount * SagFactor);
-	
-	return LinearPoint + SagOffset;
+	if (TensionRatio > 0.0f)
+	{
+		FOPM_CatenarySolver::SolveForTension(Starts, Ends, TensionRatio, PointsPerSpan, OutPoints);
+	}
+	else
+	{
+		FOPM_CatenarySolver::SolveForSag(Starts, Ends, SagAmount, PointsPerSpan, OutPoints);
+	}
 }
@@ -0,0 +1,554 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SplineWatchSubsystem.h"
+#include "SplineUtilities.h"
+#include "SplineEvaluationCache.h"
+#include "OPMTransactionUtils.h"
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "Editor.h"
+#include "Algo/BinarySearch.h"
+
+#define LOCTEXT_NAMESPACE "OPMSplineWatch"
+
+namespace OPMSplineWatch
+{
+	/** Seconds without spline changes before affected segments are regenerated */
+	constexpr double SettleSeconds = 0.15;
+
+	/** Tolerance when comparing control point state */
+	constexpr float PointTolerance = 0.01f;
+
+	/** Placements watched at once, the oldest are forgotten first */
+	constexpr int32 MaxPlacements = 256;
+}
+
+bool UOPM_SplineWatchSubsystem::FPointState::Equals(const FPointState& Other) const
+{
+	return InterpMode == Other.InterpMode &&
+		Location.Equals(Other.Location, OPMSplineWatch::PointTolerance) &&
+		ArriveTangent.Equals(Other.ArriveTangent, OPMSplineWatch::PointTolerance) &&
+		LeaveTangent.Equals(Other.LeaveTangent, OPMSplineWatch::PointTolerance) &&
+		Rotation.Equals(Other.Rotation, KINDA_SMALL_NUMBER) &&
+		Scale.Equals(Other.Scale, KINDA_SMALL_NUMBER);
+}
+
+UOPM_SplineWatchSubsystem* UOPM_SplineWatchSubsystem::Get()
+{
+	return GEditor ? GEditor->GetEditorSubsystem<UOPM_SplineWatchSubsystem>() : nullptr;
+}
+
+void UOPM_SplineWatchSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddUObject(this, &UOPM_SplineWatchSubsystem::OnPostUndoRedo);
+}
+
+void UOPM_SplineWatchSubsystem::Deinitialize()
+{
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+	Placements.Empty();
+
+	Super::Deinitialize();
+}
+
+void UOPM_SplineWatchSubsystem::WatchPlacement(
+	USplineComponent* SplineComponent,
+	UClass* ActorClass,
+	const FSplinePlacementSettings& Settings,
+	TArrayView<AActor* const> Actors,
+	TArrayView<const float> Distances)
+{
+	if (!SplineComponent || !ActorClass || Actors.Num() != Distances.Num() || Actors.Num() == 0)
+	{
+		return;
+	}
+
+	PrunePlacements();
+
+	FWatchedPlacement& Placement = Placements.AddDefaulted_GetRef();
+	Placement.Spline = SplineComponent;
+	Placement.ActorClass = ActorClass;
+	Placement.Settings = Settings;
+	Placement.ComponentTransform = SplineComponent->GetComponentTransform();
+	Placement.bClosedLoop = SplineComponent->IsClosedLoop();
+	Placement.PlacedVersion = SplineComponent->SplineCurves.Version;
+	Placement.SeenVersion = Placement.PlacedVersion;
+	Placement.SeenTransform = Placement.ComponentTransform;
+	CapturePoints(SplineComponent, Placement.Points);
+
+	Placement.Items.Reserve(Actors.Num());
+	Placement.History.Reserve(Actors.Num());
+	for (int32 Index = 0; Index < Actors.Num(); ++Index)
+	{
+		FPlacedItem& Item = Placement.Items.AddDefaulted_GetRef();
+		Item.Actor = Actors[Index];
+		Item.Segment = GetSegmentAtDistance(SplineComponent, Distances[Index]);
+		Item.Offset = Distances[Index] - SplineComponent->GetDistanceAlongSplineAtSplinePoint(FMath::Max(Item.Segment, 0));
+		Placement.History.Add(Actors[Index]);
+	}
+}
+
+void UOPM_SplineWatchSubsystem::StopWatching(USplineComponent* SplineComponent)
+{
+	Placements.RemoveAll([SplineComponent](const FWatchedPlacement& Placement)
+	{
+		return Placement.Spline.Get() == SplineComponent;
+	});
+}
+
+void UOPM_SplineWatchSubsystem::Tick(float DeltaTime)
+{
+	// Undo and redo restore spline and actors together, OnPostUndoRedo resyncs once they are done
+	if (GIsTransacting)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	for (int32 Index = Placements.Num() - 1; Index >= 0; --Index)
+	{
+		FWatchedPlacement& Placement = Placements[Index];
+
+		USplineComponent* Spline = Placement.Spline.Get();
+		if (!Spline || !Placement.ActorClass.IsValid() || !IsPlacementAlive(Placement))
+		{
+			Placements.RemoveAt(Index);
+			continue;
+		}
+
+		const uint32 Version = Spline->SplineCurves.Version;
+		const FTransform& Transform = Spline->GetComponentTransform();
+		if (Version == Placement.PlacedVersion && Transform.Equals(Placement.ComponentTransform))
+		{
+			continue;
+		}
+
+		// Wait for the drag to finish so segments are rebuilt once, not every frame
+		if (Version != Placement.SeenVersion || !Transform.Equals(Placement.SeenTransform))
+		{
+			Placement.SeenVersion = Version;
+			Placement.SeenTransform = Transform;
+			Placement.LastChangeTime = Now;
+			continue;
+		}
+
+		if (Now - Placement.LastChangeTime >= OPMSplineWatch::SettleSeconds)
+		{
+			RegenerateChangedSegments(Placement);
+		}
+	}
+}
+
+TStatId UOPM_SplineWatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOPM_SplineWatchSubsystem, STATGROUP_Tickables);
+}
+
+// Private helper methods
+
+void UOPM_SplineWatchSubsystem::CapturePoints(USplineComponent* SplineComponent, TArray<FPointState>& OutPoints)
+{
+	const FSplineCurves& Curves = SplineComponent->SplineCurves;
+	const int32 NumPoints = Curves.Position.Points.Num();
+
+	OutPoints.SetNum(NumPoints);
+	for (int32 Index = 0; Index < NumPoints; ++Index)
+	{
+		const FInterpCurvePoint<FVector>& Point = Curves.Position.Points[Index];
+
+		FPointState& State = OutPoints[Index];
+		State.Location = Point.OutVal;
+		State.ArriveTangent = Point.ArriveTangent;
+		State.LeaveTangent = Point.LeaveTangent;
+		State.InterpMode = static_cast<uint8>(Point.InterpMode);
+		State.Rotation = Curves.Rotation.Points.IsValidIndex(Index) ? Curves.Rotation.Points[Index].OutVal : FQuat::Identity;
+		State.Scale = Curves.Scale.Points.IsValidIndex(Index) ? Curves.Scale.Points[Index].OutVal : FVector::OneVector;
+	}
+}
+
+int32 UOPM_SplineWatchSubsystem::GetSegmentAtDistance(USplineComponent* SplineComponent, float Distance)
+{
+	const FOPM_SplineCache* Cache = FOPM_SplineCache::Get(SplineComponent);
+	if (!Cache)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 NumPoints = SplineComponent->GetNumberOfSplinePoints();
+	const int32 NumSegments = SplineComponent->IsClosedLoop() ? NumPoints : NumPoints - 1;
+	if (NumSegments <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	return FMath::Clamp(FMath::FloorToInt(Cache->GetInputKeyAtDistance(Distance)), 0, NumSegments - 1);
+}
+
+void UOPM_SplineWatchSubsystem::GetRunDistances(
+	USplineComponent* SplineComponent,
+	const FSplinePlacementSettings& Settings,
+	TOptional<float> PrevAnchor,
+	TOptional<float> NextAnchor,
+	TArray<float>& OutDistances)
+{
+	OutDistances.Reset();
+
+	const float SplineLength = SplineComponent->GetSplineLength();
+	const float Spacing = Settings.Spacing;
+
+	if (Settings.PlacementMode == ESplinePlacementMode::Uniform || Settings.PlacementMode == ESplinePlacementMode::ByDistance)
+	{
+		if (Spacing <= 0.0f)
+		{
+			return;
+		}
+
+		// Between two kept items the gap is split evenly, so the run meets both without a seam
+		if (PrevAnchor.IsSet() && NextAnchor.IsSet())
+		{
+			const float Gap = NextAnchor.GetValue() - PrevAnchor.GetValue();
+			const int32 Count = FMath::Max(FMath::RoundToInt(Gap / Spacing) - 1, 0);
+			const float Step = Gap / (Count + 1);
+			for (int32 Index = 1; Index <= Count; ++Index)
+			{
+				OutDistances.Add(PrevAnchor.GetValue() + Index * Step);
+			}
+		}
+		else if (PrevAnchor.IsSet())
+		{
+			const float EndDistance = SplineLength - Settings.EndOffset;
+			for (float Distance = PrevAnchor.GetValue() + Spacing; Distance <= EndDistance + KINDA_SMALL_NUMBER; Distance += Spacing)
+			{
+				OutDistances.Add(FMath::Min(Distance, EndDistance));
+			}
+		}
+		else if (NextAnchor.IsSet())
+		{
+			// The spline start still gets an item, as it did when first placed
+			const float Gap = NextAnchor.GetValue() - Settings.StartOffset;
+			const int32 Count = FMath::RoundToInt(Gap / Spacing);
+			const float Step = Count > 0 ? Gap / Count : 0.0f;
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				OutDistances.Add(Settings.StartOffset + Index * Step);
+			}
+		}
+		return;
+	}
+
+	// Spline point and adaptive placements depend only on the local curve, so the global distances
+	// are kept, minus those crowding a kept item
+	const float MinGap = Settings.PlacementMode == ESplinePlacementMode::Adaptive ? Spacing * 0.5f : KINDA_SMALL_NUMBER;
+	const int32 NumWraps = SplineComponent->IsClosedLoop() ? 1 : 0;
+
+	for (float Distance : UOPM_SplineUtilities::GetPlacementDistances(SplineComponent, Settings))
+	{
+		for (int32 Wrap = -NumWraps; Wrap <= NumWraps; ++Wrap)
+		{
+			const float Unwrapped = Distance + Wrap * SplineLength;
+			if ((!PrevAnchor.IsSet() || Unwrapped > PrevAnchor.GetValue() + MinGap) &&
+				(!NextAnchor.IsSet() || Unwrapped < NextAnchor.GetValue() - MinGap))
+			{
+				OutDistances.Add(Unwrapped);
+			}
+		}
+	}
+}
+
+void UOPM_SplineWatchSubsystem::RegenerateChangedSegments(FWatchedPlacement& Placement)
+{
+	USplineComponent* Spline = Placement.Spline.Get();
+	UClass* ActorClass = Placement.ActorClass.Get();
+	UWorld* World = Spline ? Spline->GetWorld() : nullptr;
+	if (!World || !ActorClass)
+	{
+		return;
+	}
+
+	TArray<FPointState> NewPoints;
+	CapturePoints(Spline, NewPoints);
+
+	const bool bClosedLoop = Spline->IsClosedLoop();
+	const int32 NumPoints = NewPoints.Num();
+	const int32 NumSegments = bClosedLoop ? NumPoints : FMath::Max(NumPoints - 1, 0);
+
+	// Inserting or removing points renumbers every segment, as does moving the whole spline
+	const bool bAllDirty = NumPoints != Placement.Points.Num() ||
+		bClosedLoop != Placement.bClosedLoop ||
+		!Spline->GetComponentTransform().Equals(Placement.ComponentTransform);
+
+	// A segment changes shape if either of its end points changed (auto tangents already
+	// propagate a moved point to its neighbours' tangents)
+	TBitArray<> DirtySegments(false, NumSegments);
+	bool bAnyDirty = false;
+	for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+	{
+		const int32 Start = Segment;
+		const int32 End = (Segment + 1) % NumPoints;
+		const bool bDirty = bAllDirty ||
+			!NewPoints[Start].Equals(Placement.Points[Start]) ||
+			!NewPoints[End].Equals(Placement.Points[End]);
+
+		DirtySegments[Segment] = bDirty;
+		bAnyDirty |= bDirty;
+	}
+
+	Placement.Points = MoveTemp(NewPoints);
+	Placement.ComponentTransform = Spline->GetComponentTransform();
+	Placement.bClosedLoop = bClosedLoop;
+	Placement.PlacedVersion = Spline->SplineCurves.Version;
+
+	if (!bAnyDirty)
+	{
+		return;
+	}
+
+	FOPM_TransactionScope Transaction(LOCTEXT("RegenerateSplinePlacement", "Regenerate Spline Placement"));
+
+	// Remove items on changed segments, and forget items the user has deleted
+	for (int32 Index = Placement.Items.Num() - 1; Index >= 0; --Index)
+	{
+		const FPlacedItem& Item = Placement.Items[Index];
+		AActor* Actor = Item.Actor.Get();
+		if (!Actor)
+		{
+			Placement.Items.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (!DirtySegments.IsValidIndex(Item.Segment) || DirtySegments[Item.Segment])
+		{
+			Transaction.ModifyActor(Actor);
+			Actor->Destroy();
+			Placement.Items.RemoveAtSwap(Index);
+		}
+	}
+
+	// Segment start distances, unwrapped past the end of a closed loop
+	const float SplineLength = Spline->GetSplineLength();
+	auto GetSegmentStart = [Spline, NumSegments, SplineLength](int32 Segment)
+	{
+		const int32 Wraps = Segment / NumSegments;
+		const int32 Wrapped = Segment % NumSegments;
+		return Spline->GetDistanceAlongSplineAtSplinePoint(Wrapped) + Wraps * SplineLength;
+	};
+
+	// Distances of the kept items, closed loops also see them one lap back and one lap ahead
+	TArray<float> Anchors;
+	for (const FPlacedItem& Item : Placement.Items)
+	{
+		const float Distance = GetSegmentStart(Item.Segment) + Item.Offset;
+		Anchors.Add(Distance);
+		if (bClosedLoop)
+		{
+			Anchors.Add(Distance - SplineLength);
+			Anchors.Add(Distance + SplineLength);
+		}
+	}
+	Anchors.Sort();
+
+	TArray<float> Distances;
+	TArray<int32> Segments;
+	TArray<float> Offsets;
+
+	if (Anchors.Num() == 0)
+	{
+		// Nothing left to line up with, place the changed segments afresh
+		for (float Distance : UOPM_SplineUtilities::GetPlacementDistances(Spline, Placement.Settings))
+		{
+			const int32 Segment = GetSegmentAtDistance(Spline, Distance);
+			if (DirtySegments.IsValidIndex(Segment) && DirtySegments[Segment])
+			{
+				Distances.Add(Distance);
+				Segments.Add(Segment);
+				Offsets.Add(Distance - GetSegmentStart(Segment));
+			}
+		}
+	}
+	else
+	{
+		// Walk runs of consecutive changed segments, a closed loop starts from a kept segment so no
+		// run is split at the seam. Kept items exist, so at least one segment is clean.
+		int32 FirstSegment = 0;
+		if (bClosedLoop)
+		{
+			FirstSegment = DirtySegments.Find(false);
+		}
+
+		TArray<float> RunDistances;
+		for (int32 Step = 0; Step < NumSegments;)
+		{
+			const int32 RunFirst = FirstSegment + Step;
+			if (!DirtySegments[RunFirst % NumSegments])
+			{
+				++Step;
+				continue;
+			}
+
+			int32 RunEnd = RunFirst;
+			while (RunEnd < FirstSegment + NumSegments && DirtySegments[RunEnd % NumSegments])
+			{
+				++RunEnd;
+			}
+			Step += RunEnd - RunFirst;
+
+			const float RunStartDistance = GetSegmentStart(RunFirst);
+			const float RunEndDistance = GetSegmentStart(RunEnd);
+			const bool bRunReachesEnd = !bClosedLoop && RunEnd == NumSegments;
+
+			// Nearest kept items before and after the run
+			TOptional<float> PrevAnchor;
+			TOptional<float> NextAnchor;
+			const int32 PrevIndex = Algo::UpperBound(Anchors, RunStartDistance) - 1;
+			const int32 NextIndex = Algo::LowerBound(Anchors, RunEndDistance);
+			if (Anchors.IsValidIndex(PrevIndex))
+			{
+				PrevAnchor = Anchors[PrevIndex];
+			}
+			if (Anchors.IsValidIndex(NextIndex))
+			{
+				NextAnchor = Anchors[NextIndex];
+			}
+
+			GetRunDistances(Spline, Placement.Settings, PrevAnchor, NextAnchor, RunDistances);
+
+			int32 Segment = RunFirst;
+			for (float Distance : RunDistances)
+			{
+				if (Distance < RunStartDistance || Distance > RunEndDistance || (Distance == RunEndDistance && !bRunReachesEnd))
+				{
+					continue;
+				}
+
+				while (Segment + 1 < RunEnd && Distance >= GetSegmentStart(Segment + 1))
+				{
+					++Segment;
+				}
+
+				Distances.Add(Distance >= SplineLength && bClosedLoop ? Distance - SplineLength : Distance);
+				Segments.Add(Segment % NumSegments);
+				Offsets.Add(Distance - GetSegmentStart(Segment));
+			}
+		}
+	}
+
+	const TArray<FTransform> Transforms = UOPM_SplineUtilities::GenerateTransformsAtDistances(Spline, Distances, Placement.Settings);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	for (int32 Index = 0; Index < Transforms.Num(); ++Index)
+	{
+		const FTransform& Transform = Transforms[Index];
+		AActor* SpawnedActor = World->SpawnActor<AActor>(
+			ActorClass,
+			Transform.GetLocation(),
+			Transform.GetRotation().Rotator(),
+			SpawnParams
+		);
+
+		if (SpawnedActor)
+		{
+			SpawnedActor->SetActorScale3D(Transform.GetScale3D());
+
+			FPlacedItem& Item = Placement.Items.AddDefaulted_GetRef();
+			Item.Actor = SpawnedActor;
+			Item.Segment = Segments[Index];
+			Item.Offset = Offsets[Index];
+			Placement.History.Add(SpawnedActor);
+		}
+	}
+}
+
+void UOPM_SplineWatchSubsystem::RebuildItems(FWatchedPlacement& Placement)
+{
+	Placement.Items.Reset();
+
+	// Destroyed actors stay in the transaction buffer and may come back, only drop collected ones
+	Placement.History.RemoveAll([](const TWeakObjectPtr<AActor>& Actor)
+	{
+		return Actor.IsStale(false);
+	});
+
+	USplineComponent* Spline = Placement.Spline.Get();
+	const int32 NumPoints = Spline ? Spline->GetNumberOfSplinePoints() : 0;
+	const int32 NumSegments = Spline && Spline->IsClosedLoop() ? NumPoints : NumPoints - 1;
+	if (NumSegments <= 0)
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<AActor>& WeakActor : Placement.History)
+	{
+		AActor* Actor = WeakActor.Get();
+		if (!Actor)
+		{
+			continue;
+		}
+
+		const float InputKey = Spline->FindInputKeyClosestToWorldLocation(Actor->GetActorLocation());
+
+		FPlacedItem& Item = Placement.Items.AddDefaulted_GetRef();
+		Item.Actor = Actor;
+		Item.Segment = FMath::Clamp(FMath::FloorToInt(InputKey), 0, NumSegments - 1);
+		Item.Offset = Spline->GetDistanceAlongSplineAtSplineInputKey(InputKey) - Spline->GetDistanceAlongSplineAtSplinePoint(Item.Segment);
+	}
+}
+
+bool UOPM_SplineWatchSubsystem::IsPlacementAlive(const FWatchedPlacement& Placement)
+{
+	for (const TWeakObjectPtr<AActor>& Actor : Placement.History)
+	{
+		if (!Actor.IsStale(false))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UOPM_SplineWatchSubsystem::PrunePlacements()
+{
+	Placements.RemoveAll([](FWatchedPlacement& Placement)
+	{
+		Placement.History.RemoveAll([](const TWeakObjectPtr<AActor>& Actor)
+		{
+			return Actor.IsStale(false);
+		});
+		return Placement.Spline.IsStale(false) || !IsPlacementAlive(Placement);
+	});
+
+	// Placements are appended in order, so the front holds the oldest
+	const int32 Excess = Placements.Num() - OPMSplineWatch::MaxPlacements + 1;
+	if (Excess > 0)
+	{
+		Placements.RemoveAt(0, Excess);
+	}
+}
+
+void UOPM_SplineWatchSubsystem::OnPostUndoRedo()
+{
+	for (FWatchedPlacement& Placement : Placements)
+	{
+		USplineComponent* Spline = Placement.Spline.Get();
+		if (!Spline)
+		{
+			continue;
+		}
+
+		// Take the restored spline as the placed state, so Tick does not regenerate over the undo
+		CapturePoints(Spline, Placement.Points);
+		Placement.ComponentTransform = Spline->GetComponentTransform();
+		Placement.bClosedLoop = Spline->IsClosedLoop();
+		Placement.PlacedVersion = Spline->SplineCurves.Version;
+		Placement.SeenVersion = Placement.PlacedVersion;
+		Placement.SeenTransform = Placement.ComponentTransform;
+
+		RebuildItems(Placement);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
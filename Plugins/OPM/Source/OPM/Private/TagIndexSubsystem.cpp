@@ -0,0 +1,342 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TagIndexSubsystem.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+UOPM_TagIndexSubsystem* UOPM_TagIndexSubsystem::Get()
+{
+	return GEditor ? GEditor->GetEditorSubsystem<UOPM_TagIndexSubsystem>() : nullptr;
+}
+
+void UOPM_TagIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddUObject(this, &UOPM_TagIndexSubsystem::OnLevelActorAdded);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this, &UOPM_TagIndexSubsystem::OnLevelActorDeleted);
+	}
+
+	// World Partition cell loads and level streaming add actors without OnLevelActorAdded
+	LoadedActorAddedHandle = ULevel::OnLoadedActorAddedToLevelEvent.AddUObject(this, &UOPM_TagIndexSubsystem::OnLoadedActorAdded);
+	LoadedActorRemovedHandle = ULevel::OnLoadedActorRemovedFromLevelEvent.AddUObject(this, &UOPM_TagIndexSubsystem::OnLoadedActorRemoved);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UOPM_TagIndexSubsystem::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UOPM_TagIndexSubsystem::OnLevelRemoved);
+
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UOPM_TagIndexSubsystem::OnObjectPropertyChanged);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UOPM_TagIndexSubsystem::OnWorldCleanup);
+
+	// Undo can restore any mix of actors and tags, rebuilding on the next query is simplest
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddUObject(this, &UOPM_TagIndexSubsystem::Invalidate);
+}
+
+void UOPM_TagIndexSubsystem::Deinitialize()
+{
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+
+	ULevel::OnLoadedActorAddedToLevelEvent.Remove(LoadedActorAddedHandle);
+	ULevel::OnLoadedActorRemovedFromLevelEvent.Remove(LoadedActorRemovedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	Invalidate();
+
+	Super::Deinitialize();
+}
+
+int32 UOPM_TagIndexSubsystem::Query(UWorld* World, const FTagQuery& TagQuery, TArray<AActor*>& OutActors)
+{
+	OutActors.Reset();
+
+	if (!World)
+	{
+		return 0;
+	}
+
+	EnsureBuilt(World);
+
+	TBitArray<> Result = LiveSlots;
+
+	for (const FName& Tag : TagQuery.RequireAll)
+	{
+		const TBitArray<>* Bits = TagSlots.Find(Tag);
+		if (!Bits)
+		{
+			return 0;
+		}
+		Result.CombineWithBitwiseAND(*Bits, EBitwiseOperatorFlags::MaintainSize);
+	}
+
+	if (TagQuery.RequireAny.Num() > 0)
+	{
+		TBitArray<> AnyBits;
+		for (const FName& Tag : TagQuery.RequireAny)
+		{
+			if (const TBitArray<>* Bits = TagSlots.Find(Tag))
+			{
+				AnyBits.CombineWithBitwiseOR(*Bits, EBitwiseOperatorFlags::MaxSize);
+			}
+		}
+		Result.CombineWithBitwiseAND(AnyBits, EBitwiseOperatorFlags::MaintainSize);
+	}
+
+	if (TagQuery.Exclude.Num() > 0)
+	{
+		TBitArray<> ExcludeBits(false, Result.Num());
+		for (const FName& Tag : TagQuery.Exclude)
+		{
+			if (const TBitArray<>* Bits = TagSlots.Find(Tag))
+			{
+				ExcludeBits.CombineWithBitwiseOR(*Bits, EBitwiseOperatorFlags::MaintainSize);
+			}
+		}
+		ExcludeBits.BitwiseNOT();
+		Result.CombineWithBitwiseAND(ExcludeBits, EBitwiseOperatorFlags::MaintainSize);
+	}
+
+	for (TConstSetBitIterator<> It(Result); It; ++It)
+	{
+		if (AActor* Actor = Slots[It.GetIndex()].Get())
+		{
+			OutActors.Add(Actor);
+		}
+	}
+
+	return OutActors.Num();
+}
+
+int32 UOPM_TagIndexSubsystem::FindActorsWithTag(UWorld* World, FName Tag, TArray<AActor*>& OutActors)
+{
+	FTagQuery TagQuery;
+	TagQuery.RequireAll.Add(Tag);
+	return Query(World, TagQuery, OutActors);
+}
+
+void UOPM_TagIndexSubsystem::UpdateActor(AActor* Actor)
+{
+	if (!bBuilt || !Actor || Actor->GetWorld() != IndexedWorld.Get())
+	{
+		return;
+	}
+
+	if (const int32* Slot = SlotOfActor.Find(Actor))
+	{
+		SetSlotTags(*Slot, Actor->Tags);
+	}
+	else
+	{
+		AddActor(Actor);
+	}
+}
+
+void UOPM_TagIndexSubsystem::UpdateActors(TArrayView<AActor* const> Actors)
+{
+	for (AActor* Actor : Actors)
+	{
+		UpdateActor(Actor);
+	}
+}
+
+void UOPM_TagIndexSubsystem::Invalidate()
+{
+	IndexedWorld.Reset();
+	bBuilt = false;
+
+	Slots.Empty();
+	SlotTags.Empty();
+	SlotOfActor.Empty();
+	FreeSlots.Empty();
+	LiveSlots.Empty();
+	TagSlots.Empty();
+}
+
+// Private helper methods
+
+void UOPM_TagIndexSubsystem::EnsureBuilt(UWorld* World)
+{
+	if (bBuilt && IndexedWorld.Get() == World)
+	{
+		return;
+	}
+
+	Invalidate();
+	IndexedWorld = World;
+	bBuilt = true;
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AddActor(*It);
+	}
+}
+
+void UOPM_TagIndexSubsystem::AddActor(AActor* Actor)
+{
+	if (SlotOfActor.Contains(Actor))
+	{
+		return;
+	}
+
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(false);
+		Slots[Slot] = Actor;
+	}
+	else
+	{
+		Slot = Slots.Add(Actor);
+		SlotTags.AddDefaulted();
+		LiveSlots.Add(false);
+	}
+
+	SlotOfActor.Add(Actor, Slot);
+	LiveSlots[Slot] = true;
+	SetSlotTags(Slot, Actor->Tags);
+}
+
+void UOPM_TagIndexSubsystem::RemoveActor(AActor* Actor)
+{
+	int32 Slot = INDEX_NONE;
+	if (!SlotOfActor.RemoveAndCopyValue(Actor, Slot))
+	{
+		return;
+	}
+
+	SetSlotTags(Slot, TArray<FName>());
+	Slots[Slot].Reset();
+	LiveSlots[Slot] = false;
+	FreeSlots.Add(Slot);
+}
+
+void UOPM_TagIndexSubsystem::SetSlotTags(int32 Slot, const TArray<FName>& Tags)
+{
+	TArray<FName>& Current = SlotTags[Slot];
+
+	for (const FName& Tag : Current)
+	{
+		if (!Tags.Contains(Tag))
+		{
+			TBitArray<>& Bits = TagSlots.FindChecked(Tag);
+			Bits[Slot] = false;
+		}
+	}
+
+	for (const FName& Tag : Tags)
+	{
+		if (Tag.IsNone() || Current.Contains(Tag))
+		{
+			continue;
+		}
+
+		TBitArray<>& Bits = TagSlots.FindOrAdd(Tag);
+		if (Bits.Num() <= Slot)
+		{
+			Bits.Add(false, Slot + 1 - Bits.Num());
+		}
+		Bits[Slot] = true;
+	}
+
+	Current.Reset(Tags.Num());
+	for (const FName& Tag : Tags)
+	{
+		if (!Tag.IsNone())
+		{
+			Current.AddUnique(Tag);
+		}
+	}
+}
+
+void UOPM_TagIndexSubsystem::OnLevelActorAdded(AActor* Actor)
+{
+	if (bBuilt && Actor && Actor->GetWorld() == IndexedWorld.Get())
+	{
+		AddActor(Actor);
+	}
+}
+
+void UOPM_TagIndexSubsystem::OnLevelActorDeleted(AActor* Actor)
+{
+	if (bBuilt && Actor)
+	{
+		RemoveActor(Actor);
+	}
+}
+
+void UOPM_TagIndexSubsystem::OnLoadedActorAdded(AActor& Actor)
+{
+	OnLevelActorAdded(&Actor);
+}
+
+void UOPM_TagIndexSubsystem::OnLoadedActorRemoved(AActor& Actor)
+{
+	OnLevelActorDeleted(&Actor);
+}
+
+void UOPM_TagIndexSubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (!bBuilt || !Level || World != IndexedWorld.Get())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (IsValid(Actor))
+		{
+			AddActor(Actor);
+		}
+	}
+}
+
+void UOPM_TagIndexSubsystem::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (!bBuilt || World != IndexedWorld.Get())
+	{
+		return;
+	}
+
+	// A null level means every streaming level went away
+	if (!Level)
+	{
+		Invalidate();
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor)
+		{
+			RemoveActor(Actor);
+		}
+	}
+}
+
+void UOPM_TagIndexSubsystem::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	if (Event.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(AActor, Tags))
+	{
+		UpdateActor(Cast<AActor>(Object));
+	}
+}
+
+void UOPM_TagIndexSubsystem::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	if (World == IndexedWorld.Get())
+	{
+		Invalidate();
+	}
+}
@@ -0,0 +1,328 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TerrainSnapSubsystem.h"
+#include "LandscapeIntegrationUtilities.h"
+#include "OPMTransactionUtils.h"
+#include "Landscape.h"
+#include "LandscapeComponent.h"
+#include "LandscapeInfo.h"
+#include "LandscapeProxy.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+
+#define LOCTEXT_NAMESPACE "OPMTerrainSnap"
+
+namespace OPMTerrainSnap
+{
+	/** Spatial hash cell size in world units */
+	constexpr float CellSize = 2000.0f;
+
+	/** Seconds without landscape changes before queued actors are re-aligned */
+	constexpr double SettleSeconds = 0.25;
+
+	/** Re-alignment time budget per editor tick */
+	constexpr double TickBudgetSeconds = 0.002;
+
+	/** Margin added around changed components to cover normal sampling */
+	constexpr float RegionMargin = 100.0f;
+}
+
+UOPM_TerrainSnapSubsystem* UOPM_TerrainSnapSubsystem::Get()
+{
+	return GEditor ? GEditor->GetEditorSubsystem<UOPM_TerrainSnapSubsystem>() : nullptr;
+}
+
+void UOPM_TerrainSnapSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (GEngine)
+	{
+		ActorMovedHandle = GEngine->OnActorMoved().AddUObject(this, &UOPM_TerrainSnapSubsystem::OnActorMoved);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this, &UOPM_TerrainSnapSubsystem::OnLevelActorDeleted);
+	}
+}
+
+void UOPM_TerrainSnapSubsystem::Deinitialize()
+{
+	if (GEngine)
+	{
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+
+	UnbindAll();
+	Records.Empty();
+	Cells.Empty();
+	PendingActors.Empty();
+
+	Super::Deinitialize();
+}
+
+void UOPM_TerrainSnapSubsystem::RegisterActor(AActor* Actor, ALandscape* Landscape, const FLandscapePlacementSettings& Settings)
+{
+	if (!Actor || !Landscape)
+	{
+		return;
+	}
+
+	const FIntPoint Cell = GetCell(Actor->GetActorLocation());
+
+	if (FSnapRecord* Existing = Records.Find(Actor))
+	{
+		RemoveFromCell(Actor, Existing->Cell);
+	}
+
+	FSnapRecord& Record = Records.FindOrAdd(Actor);
+	Record.Landscape = Landscape;
+	Record.Settings = Settings;
+	Record.Cell = Cell;
+	AddToCell(Actor, Cell);
+
+	BindToLandscape(Landscape);
+}
+
+void UOPM_TerrainSnapSubsystem::UnregisterActor(AActor* Actor)
+{
+	FSnapRecord Record;
+	if (Records.RemoveAndCopyValue(Actor, Record))
+	{
+		RemoveFromCell(Actor, Record.Cell);
+	}
+	PendingActors.Remove(Actor);
+}
+
+void UOPM_TerrainSnapSubsystem::QueueRegion(const FBox& Region)
+{
+	if (!Region.IsValid || Records.Num() == 0)
+	{
+		return;
+	}
+
+	// While a sculpt stroke is recording, queued actors join its transaction so undoing the stroke restores them
+	const bool bJoinTransaction = GUndo != nullptr;
+
+	const FIntPoint MinCell = GetCell(Region.Min);
+	const FIntPoint MaxCell = GetCell(Region.Max);
+
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			const TArray<TWeakObjectPtr<AActor>>* CellActors = Cells.Find(FIntPoint(CellX, CellY));
+			if (!CellActors)
+			{
+				continue;
+			}
+
+			for (const TWeakObjectPtr<AActor>& WeakActor : *CellActors)
+			{
+				AActor* Actor = WeakActor.Get();
+				if (!Actor)
+				{
+					continue;
+				}
+
+				const FVector Location = Actor->GetActorLocation();
+				if (Location.X >= Region.Min.X && Location.X <= Region.Max.X &&
+					Location.Y >= Region.Min.Y && Location.Y <= Region.Max.Y)
+				{
+					bool& bRecorded = PendingActors.FindOrAdd(WeakActor, false);
+					if (bJoinTransaction)
+					{
+						// Cheap once the transaction already holds the actor
+						Actor->Modify();
+						bRecorded = true;
+					}
+				}
+			}
+		}
+	}
+
+	LastChangeTime = FPlatformTime::Seconds();
+}
+
+void UOPM_TerrainSnapSubsystem::Tick(float DeltaTime)
+{
+	if (PendingActors.Num() == 0)
+	{
+		return;
+	}
+
+	// Wait for the sculpt stroke to settle so each actor is moved once rather than every frame
+	const double StartTime = FPlatformTime::Seconds();
+	if (StartTime - LastChangeTime < OPMTerrainSnap::SettleSeconds)
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<AActor>> StaleActors;
+
+	// Actors the sculpt transaction did not record are undone as one entry per time slice
+	TOptional<FOPM_TransactionScope> Transaction;
+	TGuardValue<bool> AligningGuard(bAligning, true);
+
+	for (auto It = PendingActors.CreateIterator(); It; ++It)
+	{
+		const TWeakObjectPtr<AActor> WeakActor = It.Key();
+		const bool bRecorded = It.Value();
+		It.RemoveCurrent();
+
+		AActor* Actor = WeakActor.Get();
+		const FSnapRecord* Record = Records.Find(WeakActor);
+		ALandscape* Landscape = Record ? Record->Landscape.Get() : nullptr;
+		if (!Actor || !Landscape)
+		{
+			StaleActors.Add(WeakActor);
+			continue;
+		}
+
+		const FTransform Current = Actor->GetActorTransform();
+		const FTransform Aligned = UOPM_LandscapeIntegrationUtilities::AlignToTerrain(Current, Landscape, Record->Settings);
+		if (!Aligned.Equals(Current, KINDA_SMALL_NUMBER))
+		{
+			if (!bRecorded)
+			{
+				if (!Transaction.IsSet())
+				{
+					Transaction.Emplace(LOCTEXT("SnapActorsToTerrain", "Snap Actors To Terrain"));
+				}
+				Transaction->ModifyActor(Actor);
+			}
+			Actor->SetActorLocationAndRotation(Aligned.GetLocation(), Aligned.GetRotation());
+		}
+
+		if (FPlatformTime::Seconds() - StartTime > OPMTerrainSnap::TickBudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	for (const TWeakObjectPtr<AActor>& WeakActor : StaleActors)
+	{
+		FSnapRecord Record;
+		if (Records.RemoveAndCopyValue(WeakActor, Record))
+		{
+			RemoveFromCell(WeakActor.Get(), Record.Cell);
+		}
+	}
+}
+
+TStatId UOPM_TerrainSnapSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOPM_TerrainSnapSubsystem, STATGROUP_Tickables);
+}
+
+// Private helper methods
+
+FIntPoint UOPM_TerrainSnapSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt(Location.X / OPMTerrainSnap::CellSize),
+		FMath::FloorToInt(Location.Y / OPMTerrainSnap::CellSize));
+}
+
+void UOPM_TerrainSnapSubsystem::AddToCell(AActor* Actor, const FIntPoint& Cell)
+{
+	Cells.FindOrAdd(Cell).AddUnique(Actor);
+}
+
+void UOPM_TerrainSnapSubsystem::RemoveFromCell(AActor* Actor, const FIntPoint& Cell)
+{
+	if (TArray<TWeakObjectPtr<AActor>>* CellActors = Cells.Find(Cell))
+	{
+		// Drop the actor and any entries whose actor has since been destroyed
+		CellActors->RemoveAllSwap([Actor](const TWeakObjectPtr<AActor>& WeakActor)
+		{
+			return !WeakActor.IsValid() || WeakActor.Get() == Actor;
+		});
+
+		if (CellActors->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void UOPM_TerrainSnapSubsystem::BindToLandscape(ALandscape* Landscape)
+{
+#if WITH_EDITOR
+	ULandscapeInfo* LandscapeInfo = Landscape ? Landscape->GetLandscapeInfo() : nullptr;
+	if (!LandscapeInfo)
+	{
+		return;
+	}
+
+	// Also picks up streaming proxies loaded since the last registration
+	LandscapeInfo->ForEachLandscapeProxy([this](ALandscapeProxy* Proxy)
+	{
+		const bool bAlreadyBound = ProxyBindings.ContainsByPredicate([Proxy](const TPair<TWeakObjectPtr<ALandscapeProxy>, FDelegateHandle>& Binding)
+		{
+			return Binding.Key.Get() == Proxy;
+		});
+
+		if (!bAlreadyBound)
+		{
+			FDelegateHandle Handle = Proxy->OnComponentDataChanged().AddUObject(this, &UOPM_TerrainSnapSubsystem::OnComponentDataChanged);
+			ProxyBindings.Emplace(Proxy, Handle);
+		}
+		return true;
+	});
+#endif
+}
+
+void UOPM_TerrainSnapSubsystem::UnbindAll()
+{
+#if WITH_EDITOR
+	for (const TPair<TWeakObjectPtr<ALandscapeProxy>, FDelegateHandle>& Binding : ProxyBindings)
+	{
+		if (ALandscapeProxy* Proxy = Binding.Key.Get())
+		{
+			Proxy->OnComponentDataChanged().Remove(Binding.Value);
+		}
+	}
+#endif
+	ProxyBindings.Empty();
+}
+
+void UOPM_TerrainSnapSubsystem::OnComponentDataChanged(ALandscapeProxy* Proxy, const FLandscapeProxyComponentDataChangedParams& Params)
+{
+	// Undo and redo restore the recorded actors together with the terrain
+	if (GIsTransacting)
+	{
+		return;
+	}
+
+	FBox ChangedRegion(ForceInit);
+	Params.ForEachComponent([&ChangedRegion](const ULandscapeComponent* Component)
+	{
+		if (Component)
+		{
+			ChangedRegion += Component->Bounds.GetBox();
+		}
+	});
+
+	if (ChangedRegion.IsValid)
+	{
+		QueueRegion(ChangedRegion.ExpandBy(OPMTerrainSnap::RegionMargin));
+	}
+}
+
+void UOPM_TerrainSnapSubsystem::OnActorMoved(AActor* Actor)
+{
+	// An actor the user places by hand is theirs now, re-register it to snap it again
+	if (!bAligning && Actor && Records.Contains(Actor))
+	{
+		UnregisterActor(Actor);
+	}
+}
+
+void UOPM_TerrainSnapSubsystem::OnLevelActorDeleted(AActor* Actor)
+{
+	if (Actor && Records.Contains(Actor))
+	{
+		UnregisterActor(Actor);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
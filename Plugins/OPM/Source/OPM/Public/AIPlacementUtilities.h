@@ -18,7 +18,7 @@ public:
 	 * @param Actors Array of actors to analyze
 	 * @return Detected pattern type
 	 */
-	static EAIPatternType DetectPlacementPattern(const TArray<AActor*>& Actors);
+	static EAIPatternType DetectPlacementPattern(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Generate smart placement suggestions based on existing actors
@@ -28,7 +28,7 @@ public:
 	 * @return Number of suggestions generated
 	 */
 	static int32 GenerateSmartSuggestions(
-		const TArray<AActor*>& ExistingActors,
+		TArrayView<AActor* const> ExistingActors,
 		const FAIPlacementSettings& Settings,
 		TArray<FTransform>& SuggestedTransforms);
 
@@ -39,7 +39,7 @@ public:
 	 * @return Array of optimized transforms (same order as input actors)
 	 */
 	static TArray<FTransform> OptimizeActorPlacement(
-		const TArray<AActor*>& Actors,
+		TArrayView<AActor* const> Actors,
 		const FAIPlacementSettings& Settings);
 
 	/**
@@ -47,7 +47,7 @@ public:
 	 * @param Actors Actors to analyze
 	 * @return Density value (higher = more clustered)
 	 */
-	static float CalculateClusteringDensity(const TArray<AActor*>& Actors);
+	static float CalculateClusteringDensity(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Find optimal spacing between actors based on their bounds
@@ -66,7 +66,7 @@ public:
 	 * @return Number of overlaps detected and corrected
 	 */
 	static int32 DetectAndCorrectOverlaps(
-		const TArray<AActor*>& Actors,
+		TArrayView<AActor* const> Actors,
 		TArray<FTransform>& CorrectedTransforms);
 
 	/**
@@ -88,7 +88,7 @@ public:
 	 * @return Suggested LOD distances for each actor
 	 */
 	static TArray<float> SuggestLODSettings(
-		const TArray<AActor*>& Actors,
+		TArrayView<AActor* const> Actors,
 		EAIOptimizationGoal OptimizationGoal);
 
 	/**
@@ -96,7 +96,7 @@ public:
 	 * @param Actors Actors to evaluate
 	 * @return Quality score (0.0 = poor, 1.0 = excellent)
 	 */
-	static float EvaluatePlacementQuality(const TArray<AActor*>& Actors);
+	static float EvaluatePlacementQuality(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Auto-balance actor distribution in a given area
@@ -105,29 +105,29 @@ public:
 	 * @return Array of balanced transforms
 	 */
 	static TArray<FTransform> AutoBalanceDistribution(
-		const TArray<AActor*>& Actors,
+		TArrayView<AActor* const> Actors,
 		const FBox& BoundsBox);
 
 private:
 	/**
 	 * Calculate variance in actor spacing
 	 */
-	static float CalculateSpacingVariance(const TArray<AActor*>& Actors);
+	static float CalculateSpacingVariance(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Detect linear patterns in actor placement
 	 */
-	static bool DetectLinearPattern(const TArray<AActor*>& Actors, float Tolerance = 50.0f);
+	static bool DetectLinearPattern(TArrayView<AActor* const> Actors, float Tolerance = 50.0f);
 
 	/**
 	 * Detect radial patterns in actor placement
 	 */
-	static bool DetectRadialPattern(const TArray<AActor*>& Actors, float Tolerance = 50.0f);
+	static bool DetectRadialPattern(TArrayView<AActor* const> Actors, float Tolerance = 50.0f);
 
 	/**
 	 * Calculate centroid of actor positions
 	 */
-	static FVector CalculateCentroid(const TArray<AActor*>& Actors);
+	static FVector CalculateCentroid(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Apply jitter to make placement look more organic
@@ -5,6 +5,11 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+class UStaticMeshComponent;
+class UMaterialInterface;
+
 /**
  * Utility class for replacing actors while preserving transforms and properties
  */
@@ -29,6 +34,9 @@ public:
 
 	/**
 	 * Batch replace multiple actors with new actor class
+	 * Editable properties that the old and new classes share by name and type are copied through a
+	 * plan cached per class pair, before the new actor's construction script runs. Attachments are
+	 * rewired in one pass once every replacement exists.
 	 * @param OldActors Array of actors to replace
 	 * @param NewActorClass Class of new actor to spawn
 	 * @param World World to spawn in
@@ -37,12 +45,47 @@ public:
 	 * @return Array of newly spawned actors
 	 */
 	static TArray<AActor*> BatchReplaceActors(
-		TArray<AActor*> OldActors,
+		TArrayView<AActor* const> OldActors,
 		UClass* NewActorClass,
 		UWorld* World,
 		bool bPreserveTransform = true,
 		bool bPreserveAttachments = false);
 
+	/**
+	 * Collapse static mesh actors into instanced static mesh components
+	 * Actors are grouped by mesh and material overrides and each group becomes one component on a
+	 * single new host actor, then the source actors are destroyed. Labels, tags and any components
+	 * other than the mesh are not kept. Actors that hold anything but one static mesh are skipped.
+	 * @param Actors Actors to convert
+	 * @param World World to spawn the host in
+	 * @param bHierarchical Use hierarchical instanced components, which cull and LOD per cluster
+	 * @return Host actor holding the instances, or nullptr if nothing was converted
+	 */
+	static AActor* ConvertActorsToInstances(
+		TArrayView<AActor* const> Actors,
+		UWorld* World,
+		bool bHierarchical = true);
+
+	/**
+	 * Break instances back out into static mesh actors for hand editing
+	 * Painted foliage is rejected, its instances belong to the foliage actor's bookkeeping.
+	 * @param Component Instanced component holding the instances
+	 * @param InstanceIndices Instances to convert, or the instances selected in the editor when empty
+	 * @param World World to spawn the actors in
+	 * @param bAllInstances Convert every instance, ignoring InstanceIndices and the selection
+	 * @return Spawned actors, in instance order; empty when nothing was given, selected or convertible
+	 */
+	static TArray<AActor*> ConvertInstancesToActors(
+		UInstancedStaticMeshComponent* Component,
+		TArrayView<const int32> InstanceIndices,
+		UWorld* World,
+		bool bAllInstances = false);
+
+	/**
+	 * Release the cached property copy plans and their invalidation hooks (called on module shutdown)
+	 */
+	static void ReleaseCopyPlans();
+
 	/**
 	 * Copy transform from one actor to another
 	 * @param SourceActor Actor to copy from
@@ -63,4 +106,8 @@ public:
 	 * @param TargetActor Actor to copy to
 	 */
 	static void CopyAttachments(AActor* SourceActor, AActor* TargetActor);
+
+private:
+	/** Helper to find the only primitive of an actor when it is a plain static mesh component */
+	static UStaticMeshComponent* GetSoleStaticMeshComponent(AActor* Actor);
 };
@@ -19,7 +19,7 @@ public:
 	 * @param Axis Alignment axis (X, Y, or Z)
 	 */
 	static void AlignActors(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		EAlignmentType Type,
 		EAlignmentAxis Axis);
 
@@ -27,55 +27,55 @@ public:
 	 * Align actors to the left (minimum X)
 	 * @param Actors Array of actors to align
 	 */
-	static void AlignActorsLeft(TArray<AActor*> Actors);
+	static void AlignActorsLeft(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Align actors to the right (maximum X)
 	 * @param Actors Array of actors to align
 	 */
-	static void AlignActorsRight(TArray<AActor*> Actors);
+	static void AlignActorsRight(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Align actors to the top (maximum Z)
 	 * @param Actors Array of actors to align
 	 */
-	static void AlignActorsTop(TArray<AActor*> Actors);
+	static void AlignActorsTop(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Align actors to the bottom (minimum Z)
 	 * @param Actors Array of actors to align
 	 */
-	static void AlignActorsBottom(TArray<AActor*> Actors);
+	static void AlignActorsBottom(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Align actors to the front (minimum Y)
 	 * @param Actors Array of actors to align
 	 */
-	static void AlignActorsFront(TArray<AActor*> Actors);
+	static void AlignActorsFront(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Align actors to the back (maximum Y)
 	 * @param Actors Array of actors to align
 	 */
-	static void AlignActorsBack(TArray<AActor*> Actors);
+	static void AlignActorsBack(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Center actors on X axis
 	 * @param Actors Array of actors to center
 	 */
-	static void CenterActorsX(TArray<AActor*> Actors);
+	static void CenterActorsX(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Center actors on Y axis
 	 * @param Actors Array of actors to center
 	 */
-	static void CenterActorsY(TArray<AActor*> Actors);
+	static void CenterActorsY(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Center actors on Z axis
 	 * @param Actors Array of actors to center
 	 */
-	static void CenterActorsZ(TArray<AActor*> Actors);
+	static void CenterActorsZ(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Distribute actors evenly
@@ -83,34 +83,34 @@ public:
 	 * @param Type Distribution type (horizontal, vertical, radial)
 	 */
 	static void DistributeActors(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		EDistributionType Type);
 
 	/**
 	 * Distribute actors horizontally (X axis)
 	 * @param Actors Array of actors to distribute
 	 */
-	static void DistributeActorsHorizontally(TArray<AActor*> Actors);
+	static void DistributeActorsHorizontally(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Distribute actors vertically (Z axis)
 	 * @param Actors Array of actors to distribute
 	 */
-	static void DistributeActorsVertically(TArray<AActor*> Actors);
+	static void DistributeActorsVertically(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Get the combined bounds of all actors
 	 * @param Actors Array of actors
 	 * @return Bounding box containing all actors
 	 */
-	static FBox GetActorsBounds(const TArray<AActor*>& Actors);
+	static FBox GetActorsBounds(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Get the center point of all actors
 	 * @param Actors Array of actors
 	 * @return Center point
 	 */
-	static FVector GetActorsCenter(const TArray<AActor*>& Actors);
+	static FVector GetActorsCenter(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Snap actor location to grid
@@ -124,5 +124,39 @@ public:
 	 * @param Actors Array of actors to snap
 	 * @param GridSize Grid size for snapping
 	 */
-	static void SnapActorsToGrid(TArray<AActor*> Actors, float GridSize);
+	static void SnapActorsToGrid(TArrayView<AActor* const> Actors, float GridSize);
+
+	/**
+	 * Move many actors at once
+	 * Root components are repositioned first and their world transforms refreshed in a second pass,
+	 * skipping the sweep SetActorLocation runs per actor. Attached actors are then moved parent first,
+	 * overlaps are refreshed once per moved hierarchy and viewports are redrawn once at the end.
+	 * @param Actors Actors to move
+	 * @param Locations New world location of each actor
+	 */
+	static void CommitActorLocations(
+		TArrayView<AActor* const> Actors,
+		TArrayView<const FVector> Locations);
+
+private:
+	/** Valid actors with their location and bounds, read once before an operation */
+	struct FActorSnapshot
+	{
+		TArray<AActor*> Actors;
+		TArray<FVector> Locations;
+		TArray<FBox> Bounds;
+		FBox CombinedBounds = FBox(ForceInit);
+	};
+
+	/** Helper to capture actor locations and bounds */
+	static void CaptureSnapshot(TArrayView<AActor* const> Actors, FActorSnapshot& OutSnapshot);
+
+	/**
+	 * Helper to line up the same relative point of every actor's bounds on one axis
+	 * @param Anchor Point within the bounds along the axis (0 = min, 0.5 = center, 1 = max)
+	 */
+	static void AlignToAnchor(TArrayView<AActor* const> Actors, int32 Axis, float Anchor);
+
+	/** Helper to space actor locations evenly across the combined bounds on one axis */
+	static void DistributeAlongAxis(TArrayView<AActor* const> Actors, int32 Axis);
 };
@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Catenary solver for hanging cables between supports
+ * Each span hangs in the vertical plane through its two supports as y = a (cosh((x - x0) / a) - cosh(x0 / a)).
+ * The catenary parameter a is the ratio of horizontal tension to cable weight per unit length, and is
+ * either given directly or solved from a midpoint sag. Spans are solved and densified in parallel.
+ */
+struct OPM_API FOPM_CatenarySolver
+{
+	/**
+	 * Solve spans for a midpoint sag and densify them into polylines
+	 * @param Starts Start support of each span
+	 * @param Ends End support of each span (same count as Starts)
+	 * @param Sag Drop below the straight chord at the middle of each span (0 = straight)
+	 * @param PointsPerSpan Polyline segments per span
+	 * @param OutPoints Output points, PointsPerSpan + 1 per span laid out span after span
+	 */
+	static void SolveForSag(
+		TArrayView<const FVector> Starts,
+		TArrayView<const FVector> Ends,
+		float Sag,
+		int32 PointsPerSpan,
+		TArray<FVector>& OutPoints);
+
+	/**
+	 * Solve spans for a catenary parameter and densify them into polylines
+	 * @param Starts Start support of each span
+	 * @param Ends End support of each span (same count as Starts)
+	 * @param TensionRatio Horizontal tension divided by weight per unit length (larger = tighter)
+	 * @param PointsPerSpan Polyline segments per span
+	 * @param OutPoints Output points, PointsPerSpan + 1 per span laid out span after span
+	 */
+	static void SolveForTension(
+		TArrayView<const FVector> Starts,
+		TArrayView<const FVector> Ends,
+		float TensionRatio,
+		int32 PointsPerSpan,
+		TArray<FVector>& OutPoints);
+
+	/**
+	 * Find the catenary parameter giving a midpoint sag for one span
+	 * @param Span Horizontal distance between supports
+	 * @param Rise Height of the end support above the start support
+	 * @param Sag Drop below the chord at the middle of the span
+	 * @return Catenary parameter, or 0 for a straight span
+	 */
+	static double SolveParameterForSag(double Span, double Rise, double Sag);
+
+private:
+	/** Helper to densify spans given a per-span parameter source */
+	template<typename ParameterFunc>
+	static void Densify(
+		TArrayView<const FVector> Starts,
+		TArrayView<const FVector> Ends,
+		int32 PointsPerSpan,
+		ParameterFunc&& GetParameter,
+		TArray<FVector>& OutPoints);
+
+	/** Helper to get the horizontal offset of the catenary's lowest point */
+	static double GetVertexOffset(double Span, double Rise, double Parameter);
+};
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UWorld;
+class ULevel;
+class UFoliageType;
+class AInstancedFoliageActor;
+
+/**
+ * Per-world spatial index over painted foliage instances
+ * Buckets the instances of each foliage type into a sparse hash of small fixed-size cells. Queries
+ * count cells wholly inside the rectangle in full and test the instances of the border cells one by
+ * one, so counts are exact and cost scales with the query area rather than the map size.
+ */
+class OPM_API FOPM_FoliageSpatialIndex
+{
+public:
+	explicit FOPM_FoliageSpatialIndex(UWorld* InWorld);
+	~FOPM_FoliageSpatialIndex();
+
+	/**
+	 * Get the foliage index for a world, building it on first use and
+	 * rebuilding any foliage types that changed since the last query
+	 * @param World World whose foliage to index
+	 * @return Up-to-date index, or nullptr if World is null
+	 */
+	static FOPM_FoliageSpatialIndex* Get(UWorld* World);
+
+	/**
+	 * Release all cached indices (called on module shutdown)
+	 */
+	static void ReleaseAll();
+
+	/**
+	 * Bring the cells of foliage types marked dirty up to date. Must be called on the game thread.
+	 */
+	void Update();
+
+	/**
+	 * Get foliage density around a location. Safe to call from worker threads after Update().
+	 * @param Location Location to check (X, Y will be used)
+	 * @param Radius Half-size of the square query area
+	 * @return Foliage density (0.0 = no foliage, 1.0 = covered at each type's painted spacing)
+	 */
+	float GetDensity(const FVector& Location, float Radius) const;
+
+	/**
+	 * Count foliage instances of all types around a location
+	 * @param Location Location to check (X, Y will be used)
+	 * @param Radius Half-size of the square query area
+	 * @return Number of instances in the query area
+	 */
+	int32 CountInstances(const FVector& Location, float Radius) const;
+
+	/**
+	 * Mark a foliage type for update on the next Update()
+	 * @param FoliageType Foliage type whose instances changed
+	 */
+	void Invalidate(const UFoliageType* FoliageType);
+
+	/**
+	 * Mark every foliage type for update and rescan the world for new types
+	 */
+	void InvalidateAll();
+
+private:
+	/** Instance locations of one foliage type bucketed into grid cells */
+	struct FTypeGrid
+	{
+		/** Locations per occupied cell, only cells holding instances are stored */
+		TMap<FIntPoint, TArray<FVector2D>> Cells;
+
+		/** Locations last read from each foliage actor, in FFoliageInfo::Instances order */
+		TMap<TObjectKey<AInstancedFoliageActor>, TArray<FVector2D>> SourceLocations;
+
+		/** Area one instance covers at the type's painted spacing */
+		float InstanceFootprint = 0.0f;
+
+		bool bDirty = true;
+
+		int32 CountInRect(const FVector2D& Min, const FVector2D& Max) const;
+		void AddLocation(const FVector2D& Location);
+		void RemoveLocation(const FVector2D& Location);
+	};
+
+	/**
+	 * Helper to apply the instances added, moved or removed since the last update to a type's cells
+	 * Rereads every instance of the type in every foliage actor, only the cell writes are incremental.
+	 */
+	void UpdateType(const UFoliageType* FoliageType, FTypeGrid& Grid) const;
+	void DiscoverTypes();
+	void OnInstanceCountChanged(const UFoliageType* FoliageType);
+	void OnLevelChanged(ULevel* Level, UWorld* InWorld);
+
+	TWeakObjectPtr<UWorld> World;
+	TMap<TObjectKey<UFoliageType>, FTypeGrid> Grids;
+	bool bNeedsDiscovery = true;
+
+	FDelegateHandle InstanceCountChangedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
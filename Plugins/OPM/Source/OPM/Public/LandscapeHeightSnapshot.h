@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ALandscape;
+
+/**
+ * Immutable CPU copy of landscape heights over an area
+ * Captured with one bulk heightmap read, after which height, normal and contour queries
+ * are plain grid math that is safe to run from worker threads. Samples on components that are
+ * not loaded are holes: queries touching them fail so callers can fall back to another source.
+ */
+struct OPM_API FOPM_LandscapeHeightSnapshot
+{
+	/**
+	 * Capture landscape heights covering a world-space area
+	 * @param Landscape Landscape to capture
+	 * @param Bounds World-space area to capture (X, Y will be used)
+	 * @param MaxResolution Maximum samples per axis, larger areas are captured at a coarser stride
+	 * @return True if any part of the area lies on a loaded landscape component
+	 */
+	bool Capture(ALandscape* Landscape, const FBox& Bounds, int32 MaxResolution = 2048);
+
+	/**
+	 * Check whether the snapshot holds any data
+	 */
+	bool IsValid() const { return SizeX >= 2 && SizeY >= 2; }
+
+	/**
+	 * Sample the world height at a location (bilinear)
+	 * @param Location World location (X, Y will be used)
+	 * @param OutHeight Output world height
+	 * @return True if the location lies inside the snapshot on loaded components
+	 */
+	bool SampleHeight(const FVector& Location, float& OutHeight) const;
+
+	/**
+	 * Sample the surface normal at a location from height differences
+	 * @param Location World location (X, Y will be used)
+	 * @param OutNormal Output world normal
+	 * @return True if the location lies inside the snapshot on loaded components
+	 */
+	bool SampleNormal(const FVector& Location, FVector& OutNormal) const;
+
+	/**
+	 * Extract iso-height contour polylines with marching squares
+	 * Tiles of the grid are processed in parallel, then segments are stitched into polylines.
+	 * Contours stop at holes. Closed contours repeat their first point at the end.
+	 * @param IsoHeight World height of the contour
+	 * @param OutLines Output polylines in world space
+	 */
+	void ExtractIsoLines(float IsoHeight, TArray<TArray<FVector>>& OutLines) const;
+
+	/** Landscape actor transform (quad space to world) */
+	FTransform LandscapeTransform;
+
+	/** Landscape quad coordinate of sample (0, 0) */
+	FIntPoint Origin = FIntPoint::ZeroValue;
+
+	/** Landscape quads between neighbouring samples */
+	int32 Stride = 1;
+
+	/** Number of samples per axis */
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+
+	/** World heights, row-major SizeX * SizeY */
+	TArray<float> Heights;
+
+	/** Whether each sample lies on a loaded landscape component, row-major SizeX * SizeY */
+	TBitArray<> Loaded;
+
+private:
+	/** Convert a world location to fractional sample coordinates */
+	FVector2D WorldToGrid(const FVector& Location) const;
+
+	/** Convert fractional sample coordinates and a height to a world location */
+	FVector GridToWorld(float GridX, float GridY, float Height) const;
+
+	float GetHeight(int32 X, int32 Y) const { return Heights[Y * SizeX + X]; }
+	bool IsLoaded(int32 X, int32 Y) const { return Loaded[Y * SizeX + X]; }
+};
@@ -7,6 +7,8 @@
 #include "GameFramework/Actor.h"
 #include "Landscape.h"
 
+class FOPM_LandscapeWeightmapCache;
+
 /**
  * Utility class for landscape-aware placement operations
  * Provides terrain-aware placement, foliage integration, and biome-based distribution
@@ -21,6 +23,7 @@ public:
 	 * @param Landscape Landscape actor to place on
 	 * @param Settings Landscape placement settings
 	 * @param World World to spawn actors in
+	 * @param bKeepOnTerrain Re-align the actors when the landscape under them is sculpted later
 	 * @return Array of spawned actors
 	 */
 	static TArray<AActor*> PlaceActorsOnLandscape(
@@ -28,10 +31,12 @@ public:
 		const TArray<FTransform>& Transforms,
 		ALandscape* Landscape,
 		const FLandscapePlacementSettings& Settings,
-		UWorld* World);
+		UWorld* World,
+		bool bKeepOnTerrain = false);
 
 	/**
 	 * Sample landscape height at a given location
+	 * Regions of a World Partition landscape that are not loaded are read through FOPM_LandscapeTileCache
 	 * @param Landscape Landscape to sample
 	 * @param Location Location to sample (X, Y will be used)
 	 * @param OutHeight Output height value
@@ -64,6 +69,21 @@ public:
 		ALandscape* Landscape,
 		const FVector& Location);
 
+	/**
+	 * Sample the weight of a landscape paint layer at a given location
+	 * The layer is decoded once into FOPM_LandscapeWeightmapCache, later samples are raster lookups
+	 * @param Landscape Landscape to sample
+	 * @param LayerName Paint layer to sample (e.g. Grass, Rock, Road)
+	 * @param Location Location to sample (X, Y will be used)
+	 * @param OutWeight Output weight (0.0 - 1.0)
+	 * @return True if sampling was successful
+	 */
+	static bool SampleLandscapeLayerWeight(
+		ALandscape* Landscape,
+		FName LayerName,
+		const FVector& Location,
+		float& OutWeight);
+
 	/**
 	 * Adjust transform to align with terrain
 	 * @param Transform Original transform
@@ -104,6 +124,7 @@ public:
 
 	/**
 	 * Generate placement pattern that follows terrain contours
+	 * Extracts the iso-line through StartLocation's height and resamples it at exact spacing
 	 * @param Landscape Landscape to follow
 	 * @param StartLocation Starting location
 	 * @param Count Number of points to generate
@@ -119,7 +140,20 @@ public:
 		const FLandscapePlacementSettings& Settings);
 
 	/**
-	 * Integrate with foliage system by checking foliage density
+	 * Extract terrain contour lines at a given height (marching squares over a height snapshot)
+	 * @param Landscape Landscape to analyze
+	 * @param BoundsBox Area to extract contours in
+	 * @param Height World height of the contour
+	 * @return Contour polylines, closed contours repeat their first point at the end
+	 */
+	static TArray<TArray<FVector>> ExtractContourLines(
+		ALandscape* Landscape,
+		const FBox& BoundsBox,
+		float Height);
+
+	/**
+	 * Get density of painted foliage instances around a location
+	 * Backed by FOPM_FoliageSpatialIndex, so each query only visits the cells under the radius
 	 * @param Landscape Landscape to check
 	 * @param Location Location to check foliage
 	 * @param Radius Radius to check
@@ -205,6 +239,30 @@ private:
 		float Slope,
 		const FLandscapePlacementSettings& Settings);
 
+	/**
+	 * Resample a polyline into points at exact arc-length spacing, starting at its first point
+	 */
+	static TArray<FVector> ResamplePolyline(
+		const TArray<FVector>& Polyline,
+		float Spacing,
+		int32 MaxPoints);
+
+	/**
+	 * Check if location meets paint layer requirements
+	 */
+	static bool MeetsLayerRequirements(
+		ALandscape* Landscape,
+		const FOPM_LandscapeWeightmapCache* WeightmapCache,
+		const FVector& Location,
+		const FLandscapePlacementSettings& Settings);
+
+	/**
+	 * Get the weightmap cache with all layers used by the settings decoded (nullptr if no layer rules)
+	 */
+	static const FOPM_LandscapeWeightmapCache* PrepareWeightmapCache(
+		ALandscape* Landscape,
+		const FLandscapePlacementSettings& Settings);
+
 	/**
 	 * Get biome-specific distribution parameters
 	 */
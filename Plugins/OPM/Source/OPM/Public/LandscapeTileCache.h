@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class ALandscape;
+class ALandscapeProxy;
+struct FLandscapeProxyComponentDataChangedParams;
+
+/**
+ * Out-of-core height and weight cache for World Partition landscapes
+ * Regions whose streaming proxies are not loaded are read tile by tile: the proxy is pinned only
+ * while the heightmap or paint layers a tile is missing are decoded, then released again. Heights
+ * and each layer are cached independently, so requesting a new layer never discards decoded data.
+ * Pinning goes through World Partition, so a tile miss costs a full load of the proxy actor.
+ * Decoded tiles are kept in an LRU cache bounded by OPM.LandscapeTileCacheBudgetMB. A tile is
+ * evicted when its proxy is edited, loaded or unloaded in the editor, and the tile set is gathered
+ * again when streaming proxies are added or deleted.
+ */
+class OPM_API FOPM_LandscapeTileCache
+{
+public:
+	explicit FOPM_LandscapeTileCache(ALandscape* InLandscape);
+	~FOPM_LandscapeTileCache();
+
+	/**
+	 * Get the tile cache for a landscape
+	 * @param Landscape Landscape to cache
+	 * @return Cache for the landscape, or nullptr if the landscape is null or not partitioned
+	 */
+	static FOPM_LandscapeTileCache* Get(ALandscape* Landscape);
+
+	/**
+	 * Release all cached tiles (called on module shutdown)
+	 */
+	static void ReleaseAll();
+
+	/**
+	 * Sample the world height at a location, streaming its tile in if needed. Game thread only.
+	 * @param Location World location (X, Y will be used)
+	 * @param OutHeight Output world height
+	 * @return True if a streaming proxy covers the location
+	 */
+	bool SampleHeight(const FVector& Location, float& OutHeight);
+
+	/**
+	 * Sample a paint layer weight at a location, streaming its tile in if needed. Game thread only.
+	 * Tiles already holding other data only decode the missing layer.
+	 * @param LayerName Paint layer to sample
+	 * @param Location World location (X, Y will be used)
+	 * @param OutWeight Output weight (0.0 - 1.0)
+	 * @return True if a streaming proxy covers the location
+	 */
+	bool SampleWeight(FName LayerName, const FVector& Location, float& OutWeight);
+
+	/**
+	 * Get the memory currently held by decoded tiles
+	 */
+	int64 GetAllocatedBytes() const { return AllocatedBytes; }
+
+private:
+	/** Streaming proxy region and its decoded data, if resident */
+	struct FTile
+	{
+		FGuid ProxyGuid;
+
+		/** Proxy extent in landscape quads (inclusive) */
+		FIntRect QuadRect;
+
+		TArray<uint16> Heights;
+		TMap<FName, TArray<uint8>> Weights;
+
+		uint64 LastUsed = 0;
+		int64 AllocatedBytes = 0;
+
+		bool IsResident() const { return Heights.Num() > 0 || Weights.Num() > 0; }
+		int32 GetWidth() const { return QuadRect.Width() + 1; }
+		int32 GetHeight() const { return QuadRect.Height() + 1; }
+	};
+
+	void GatherTiles();
+	FTile* FindTile(const FVector& Location, FVector2D& OutQuadCoords);
+	FTile* FindTileByProxy(const FGuid& ProxyGuid);
+	bool MakeResident(FTile& Tile, FName RequiredLayer);
+	void Evict(FTile& Tile);
+	void EnforceBudget(const FTile* Keep);
+
+	bool IsOwnProxy(const ALandscapeProxy* Proxy) const;
+	void BindToProxy(ALandscapeProxy* Proxy);
+	void UnbindFromProxy(ALandscapeProxy* Proxy);
+	void UnbindAll();
+
+	/** Helper to evict the tile of a proxy the editor loaded, unloaded or edited */
+	void EvictProxy(const ALandscapeProxy* Proxy);
+
+	void OnComponentDataChanged(ALandscapeProxy* Proxy, const FLandscapeProxyComponentDataChangedParams& Params);
+	void OnLoadedActorAdded(AActor& Actor);
+	void OnLoadedActorRemoved(AActor& Actor);
+	void OnLevelActorAdded(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+
+	template<typename T>
+	static float SampleBilinear(const TArray<T>& Data, const FTile& Tile, const FVector2D& QuadCoords);
+
+	TWeakObjectPtr<ALandscape> Landscape;
+	FTransform LandscapeTransform;
+
+	TArray<FTile> Tiles;
+
+	/** Tile lookup by (quad / TileSizeQuads) grid coordinate */
+	TMap<FIntPoint, int32> TileGrid;
+	int32 TileSizeQuads = 0;
+
+	/** Paint layers requested so far, a tile pinned for any reason decodes those it is missing */
+	TSet<FName> TrackedLayers;
+
+	/** Set when streaming proxies were added or deleted, tiles are gathered again on the next lookup */
+	bool bGatherTiles = true;
+
+	/** Proxy pinned by MakeResident, its own load and unload must not evict the tile being decoded */
+	FGuid PinnedProxyGuid;
+
+	/** Change notifications of the proxies the editor has loaded */
+	TArray<TPair<TWeakObjectPtr<ALandscapeProxy>, FDelegateHandle>> ProxyBindings;
+	FDelegateHandle LoadedActorAddedHandle;
+	FDelegateHandle LoadedActorRemovedHandle;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+
+	uint64 UseCounter = 0;
+	int64 AllocatedBytes = 0;
+};
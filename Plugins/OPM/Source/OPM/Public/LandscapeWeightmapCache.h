@@ -0,0 +1,123 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OPMTypes.h"
+#include "UObject/ObjectKey.h"
+
+class ALandscape;
+class ALandscapeProxy;
+class ULandscapeComponent;
+struct FLandscapeProxyComponentDataChangedParams;
+
+/**
+ * CPU-side cache of landscape paint layer weights
+ * Each requested layer is decoded once per loaded component into an 8-bit raster, so sampling a
+ * layer weight costs the same as a bilinear height lookup. Components are added and dropped as
+ * World Partition loads and unloads their proxies, and components touched by landscape edits are
+ * re-decoded on the next use. ContainsLocation tells callers where to fall back to FOPM_LandscapeTileCache.
+ */
+class OPM_API FOPM_LandscapeWeightmapCache
+{
+public:
+	explicit FOPM_LandscapeWeightmapCache(ALandscape* InLandscape);
+	~FOPM_LandscapeWeightmapCache();
+
+	/**
+	 * Get the weightmap cache for a landscape
+	 * @param Landscape Landscape to cache
+	 * @return Cache for the landscape, or nullptr if Landscape is null
+	 */
+	static FOPM_LandscapeWeightmapCache* Get(ALandscape* Landscape);
+
+	/**
+	 * Release all cached rasters (called on module shutdown)
+	 */
+	static void ReleaseAll();
+
+	/**
+	 * Decode the layers referenced by the rules and refresh changed components. Must be called on the game thread.
+	 * @param Rules Layer rules that will be sampled
+	 */
+	void CacheLayers(const TArray<FLandscapeLayerRule>& Rules);
+
+	/**
+	 * Decode a single layer and refresh changed components. Must be called on the game thread.
+	 * @param LayerName Paint layer to cache
+	 */
+	void CacheLayer(FName LayerName);
+
+	/**
+	 * Sample a cached layer weight. Safe to call from worker threads after CacheLayer().
+	 * @param LayerName Paint layer to sample
+	 * @param Location World location (X, Y will be used)
+	 * @param OutWeight Output weight (0.0 - 1.0)
+	 * @return True if the layer is cached and the location lies on a loaded component
+	 */
+	bool SampleWeight(FName LayerName, const FVector& Location, float& OutWeight) const;
+
+	/**
+	 * Check whether a location lies on a landscape component that is loaded and cached
+	 * @param Location World location (X, Y will be used)
+	 */
+	bool ContainsLocation(const FVector& Location) const;
+
+	/**
+	 * Check a location against layer rules. Layers missing from the landscape count as zero weight.
+	 * @param Rules Layer rules to check
+	 * @param Location World location (X, Y will be used)
+	 * @return True if every rule is satisfied
+	 */
+	bool MeetsLayerRules(const TArray<FLandscapeLayerRule>& Rules, const FVector& Location) const;
+
+	/**
+	 * Drop every cached component and layer, and gather the loaded components again
+	 */
+	void InvalidateAll();
+
+private:
+	/** Weights of one loaded component, (ComponentSizeQuads + 1)^2 vertices per layer */
+	struct FComponentRaster
+	{
+		/** Decoded layers, an empty array is a layer the component has no weights for */
+		TMap<FName, TArray<uint8>> Layers;
+	};
+
+	/** Helper to decode pending components and any requested layer not cached yet */
+	void RefreshComponents(TConstArrayView<FName> NewLayers);
+
+	/** Helper to find the loaded component under a location and the location in its quad space */
+	const FComponentRaster* FindComponent(const FVector& Location, FVector2D& OutComponentCoords) const;
+
+	FIntPoint GetComponentKey(const ULandscapeComponent* Component) const;
+	bool IsOwnProxy(const ALandscapeProxy* Proxy) const;
+	void AddProxy(ALandscapeProxy* Proxy);
+	void RemoveProxy(ALandscapeProxy* Proxy);
+	void UnbindAll();
+
+	void OnComponentDataChanged(ALandscapeProxy* Proxy, const FLandscapeProxyComponentDataChangedParams& Params);
+	void OnLoadedActorAdded(AActor& Actor);
+	void OnLoadedActorRemoved(AActor& Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+
+	TWeakObjectPtr<ALandscape> Landscape;
+
+	/** Refreshed on every CacheLayer call, the landscape may have been moved since the last use */
+	FTransform LandscapeTransform;
+	int32 ComponentSizeQuads = 0;
+
+	/** Loaded components by section base / ComponentSizeQuads */
+	TMap<FIntPoint, FComponentRaster> Components;
+
+	/** Components loaded or edited since the last refresh */
+	TSet<FIntPoint> PendingComponents;
+
+	/** Paint layers requested so far, every component holds all of them after a refresh */
+	TArray<FName> CachedLayers;
+
+	TArray<TPair<TWeakObjectPtr<ALandscapeProxy>, FDelegateHandle>> ProxyBindings;
+	FDelegateHandle LoadedActorAddedHandle;
+	FDelegateHandle LoadedActorRemovedHandle;
+	FDelegateHandle ActorDeletedHandle;
+};
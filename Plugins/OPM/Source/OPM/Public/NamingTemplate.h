@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/StringBuilder.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * Actor naming pattern compiled into a token list
+ * Patterns mix literal text with tokens in braces:
+ *   {Label}      Current actor label
+ *   {Class}      Actor class name, without the Blueprint _C suffix
+ *   {Folder}     Last element of the actor folder path
+ *   {Index}      Running index, {Index:04} pads it with zeros to four digits
+ * Braces are written as {{ and }}. A compiled template appends each label straight into a string
+ * builder, so generating a name costs a single allocation for the final string.
+ */
+class OPM_API FOPM_NamingTemplate
+{
+public:
+	/**
+	 * Compile a pattern
+	 * @param Pattern Pattern such as {Class}_{Folder}_{Index:04}
+	 * @param OutError Reason the pattern was rejected, if not null
+	 * @return True if the pattern compiled
+	 */
+	bool Compile(const FString& Pattern, FString* OutError = nullptr);
+
+	/**
+	 * Check whether a pattern has been compiled
+	 */
+	bool IsValid() const { return Tokens.Num() > 0; }
+
+	/**
+	 * Check whether the template contains an index token
+	 */
+	bool UsesIndex() const { return bUsesIndex; }
+
+	/**
+	 * Append the label generated for an actor
+	 * @param Actor Actor the label is for
+	 * @param Index Running index substituted for {Index}
+	 * @param Out Builder the label is appended to
+	 */
+	void Generate(const AActor* Actor, int32 Index, FStringBuilderBase& Out) const;
+
+	/**
+	 * Generate the label for an actor
+	 * @param Actor Actor the label is for
+	 * @param Index Running index substituted for {Index}
+	 * @return Generated label
+	 */
+	FString Generate(const AActor* Actor, int32 Index) const;
+
+	/**
+	 * Append an integer padded with leading zeros
+	 * @param Out Builder the number is appended to
+	 * @param Value Number to append
+	 * @param Width Minimum number of digits
+	 */
+	static void AppendNumber(FStringBuilderBase& Out, int32 Value, int32 Width);
+
+private:
+	enum class ETokenType : uint8
+	{
+		Literal,
+		Label,
+		Class,
+		Folder,
+		Index
+	};
+
+	struct FToken
+	{
+		ETokenType Type = ETokenType::Literal;
+
+		/** Literal text, as a range of LiteralText */
+		int32 LiteralStart = 0;
+		int32 LiteralLen = 0;
+
+		/** Minimum digits for an index token */
+		int32 Width = 0;
+	};
+
+	TArray<FToken> Tokens;
+	FString LiteralText;
+	bool bUsesIndex = false;
+};
+
+/**
+ * Hashed count of the actor labels in a world
+ * Labels compare case-insensitively, as the editor does. Labels are not unique, so each one counts
+ * the actors holding it and stays taken until the last of them releases it. Uniqueness checks are
+ * constant time and each base label remembers the next free numeric suffix, so labelling n actors
+ * is linear in n.
+ */
+class OPM_API FOPM_LabelIndex
+{
+public:
+	/**
+	 * Index every actor label in a world
+	 * @param World World to index
+	 */
+	void Build(UWorld* World);
+
+	/**
+	 * Check whether a label is taken
+	 */
+	bool Contains(const FString& Label) const { return Labels.Contains(Label); }
+
+	/**
+	 * Record one more actor holding a label
+	 */
+	void Add(const FString& Label) { ++Labels.FindOrAdd(Label, 0); }
+
+	/**
+	 * Release one actor's hold on a label, the label is free once no actor holds it
+	 */
+	void Remove(const FString& Label);
+
+	/**
+	 * Reserve a unique label, appending _N to the requested label if it is already taken
+	 * @param Label Requested label
+	 * @return Label as reserved
+	 */
+	FString MakeUnique(const FString& Label);
+
+private:
+	/** Number of actors holding each label */
+	TMap<FString, int32> Labels;
+
+	/** Next suffix to try for each base label that has collided */
+	TMap<FString, int32> NextSuffix;
+};
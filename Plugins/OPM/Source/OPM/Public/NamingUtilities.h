@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "OPMTypes.h"
 
 /**
  * Utility class for batch naming operations on actors
@@ -20,7 +21,7 @@ public:
 	 * @param Padding Number of digits for padding (e.g., 3 = 001, 002)
 	 */
 	static void BatchRename(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		const FString& Prefix,
 		const FString& Suffix,
 		int32 StartNumber,
@@ -32,7 +33,7 @@ public:
 	 * @param Prefix Prefix to add
 	 */
 	static void AddPrefix(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		const FString& Prefix);
 
 	/**
@@ -41,7 +42,7 @@ public:
 	 * @param Suffix Suffix to add
 	 */
 	static void AddSuffix(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		const FString& Suffix);
 
 	/**
@@ -51,7 +52,7 @@ public:
 	 * @param Padding Number of digits for padding
 	 */
 	static void AutoNumber(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		int32 StartNumber,
 		int32 Padding);
 
@@ -63,18 +64,33 @@ public:
 	 * @param bCaseSensitive Whether search is case sensitive
 	 */
 	static void FindAndReplace(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		const FString& FindStr,
 		const FString& ReplaceStr,
 		bool bCaseSensitive);
 
+	/**
+	 * Apply an ordered set of literal, wildcard or regex rename rules to actor labels
+	 * Rules are compiled once and matched in parallel over a snapshot of the labels; only actors
+	 * whose label changed are relabelled. Rules with nothing to find are skipped, and nothing is
+	 * renamed if any pattern does not compile.
+	 * @param Actors Actors to process
+	 * @param Rules Rules applied in order to each label
+	 * @param OutError Reason a rule was rejected, if not null
+	 * @return Number of actors renamed
+	 */
+	static int32 ApplyRenameRules(
+		TArrayView<AActor* const> Actors,
+		TArrayView<const FRenameRule> Rules,
+		FString* OutError = nullptr);
+
 	/**
 	 * Remove prefix from actor names
 	 * @param Actors Array of actors to process
 	 * @param Prefix Prefix to remove
 	 */
 	static void RemovePrefix(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		const FString& Prefix);
 
 	/**
@@ -83,9 +99,24 @@ public:
 	 * @param Suffix Suffix to remove
 	 */
 	static void RemoveSuffix(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		const FString& Suffix);
 
+	/**
+	 * Rename actors from a naming template such as {Class}_{Folder}_{Index:04}
+	 * Labels are checked against every label in the world and made unique with a _N suffix.
+	 * @param Actors Actors to rename, in index order
+	 * @param Pattern Naming template, see FOPM_NamingTemplate for the tokens
+	 * @param StartIndex Index given to the first actor
+	 * @param OutError Reason the pattern was rejected, if not null
+	 * @return Number of actors renamed
+	 */
+	static int32 ApplyNamingTemplate(
+		TArrayView<AActor* const> Actors,
+		const FString& Pattern,
+		int32 StartIndex = 0,
+		FString* OutError = nullptr);
+
 	/**
 	 * Format number with padding
 	 * @param Number Number to format
@@ -109,4 +140,8 @@ public:
 		const FString& Suffix,
 		int32 Number,
 		int32 Padding);
+
+private:
+	/** Helper to relabel an actor, deferring package dirtying to an open bulk edit */
+	static void SetLabel(AActor* Actor, const FString& NewName);
 };
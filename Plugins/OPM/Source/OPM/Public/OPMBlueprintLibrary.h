@@ -67,7 +67,7 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Alignment")
 	static void AlignActors(
-		TArray<AActor*> Actors,
+		const TArray<AActor*>& Actors,
 		EAlignmentType Type,
 		EAlignmentAxis Axis);
 
@@ -75,57 +75,57 @@ public:
 	 * Align actors to the left
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Alignment")
-	static void AlignActorsLeft(TArray<AActor*> Actors);
+	static void AlignActorsLeft(const TArray<AActor*>& Actors);
 
 	/**
 	 * Align actors to the right
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Alignment")
-	static void AlignActorsRight(TArray<AActor*> Actors);
+	static void AlignActorsRight(const TArray<AActor*>& Actors);
 
 	/**
 	 * Align actors to the top
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Alignment")
-	static void AlignActorsTop(TArray<AActor*> Actors);
+	static void AlignActorsTop(const TArray<AActor*>& Actors);
 
 	/**
 	 * Align actors to the bottom
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Alignment")
-	static void AlignActorsBottom(TArray<AActor*> Actors);
+	static void AlignActorsBottom(const TArray<AActor*>& Actors);
 
 	/**
 	 * Center actors on X axis
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Alignment")
-	static void CenterActorsX(TArray<AActor*> Actors);
+	static void CenterActorsX(const TArray<AActor*>& Actors);
 
 	/**
 	 * Center actors on Y axis
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Alignment")
-	static void CenterActorsY(TArray<AActor*> Actors);
+	static void CenterActorsY(const TArray<AActor*>& Actors);
 
 	/**
 	 * Center actors on Z axis
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Alignment")
-	static void CenterActorsZ(TArray<AActor*> Actors);
+	static void CenterActorsZ(const TArray<AActor*>& Actors);
 
 	/**
 	 * Distribute actors evenly
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Alignment")
 	static void DistributeActors(
-		TArray<AActor*> Actors,
+		const TArray<AActor*>& Actors,
 		EDistributionType Type);
 
 	/**
 	 * Snap actors to grid
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Alignment")
-	static void SnapActorsToGrid(TArray<AActor*> Actors, float GridSize);
+	static void SnapActorsToGrid(const TArray<AActor*>& Actors, float GridSize);
 
 	// ==================== Naming Functions ====================
 
@@ -134,7 +134,7 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Naming")
 	static void BatchRename(
-		TArray<AActor*> Actors,
+		const TArray<AActor*>& Actors,
 		const FString& Prefix,
 		const FString& Suffix,
 		int32 StartNumber,
@@ -144,30 +144,52 @@ public:
 	 * Add prefix to actor names
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Naming")
-	static void AddPrefix(TArray<AActor*> Actors, const FString& Prefix);
+	static void AddPrefix(const TArray<AActor*>& Actors, const FString& Prefix);
 
 	/**
 	 * Add suffix to actor names
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Naming")
-	static void AddSuffix(TArray<AActor*> Actors, const FString& Suffix);
+	static void AddSuffix(const TArray<AActor*>& Actors, const FString& Suffix);
 
 	/**
 	 * Auto-number actors sequentially
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Naming")
-	static void AutoNumber(TArray<AActor*> Actors, int32 StartNumber, int32 Padding);
+	static void AutoNumber(const TArray<AActor*>& Actors, int32 StartNumber, int32 Padding);
 
 	/**
 	 * Find and replace text in actor names
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Naming")
 	static void FindAndReplace(
-		TArray<AActor*> Actors,
+		const TArray<AActor*>& Actors,
 		const FString& FindStr,
 		const FString& ReplaceStr,
 		bool bCaseSensitive);
 
+	/**
+	 * Rename actors from a naming template such as {Class}_{Folder}_{Index:04}
+	 * Supported tokens are {Label}, {Class}, {Folder} and {Index}, with {Index:N} padding to N digits.
+	 * @return Number of actors renamed, zero if the template is invalid
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Naming")
+	static int32 ApplyNamingTemplate(
+		const TArray<AActor*>& Actors,
+		const FString& Pattern,
+		int32 StartIndex = 1);
+
+	/**
+	 * Apply literal, wildcard or regex rename rules to actor labels in one pass
+	 * @param OutError Reason a rule was rejected, empty on success
+	 * @return Number of actors renamed, zero if any pattern is invalid
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Naming")
+	static int32 ApplyRenameRules(
+		const TArray<AActor*>& Actors,
+		const TArray<FRenameRule>& Rules,
+		FString& OutError);
+
 	// ==================== Replacement Functions ====================
 
 	/**
@@ -176,37 +198,70 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "OPM|Replacement", meta = (WorldContext = "WorldContextObject"))
 	static TArray<AActor*> BatchReplaceActors(
 		UObject* WorldContextObject,
-		TArray<AActor*> OldActors,
+		const TArray<AActor*>& OldActors,
 		UClass* NewActorClass,
 		bool bPreserveTransform,
 		bool bPreserveAttachments);
 
+	/**
+	 * Collapse static mesh actors into instances on one host actor
+	 * @return Host actor holding the instances
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Replacement", meta = (WorldContext = "WorldContextObject"))
+	static AActor* ConvertActorsToInstances(
+		UObject* WorldContextObject,
+		const TArray<AActor*>& Actors,
+		bool bHierarchical = true);
+
+	/**
+	 * Break instances back out into static mesh actors
+	 * Converts the given instances, or the selected instances when none are given, or every instance
+	 * when bAllInstances is set. Painted foliage components are not converted.
+	 * @return Spawned actors
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Replacement", meta = (WorldContext = "WorldContextObject"))
+	static TArray<AActor*> ConvertInstancesToActors(
+		UObject* WorldContextObject,
+		class UInstancedStaticMeshComponent* Component,
+		const TArray<int32>& InstanceIndices,
+		bool bAllInstances = false);
+
 	// ==================== Organization Functions ====================
 
 	/**
 	 * Set folder path for actors
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Organization")
-	static void SetActorFolder(TArray<AActor*> Actors, const FString& FolderPath);
+	static void SetActorFolder(const TArray<AActor*>& Actors, const FString& FolderPath);
 
 	/**
 	 * Group actors by type
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Organization")
-	static void GroupActorsByType(TArray<AActor*> Actors);
+	static void GroupActorsByType(const TArray<AActor*>& Actors);
+
+	/**
+	 * Group actors into folders or parent actors by grid cell or spatial cluster
+	 * @return Number of groups created
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Organization", meta = (WorldContext = "WorldContextObject"))
+	static int32 GroupActorsSpatially(
+		UObject* WorldContextObject,
+		const TArray<AActor*>& Actors,
+		const FSpatialGroupingSettings& Settings);
 
 	/**
 	 * Apply tags to actors
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Organization")
-	static void ApplyTags(TArray<AActor*> Actors, const TArray<FName>& Tags);
+	static void ApplyTags(const TArray<AActor*>& Actors, const TArray<FName>& Tags);
 
 	/**
 	 * Attach actors to a parent
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Organization")
 	static void AttachActorsToParent(
-		TArray<AActor*> Actors,
+		const TArray<AActor*>& Actors,
 		AActor* ParentActor,
 		bool bMaintainWorldTransform);
 
@@ -214,7 +269,21 @@ public:
 	 * Detach actors from parent
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Organization")
-	static void DetachActorsFromParent(TArray<AActor*> Actors, bool bMaintainWorldTransform);
+	static void DetachActorsFromParent(const TArray<AActor*>& Actors, bool bMaintainWorldTransform);
+
+	/**
+	 * Find actors by tag through the tag index, without iterating the level
+	 * @return Actors with every RequireAll tag, at least one RequireAny tag and no Exclude tag
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Organization", meta = (WorldContext = "WorldContextObject"))
+	static TArray<AActor*> QueryActorsByTags(UObject* WorldContextObject, const FTagQuery& Query);
+
+	/**
+	 * Replace the editor selection with the actors matching a tag query
+	 * @return Number of actors selected
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Organization", meta = (WorldContext = "WorldContextObject"))
+	static int32 SelectActorsByTags(UObject* WorldContextObject, const FTagQuery& Query);
 
 	// ==================== Utility Functions ====================
 
@@ -280,6 +349,7 @@ public:
 
 	/**
 	 * Place actors on landscape with terrain-aware positioning
+	 * @param bKeepOnTerrain Re-align the actors when the landscape under them is sculpted later
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Landscape", meta = (WorldContext = "WorldContextObject"))
 	static TArray<AActor*> PlaceActorsOnLandscape(
@@ -287,7 +357,8 @@ public:
 		UClass* ActorClass,
 		const TArray<FTransform>& Transforms,
 		class ALandscape* Landscape,
-		const FLandscapePlacementSettings& Settings);
+		const FLandscapePlacementSettings& Settings,
+		bool bKeepOnTerrain = false);
 
 	/**
 	 * Sample landscape height at a given location
@@ -298,6 +369,16 @@ public:
 		const FVector& Location,
 		float& OutHeight);
 
+	/**
+	 * Sample landscape paint layer weight at a given location
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Landscape")
+	static bool SampleLandscapeLayerWeight(
+		class ALandscape* Landscape,
+		FName LayerName,
+		const FVector& Location,
+		float& OutWeight);
+
 	/**
 	 * Calculate slope angle at a landscape location
 	 */
@@ -326,14 +407,69 @@ public:
 
 	/**
 	 * Place actors along a spline path
+	 * @param bWatchSpline Re-place the affected actors when the spline is edited later
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
 	static TArray<AActor*> PlaceActorsAlongSpline(
 		UObject* WorldContextObject,
 		UClass* ActorClass,
 		class USplineComponent* SplineComponent,
+		const FSplinePlacementSettings& Settings,
+		bool bWatchSpline = false);
+
+	/**
+	 * Place actors along many splines, evaluating all of them in one parallel job
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
+	static TArray<AActor*> PlaceActorsAlongSplines(
+		UObject* WorldContextObject,
+		UClass* ActorClass,
+		const TArray<class USplineComponent*>& Splines,
 		const FSplinePlacementSettings& Settings);
 
+	/**
+	 * Place mesh instances along many splines into one instanced component
+	 * Pass the actor returned by a previous call as TargetActor to rebuild it in place
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
+	static AActor* PlaceInstancesAlongSplines(
+		UObject* WorldContextObject,
+		class UStaticMesh* Mesh,
+		const TArray<class USplineComponent*>& Splines,
+		const FSplinePlacementSettings& Settings,
+		AActor* TargetActor = nullptr);
+
+	/**
+	 * Place actors along every spline of a network, keeping junctions where splines cross clear
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
+	static TArray<AActor*> PlaceActorsAlongSplineNetwork(
+		UObject* WorldContextObject,
+		UClass* ActorClass,
+		const TArray<class USplineComponent*>& Splines,
+		const FSplinePlacementSettings& Settings,
+		float JunctionClearance = 200.0f);
+
+	/**
+	 * Find the junctions where splines cross or touch
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline")
+	static TArray<FVector> FindSplineJunctions(
+		const TArray<class USplineComponent*>& Splines,
+		float Tolerance = 10.0f);
+
+	/**
+	 * Deform spline mesh segments along a spline on a single actor
+	 * Pass the actor returned by a previous call as TargetActor to rebuild its segments in place
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
+	static AActor* PlaceSplineMeshesAlongSpline(
+		UObject* WorldContextObject,
+		class UStaticMesh* Mesh,
+		class USplineComponent* SplineComponent,
+		const FSplinePlacementSettings& Settings,
+		AActor* TargetActor = nullptr);
+
 	/**
 	 * Generate transforms along a spline
 	 */
@@ -345,7 +481,7 @@ public:
 	/**
 	 * Generate road with props along spline
 	 */
-	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject", DeprecatedFunction, DeprecationMessage = "Use Generate Road Composite, which builds the road as one actor from meshes."))
 	static TArray<AActor*> GenerateRoadAlongSpline(
 		UObject* WorldContextObject,
 		class USplineComponent* SplineComponent,
@@ -356,7 +492,7 @@ public:
 	/**
 	 * Generate fence along spline
 	 */
-	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject", DeprecatedFunction, DeprecationMessage = "Use Generate Fence Composite, which builds the fence as one actor from meshes."))
 	static TArray<AActor*> GenerateFenceAlongSpline(
 		UObject* WorldContextObject,
 		class USplineComponent* SplineComponent,
@@ -366,6 +502,7 @@ public:
 
 	/**
 	 * Generate cable routing along spline
+	 * A TensionRatio above zero (horizontal tension over weight per unit length) replaces SagAmount
 	 */
 	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
 	static TArray<AActor*> GenerateCableRoutingAlongSpline(
@@ -374,7 +511,70 @@ public:
 		UClass* CableActorClass,
 		UClass* SupportsActorClass,
 		float SupportSpacing,
-		float SagAmount);
+		float SagAmount,
+		float TensionRatio = 0.0f);
+
+	/**
+	 * Generate road as a single composite actor (spline mesh surface, instanced props)
+	 * Pass the actor returned by a previous call as TargetActor to rebuild it in place
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
+	static AActor* GenerateRoadComposite(
+		UObject* WorldContextObject,
+		class USplineComponent* SplineComponent,
+		class UStaticMesh* RoadMesh,
+		const TArray<class UStaticMesh*>& PropMeshes,
+		float PropSpacing,
+		AActor* TargetActor = nullptr);
+
+	/**
+	 * Generate fence as a single composite actor (instanced posts, spline mesh panels)
+	 * Pass the actor returned by a previous call as TargetActor to rebuild it in place
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
+	static AActor* GenerateFenceComposite(
+		UObject* WorldContextObject,
+		class USplineComponent* SplineComponent,
+		class UStaticMesh* PostMesh,
+		class UStaticMesh* PanelMesh,
+		float PostSpacing,
+		AActor* TargetActor = nullptr);
+
+	/**
+	 * Generate cable routing as a single composite actor (instanced supports, spline mesh cables)
+	 * Pass the actor returned by a previous call as TargetActor to rebuild it in place
+	 * A TensionRatio above zero (horizontal tension over weight per unit length) replaces SagAmount
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
+	static AActor* GenerateCableComposite(
+		UObject* WorldContextObject,
+		class USplineComponent* SplineComponent,
+		class UStaticMesh* CableMesh,
+		class UStaticMesh* SupportMesh,
+		float SupportSpacing,
+		float SagAmount,
+		AActor* TargetActor = nullptr,
+		float TensionRatio = 0.0f);
+
+	/**
+	 * Snap a spline to terrain along its whole length, keeping only the points needed to follow it
+	 * @return Number of spline points after snapping
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline", meta = (WorldContext = "WorldContextObject"))
+	static int32 SnapSplineToTerrainDense(
+		UObject* WorldContextObject,
+		class USplineComponent* SplineComponent,
+		float HeightOffset = 0.0f,
+		float SampleSpacing = 100.0f,
+		float Tolerance = 10.0f);
+
+	/**
+	 * Remove spline points while keeping the curve within tolerance of its original shape
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OPM|Spline")
+	static FSplineSimplificationResult SimplifySpline(
+		class USplineComponent* SplineComponent,
+		float Tolerance = 10.0f);
 
 	/**
 	 * Get spline length
@@ -389,5 +589,6 @@ public:
 	static TArray<float> GetAdaptiveDistances(
 		class USplineComponent* SplineComponent,
 		float MinSpacing,
-		float MaxSpacing);
+		float MaxSpacing,
+		float ChordTolerance = 5.0f);
 };
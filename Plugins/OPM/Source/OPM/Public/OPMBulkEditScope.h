@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UPackage;
+
+/**
+ * Defers package dirtying, selection notifications and viewport redraws for the lifetime of a bulk edit
+ * While any scope is open, actors are recorded for undo without dirtying their packages, selection
+ * change notifications are batched and viewport redraws are held back. When the outermost scope
+ * closes, each touched package is dirtied once and the level viewports are redrawn once. Scopes nest.
+ * Scene Outliner work is not deferred: labels, folders and attachments still raise the outliner's
+ * own per-actor updates as they change.
+ */
+class OPM_API FOPM_BulkEditScope
+{
+public:
+	FOPM_BulkEditScope();
+	~FOPM_BulkEditScope();
+
+	FOPM_BulkEditScope(const FOPM_BulkEditScope&) = delete;
+	FOPM_BulkEditScope& operator=(const FOPM_BulkEditScope&) = delete;
+
+	/**
+	 * Check whether a bulk edit is in progress
+	 * @return True if at least one scope is open
+	 */
+	static bool IsActive();
+
+	/**
+	 * Mark an actor as modified for undo/redo, dirtying its package at scope exit
+	 * Outside a scope this is a plain Modify
+	 * @param Actor Actor to mark as modified
+	 */
+	static void ModifyActor(AActor* Actor);
+
+	/**
+	 * Mark the package of an object dirty, once per package while a scope is open
+	 * @param Object Object whose package was changed
+	 */
+	static void MarkPackageDirty(UObject* Object);
+
+	/**
+	 * Request a level viewport redraw, issued immediately outside a scope
+	 */
+	static void RequestViewportRedraw();
+
+private:
+	/** Helper to issue the deferred work when the outermost scope closes */
+	static void Flush();
+};
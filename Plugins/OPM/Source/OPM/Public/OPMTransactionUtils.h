@@ -26,7 +26,7 @@ public:
 	 * Mark actors as modified for undo/redo
 	 * @param Actors Actors to mark as modified
 	 */
-	void ModifyActors(const TArray<AActor*>& Actors);
+	void ModifyActors(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Mark a single actor as modified for undo/redo
@@ -213,6 +213,24 @@ enum class EBiomeType : uint8
 	Custom UMETA(DisplayName = "Custom")
 };
 
+/**
+ * Weight range rule for a landscape paint layer
+ */
+USTRUCT(BlueprintType)
+struct FLandscapeLayerRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Landscape")
+	FName LayerName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Landscape", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinWeight = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Landscape", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MaxWeight = 1.0f;
+};
+
 /**
  * Landscape placement settings
  */
@@ -238,6 +256,10 @@ struct FLandscapePlacementSettings
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Landscape")
 	EBiomeType BiomeType = EBiomeType::Plains;
+
+	/** Paint layer weight ranges a location must satisfy (all rules must pass) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Landscape")
+	TArray<FLandscapeLayerRule> LayerRules;
 };
 
 // ============================================================================
@@ -268,6 +290,16 @@ enum class ESplineAlignment : uint8
 	None UMETA(DisplayName = "No Alignment")
 };
 
+/**
+ * Spline placement output mode
+ */
+UENUM(BlueprintType)
+enum class ESplineOutputMode : uint8
+{
+	Actors UMETA(DisplayName = "Spawn Actors"),
+	SplineMeshes UMETA(DisplayName = "Deformed Spline Meshes")
+};
+
 /**
  * Spline placement settings
  */
@@ -296,4 +328,164 @@ struct FSplinePlacementSettings
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline", meta = (ClampMin = "0.0"))
 	float EndOffset = 0.0f;
+
+	/** Maximum distance between the spline and the straight line joining neighbouring placements (Adaptive mode) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline", meta = (ClampMin = "0.01"))
+	float ChordTolerance = 5.0f;
+
+	/** Spawn one actor per placement, or deform spline mesh segments on a single actor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline")
+	ESplineOutputMode OutputMode = ESplineOutputMode::Actors;
+
+	/** Mesh deformed along each segment (Spacing is the nominal segment length) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline", meta = (EditCondition = "OutputMode == ESplineOutputMode::SplineMeshes"))
+	TObjectPtr<class UStaticMesh> SegmentMesh = nullptr;
+};
+
+/**
+ * Outcome of simplifying a spline
+ */
+USTRUCT(BlueprintType)
+struct FSplineSimplificationResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Spline")
+	int32 OriginalPointCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Spline")
+	int32 PointCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Spline")
+	int32 PointsRemoved = 0;
+
+	/** Largest distance between the original and simplified curves */
+	UPROPERTY(BlueprintReadOnly, Category = "Spline")
+	float MaxDeviation = 0.0f;
+
+	/** Milliseconds per 1000 distance queries before and after simplifying */
+	UPROPERTY(BlueprintReadOnly, Category = "Spline")
+	float EvaluationTimeBefore = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Spline")
+	float EvaluationTimeAfter = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Spline")
+	float EvaluationTimeSaved = 0.0f;
+};
+
+// ============================================================================
+// Naming Types
+// ============================================================================
+
+/**
+ * How a rename rule matches actor labels
+ */
+UENUM(BlueprintType)
+enum class ERenameRuleType : uint8
+{
+	/** Replace every occurrence of the text */
+	Literal UMETA(DisplayName = "Literal"),
+	/** Match the whole label with * and ? wildcards, each wildcard is a capture group */
+	Wildcard UMETA(DisplayName = "Wildcard"),
+	/** Replace every match of a regular expression */
+	Regex UMETA(DisplayName = "Regex")
+};
+
+/**
+ * Find/replace rule applied to actor labels
+ * Wildcard and Regex replacements may refer to capture groups as $1 to $9, and $0 to the whole match.
+ */
+USTRUCT(BlueprintType)
+struct FRenameRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Naming")
+	ERenameRuleType Type = ERenameRuleType::Literal;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Naming")
+	FString Find;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Naming")
+	FString Replace;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Naming")
+	bool bCaseSensitive = false;
+};
+
+// ============================================================================
+// Organization Types
+// ============================================================================
+
+/**
+ * How actors are bucketed by location
+ */
+UENUM(BlueprintType)
+enum class ESpatialGroupingMode : uint8
+{
+	/** One group per grid cell, aligned with World Partition cells of the same size */
+	GridCell UMETA(DisplayName = "Grid Cell"),
+	/** One group per chain of actors closer than the cluster radius */
+	Cluster UMETA(DisplayName = "Cluster")
+};
+
+/**
+ * What a spatial group becomes in the outliner
+ */
+UENUM(BlueprintType)
+enum class ESpatialGroupingOutput : uint8
+{
+	Folders UMETA(DisplayName = "Folders"),
+	ParentActors UMETA(DisplayName = "Parent Actors")
+};
+
+/**
+ * Settings for grouping actors by location
+ */
+USTRUCT(BlueprintType)
+struct FSpatialGroupingSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organization")
+	ESpatialGroupingMode Mode = ESpatialGroupingMode::GridCell;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organization")
+	ESpatialGroupingOutput Output = ESpatialGroupingOutput::Folders;
+
+	/** Cell size, match the runtime grid cell size so groups line up with streaming and HLOD cells */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organization", meta = (ClampMin = "1.0", EditCondition = "Mode == ESpatialGroupingMode::GridCell"))
+	float CellSize = 12800.0f;
+
+	/** Actors closer than this join the same cluster */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organization", meta = (ClampMin = "1.0", EditCondition = "Mode == ESpatialGroupingMode::Cluster"))
+	float ClusterRadius = 1000.0f;
+
+	/** Clusters with fewer actors are left where they are */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organization", meta = (ClampMin = "1", EditCondition = "Mode == ESpatialGroupingMode::Cluster"))
+	int32 MinClusterSize = 2;
+
+	/** Folder the groups are created under, or prefix for parent actor labels */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organization")
+	FString RootName = TEXT("Spatial");
+};
+
+/**
+ * Query over actor tags, each list is ignored when empty
+ * Matches actors that have every RequireAll tag, at least one RequireAny tag and no Exclude tag.
+ */
+USTRUCT(BlueprintType)
+struct FTagQuery
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organization")
+	TArray<FName> RequireAll;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organization")
+	TArray<FName> RequireAny;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organization")
+	TArray<FName> Exclude;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "OPMTypes.h"
 
 /**
  * Utility class for organizing actors in the world outliner
@@ -17,7 +18,7 @@ public:
 	 * @param FolderPath Folder path (e.g., "Environment/Props")
 	 */
 	static void SetActorFolder(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		const FName& FolderPath);
 
 	/**
@@ -26,9 +27,24 @@ public:
 	 * @param bUseClassName Whether to use class name for folder naming
 	 */
 	static void GroupActorsByType(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		bool bUseClassName = true);
 
+	/**
+	 * Group actors by location into folders or parent actors
+	 * Actors are bucketed through a spatial hash in a single pass. Grid cells are numbered
+	 * floor(Location / CellSize), the same cells World Partition uses for a grid of that size, so
+	 * groups line up with streaming and HLOD cells. Actors attached to another actor are skipped.
+	 * @param Actors Actors to group
+	 * @param Settings Grouping mode, cell size or cluster radius and output
+	 * @param World World to spawn parent actors in, unused for folders
+	 * @return Number of groups created
+	 */
+	static int32 GroupActorsSpatially(
+		TArrayView<AActor* const> Actors,
+		const FSpatialGroupingSettings& Settings,
+		UWorld* World);
+
 	/**
 	 * Apply tags to actors
 	 * @param Actors Array of actors to tag
@@ -36,7 +52,7 @@ public:
 	 * @param bReplace Whether to replace existing tags or add to them
 	 */
 	static void ApplyTagsToActors(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		const TArray<FName>& Tags,
 		bool bReplace = false);
 
@@ -46,14 +62,14 @@ public:
 	 * @param Tags Tags to remove
 	 */
 	static void RemoveTagsFromActors(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		const TArray<FName>& Tags);
 
 	/**
 	 * Clear all tags from actors
 	 * @param Actors Array of actors to clear
 	 */
-	static void ClearActorTags(TArray<AActor*> Actors);
+	static void ClearActorTags(TArrayView<AActor* const> Actors);
 
 	/**
 	 * Attach actors to a parent actor
@@ -62,7 +78,7 @@ public:
 	 * @param bMaintainWorldTransform Whether to maintain world transform
 	 */
 	static void AttachActorsToParent(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		AActor* ParentActor,
 		bool bMaintainWorldTransform = true);
 
@@ -72,7 +88,7 @@ public:
 	 * @param bMaintainWorldTransform Whether to maintain world transform
 	 */
 	static void DetachActorsFromParent(
-		TArray<AActor*> Actors,
+		TArrayView<AActor* const> Actors,
 		bool bMaintainWorldTransform = true);
 
 	/**
@@ -86,4 +102,25 @@ public:
 		UWorld* World,
 		const FVector& Location,
 		const FString& GroupName);
+
+private:
+	/** Actors sharing a spatial group */
+	struct FSpatialGroup
+	{
+		FString Name;
+		TArray<AActor*> Actors;
+	};
+
+	/** Helper to bucket actors by grid cell */
+	static void BuildGridGroups(
+		TArrayView<AActor* const> Actors,
+		float CellSize,
+		TArray<FSpatialGroup>& OutGroups);
+
+	/** Helper to bucket actors into clusters of neighbours closer than Radius */
+	static void BuildClusterGroups(
+		TArrayView<AActor* const> Actors,
+		float Radius,
+		int32 MinClusterSize,
+		TArray<FSpatialGroup>& OutGroups);
 };
@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/Regex.h"
+#include "OPMTypes.h"
+
+/**
+ * Ordered list of rename rules compiled for repeated use
+ * Wildcard rules are translated to anchored regular expressions and every pattern is compiled once
+ * when the rule is added. Replacement strings are split into literal runs and capture group
+ * references up front, so applying the set to a label does no parsing. Apply is const and safe to
+ * call from several threads at once.
+ */
+class OPM_API FOPM_RenameRuleSet
+{
+public:
+	/**
+	 * Compile a rule and append it to the set
+	 * @param Rule Rule to add
+	 * @param OutError Reason the rule was rejected, if not null
+	 * @return False if the rule has nothing to find or its pattern does not compile
+	 */
+	bool AddRule(const FRenameRule& Rule, FString* OutError = nullptr);
+
+	/**
+	 * Get the number of rules in the set
+	 */
+	int32 Num() const { return Rules.Num(); }
+
+	/**
+	 * Apply every rule in order to a label
+	 * @param Label Label to rename
+	 * @param OutLabel Label after every rule has been applied
+	 * @return True if the label changed
+	 */
+	bool Apply(const FString& Label, FString& OutLabel) const;
+
+private:
+	/** Literal run of the replacement text, or a capture group reference */
+	struct FReplacePart
+	{
+		int32 Group = INDEX_NONE;
+		int32 LiteralStart = 0;
+		int32 LiteralLen = 0;
+	};
+
+	struct FCompiledRule
+	{
+		ERenameRuleType Type = ERenameRuleType::Literal;
+		ESearchCase::Type SearchCase = ESearchCase::IgnoreCase;
+		FString Find;
+
+		/** Replacement text, for pattern rules the literal runs ReplaceParts refer to */
+		FString ReplaceText;
+
+		TOptional<FRegexPattern> Pattern;
+		TArray<FReplacePart> ReplaceParts;
+	};
+
+	/** Helper to apply one pattern rule, appending the result to Out */
+	static void ApplyPattern(const FCompiledRule& Rule, const FString& Input, FString& Out);
+
+	TArray<FCompiledRule> Rules;
+};
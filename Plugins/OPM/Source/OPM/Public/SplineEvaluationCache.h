@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class USplineComponent;
+
+/**
+ * Arc-length lookup table for a spline component
+ * The spline is sampled once per revision at a fixed distance step, storing world position,
+ * direction, rotation-minimizing up vector, scale and curvature. Queries by distance are then an
+ * indexed Hermite interpolation instead of a reparameterization search per call.
+ */
+class OPM_API FOPM_SplineCache
+{
+public:
+	/**
+	 * Get the evaluation cache for a spline, rebuilding it if the spline or its transform changed
+	 * @param SplineComponent Spline to cache
+	 * @return Cache for the spline, or nullptr if SplineComponent is null
+	 */
+	static const FOPM_SplineCache* Get(USplineComponent* SplineComponent);
+
+	/**
+	 * Release all cached tables (called on module shutdown)
+	 */
+	static void ReleaseAll();
+
+	/**
+	 * Build the table from the current state of a spline
+	 * @param SplineComponent Spline to sample
+	 */
+	void Build(USplineComponent* SplineComponent);
+
+	/**
+	 * Get the total length of the spline
+	 */
+	float GetLength() const { return Length; }
+
+	/**
+	 * Get the world location at a distance along the spline
+	 */
+	FVector GetLocationAtDistance(float Distance) const;
+
+	/**
+	 * Get the unit world direction at a distance along the spline
+	 */
+	FVector GetDirectionAtDistance(float Distance) const;
+
+	/**
+	 * Get the twist-free (rotation-minimizing) world up vector at a distance along the spline
+	 */
+	FVector GetUpVectorAtDistance(float Distance) const;
+
+	/**
+	 * Get the spline scale at a distance along the spline
+	 */
+	FVector GetScaleAtDistance(float Distance) const;
+
+	/**
+	 * Get the world-space curvature (1 / turning radius) at a distance along the spline
+	 */
+	float GetCurvatureAtDistance(float Distance) const;
+
+	/**
+	 * Get the highest curvature among table samples between two distances, inclusive of the bracketing samples
+	 */
+	float GetMaxCurvature(float StartDistance, float EndDistance) const;
+
+	/**
+	 * Get the spline input key at a distance along the spline
+	 */
+	float GetInputKeyAtDistance(float Distance) const;
+
+private:
+	/** Snapshots flatten the table for evaluation off the game thread */
+	friend struct FOPM_SplineSnapshot;
+
+	struct FSample
+	{
+		FVector Location;
+		FVector Direction;
+		FVector Up;
+		FVector Scale;
+		float InputKey = 0.0f;
+		float Curvature = 0.0f;
+
+		/** World-space chord length to the next sample, the step is in the spline's local space */
+		float ChordLength = 0.0f;
+	};
+
+	/** Helper to find the table interval containing a distance */
+	void FindInterval(float Distance, int32& OutIndex, float& OutAlpha) const;
+
+	/** Helper to propagate up vectors with the double reflection method */
+	void ComputeRotationMinimizingFrames(const FVector& InitialUp, bool bClosedLoop);
+
+	TArray<FSample> Samples;
+	float Length = 0.0f;
+	float Step = 1.0f;
+
+	/** Spline revision and transform the table was built from */
+	uint32 SplineVersion = 0;
+	FTransform ComponentTransform;
+};
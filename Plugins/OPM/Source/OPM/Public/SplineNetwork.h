@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+/** Point where two splines of a network cross or touch */
+struct FOPM_SplineIntersection
+{
+	int32 SplineA = INDEX_NONE;
+	int32 SplineB = INDEX_NONE;
+	float DistanceA = 0.0f;
+	float DistanceB = 0.0f;
+	FVector Location = FVector::ZeroVector;
+};
+
+/** Cluster of intersections meeting at one place, such as a crossroads */
+struct FOPM_SplineJunction
+{
+	FVector Location = FVector::ZeroVector;
+
+	/** Splines meeting at the junction, as indices into the network */
+	TArray<int32> Splines;
+
+	/** Intersections merged into the junction */
+	TArray<int32> Intersections;
+};
+
+/**
+ * Set of splines treated as one network
+ * Each spline is flattened into a chord-tolerance polyline and every chord is stored in a bounding
+ * volume hierarchy. Intersections are found by querying the hierarchy with each chord, so a network
+ * of n chords is resolved in O(n log n) rather than testing every pair of splines.
+ */
+class OPM_API FOPM_SplineNetwork
+{
+public:
+	/**
+	 * Build the network from a set of splines
+	 * @param InSplines Splines in the network, null entries are ignored
+	 * @param Tolerance Distance at which two splines are considered to meet
+	 */
+	void Build(TArrayView<USplineComponent* const> InSplines, float Tolerance = 10.0f);
+
+	/**
+	 * Get the splines in the network
+	 */
+	const TArray<USplineComponent*>& GetSplines() const { return Splines; }
+
+	/**
+	 * Get every spline to spline intersection found by Build
+	 */
+	const TArray<FOPM_SplineIntersection>& GetIntersections() const { return Intersections; }
+
+	/**
+	 * Get intersections merged into junctions
+	 */
+	const TArray<FOPM_SplineJunction>& GetJunctions() const { return Junctions; }
+
+	/**
+	 * Check whether a distance along a spline falls inside a junction zone
+	 * @param SplineIndex Index of the spline in the network
+	 * @param Distance Distance along the spline
+	 * @param Clearance Distance either side of each junction that is kept clear
+	 * @return True if the distance is within Clearance of a junction on the spline
+	 */
+	bool IsInJunctionZone(int32 SplineIndex, float Distance, float Clearance) const;
+
+	/**
+	 * Remove distances that fall inside junction zones
+	 * @param SplineIndex Index of the spline in the network
+	 * @param Distances Sorted distances along the spline, filtered in place
+	 * @param Clearance Distance either side of each junction that is kept clear
+	 */
+	void RemoveJunctionDistances(int32 SplineIndex, TArray<float>& Distances, float Clearance) const;
+
+private:
+	/** Polyline chord of one spline */
+	struct FChord
+	{
+		FVector Start;
+		FVector End;
+		float StartDistance;
+		float EndDistance;
+		int32 Spline;
+	};
+
+	/** Hierarchy node, leaves own ChordCount chords from FirstChord, inner nodes own two children */
+	struct FNode
+	{
+		FBox Bounds;
+		int32 FirstChord = 0;
+		int32 ChordCount = 0;
+		int32 SecondChild = INDEX_NONE;
+	};
+
+	/** Helper to build a subtree over Chords[First, First + Count), returns the node index */
+	int32 BuildNode(int32 First, int32 Count);
+
+	/** Helper to collect chords whose bounds overlap a box */
+	void QueryChords(const FBox& Box, TArray<int32>& OutChords) const;
+
+	void FindIntersections();
+	void MergeJunctions();
+
+	TArray<USplineComponent*> Splines;
+	TArray<FChord> Chords;
+	TArray<FNode> Nodes;
+	float Tolerance = 10.0f;
+
+	TArray<FOPM_SplineIntersection> Intersections;
+	TArray<FOPM_SplineJunction> Junctions;
+
+	/** Sorted intersection distances along each spline */
+	TArray<TArray<float>> JunctionDistances;
+};
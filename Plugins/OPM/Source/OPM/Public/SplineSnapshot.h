@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+/**
+ * Per-distance results of a batched spline evaluation
+ */
+struct OPM_API FOPM_SplineSamples
+{
+	TArray<FVector> Locations;
+	TArray<FVector> Directions;
+	TArray<FVector> UpVectors;
+	TArray<FVector> Scales;
+	TArray<float> Curvatures;
+
+	/** Size every array for Num samples without initializing them */
+	void SetNumUninitialized(int32 Num);
+};
+
+/**
+ * Immutable, flattened structure-of-arrays copy of a spline's evaluation table
+ * Captured once on the game thread from FOPM_SplineCache, after which batches of distances can be
+ * evaluated from worker threads without touching the spline component. Every table interval is kept
+ * as the polynomial form of the cache's Hermite span, one float array per coefficient and axis, and
+ * distances are evaluated four at a time in vector registers. Each lane gathers the coefficients of
+ * its own interval, since distances may land anywhere along the table. Results match the cache to
+ * float precision; interval start locations stay in double precision so large worlds lose nothing.
+ */
+struct OPM_API FOPM_SplineSnapshot
+{
+	/**
+	 * Capture the current state of a spline. Game thread only.
+	 * @param SplineComponent Spline to capture
+	 * @return True if the spline has an evaluation table
+	 */
+	bool Capture(USplineComponent* SplineComponent);
+
+	/**
+	 * Check whether the snapshot holds any intervals
+	 */
+	bool IsValid() const { return NumIntervals > 0; }
+
+	/**
+	 * Get the total length of the captured spline
+	 */
+	float GetLength() const { return Length; }
+
+	/**
+	 * Evaluate a batch of distances in parallel
+	 * @param Distances Distances along the spline
+	 * @param OutSamples Output samples, one entry per distance in each array
+	 */
+	void Evaluate(TArrayView<const float> Distances, FOPM_SplineSamples& OutSamples) const;
+
+	/**
+	 * Evaluate a contiguous block of distances on the calling thread
+	 * Distances and samples are indexed alike, so blocks of several snapshots can share one output.
+	 * @param Distances Distances along the spline
+	 * @param Start First index to evaluate
+	 * @param End One past the last index to evaluate
+	 * @param OutSamples Output samples, already sized to cover End
+	 */
+	void EvaluateRange(TArrayView<const float> Distances, int32 Start, int32 End, FOPM_SplineSamples& OutSamples) const;
+
+private:
+	/** One float array per axis */
+	struct FAxisArrays
+	{
+		TArray<float> X;
+		TArray<float> Y;
+		TArray<float> Z;
+
+		void SetNumUninitialized(int32 Num);
+		void Set(int32 Index, const FVector& Value);
+	};
+
+	float Length = 0.0f;
+	float Step = 1.0f;
+	int32 NumIntervals = 0;
+
+	/** Location of each interval start */
+	TArray<FVector> Origins;
+
+	/** Location offset from the interval start, ((A t + B) t + C) t, one entry per interval */
+	FAxisArrays PositionA;
+	FAxisArrays PositionB;
+	FAxisArrays PositionC;
+
+	/** Table samples interpolated linearly within an interval, one entry per sample */
+	FAxisArrays Directions;
+	FAxisArrays UpVectors;
+	FAxisArrays Scales;
+	TArray<float> Curvatures;
+};
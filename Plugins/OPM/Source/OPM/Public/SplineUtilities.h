@@ -7,6 +7,11 @@
 #include "GameFramework/Actor.h"
 #include "Components/SplineComponent.h"
 
+class FOPM_SplineCache;
+class UStaticMesh;
+class UInstancedStaticMeshComponent;
+struct FOPM_SplineSamples;
+
 /**
  * Utility class for spline-based placement operations
  * Provides path-following placement, road/fence generation, and cable/pipe routing
@@ -20,13 +25,33 @@ public:
 	 * @param SplineComponent Spline to follow
 	 * @param Settings Spline placement settings
 	 * @param World World to spawn actors in
+	 * @param bWatchSpline Re-place the affected actors when the spline is edited later
 	 * @return Array of spawned actors
 	 */
 	static TArray<AActor*> PlaceActorsAlongSpline(
 		UClass* ActorClass,
 		USplineComponent* SplineComponent,
 		const FSplinePlacementSettings& Settings,
-		UWorld* World);
+		UWorld* World,
+		bool bWatchSpline = false);
+
+	/**
+	 * Deform spline mesh segments along a spline, all owned by a single actor
+	 * The span is split into a whole number of segments close to Settings.Spacing, each bent to its
+	 * exact sub-span. Segments already on TargetActor are reused and surplus ones removed.
+	 * @param Mesh Mesh to deform along each segment (forward along X)
+	 * @param SplineComponent Spline to follow
+	 * @param Settings Spline placement settings
+	 * @param World World to spawn in
+	 * @param TargetActor Actor whose segments are rebuilt in place, or nullptr to spawn a new actor
+	 * @return Actor holding the spline mesh segments
+	 */
+	static AActor* PlaceSplineMeshesAlongSpline(
+		UStaticMesh* Mesh,
+		USplineComponent* SplineComponent,
+		const FSplinePlacementSettings& Settings,
+		UWorld* World,
+		AActor* TargetActor = nullptr);
 
 	/**
 	 * Generate transforms along a spline
@@ -39,7 +64,29 @@ public:
 		const FSplinePlacementSettings& Settings);
 
 	/**
-	 * Generate road/path with props along spline
+	 * Get the placement distances for the settings' placement mode
+	 * @param SplineComponent Spline to follow
+	 * @param Settings Spline placement settings
+	 * @return Array of distances along the spline
+	 */
+	static TArray<float> GetPlacementDistances(
+		USplineComponent* SplineComponent,
+		const FSplinePlacementSettings& Settings);
+
+	/**
+	 * Generate aligned, offset and scaled transforms at given distances along a spline
+	 * @param SplineComponent Spline to follow
+	 * @param Distances Distances along the spline
+	 * @param Settings Spline placement settings
+	 * @return One transform per distance
+	 */
+	static TArray<FTransform> GenerateTransformsAtDistances(
+		USplineComponent* SplineComponent,
+		const TArray<float>& Distances,
+		const FSplinePlacementSettings& Settings);
+
+	/**
+	 * Generate road/path with props along spline, one actor per segment and prop
 	 * @param SplineComponent Spline defining the road path
 	 * @param RoadActorClass Actor class for road segments
 	 * @param PropActorClasses Array of prop classes (signs, barriers, etc.)
@@ -47,6 +94,7 @@ public:
 	 * @param World World to spawn in
 	 * @return Array of all spawned actors (road + props)
 	 */
+	UE_DEPRECATED(5.3, "Use GenerateRoadComposite, which builds the road as one actor from meshes.")
 	static TArray<AActor*> GenerateRoadAlongSpline(
 		USplineComponent* SplineComponent,
 		UClass* RoadActorClass,
@@ -55,14 +103,16 @@ public:
 		UWorld* World);
 
 	/**
-	 * Generate fence along spline
+	 * Generate fence along spline, one actor per post and panel
+	 * Posts land on both spline ends and each panel is stretched along X to span its gap.
 	 * @param SplineComponent Spline defining the fence path
 	 * @param PostActorClass Actor class for fence posts
-	 * @param PanelActorClass Actor class for fence panels
+	 * @param PanelActorClass Actor class for fence panels, stretched along X
 	 * @param PostSpacing Spacing between posts
 	 * @param World World to spawn in
 	 * @return Array of spawned fence actors
 	 */
+	UE_DEPRECATED(5.3, "Use GenerateFenceComposite, which builds the fence as one actor from meshes.")
 	static TArray<AActor*> GenerateFenceAlongSpline(
 		USplineComponent* SplineComponent,
 		UClass* PostActorClass,
@@ -72,12 +122,15 @@ public:
 
 	/**
 	 * Generate cable/pipe routing along spline
+	 * Supports land on both spline ends and split it into equal spans. Each span is hung as a catenary
+	 * and followed by a continuous chain of cable actors, each stretched between two curve points.
 	 * @param SplineComponent Spline defining the cable path
-	 * @param CableActorClass Actor class for cable segments
+	 * @param CableActorClass Actor class for cable pieces, stretched along X
 	 * @param SupportsActorClass Actor class for support structures
 	 * @param SupportSpacing Spacing between supports
 	 * @param SagAmount Amount of sag in cable (0 = no sag)
 	 * @param World World to spawn in
+	 * @param TensionRatio Horizontal tension divided by cable weight per unit length, overrides SagAmount when above zero
 	 * @return Array of spawned cable and support actors
 	 */
 	static TArray<AActor*> GenerateCableRoutingAlongSpline(
@@ -86,7 +139,70 @@ public:
 		UClass* SupportsActorClass,
 		float SupportSpacing,
 		float SagAmount,
-		UWorld* World);
+		UWorld* World,
+		float TensionRatio = 0.0f);
+
+	/**
+	 * Generate a road as a single composite actor
+	 * The road surface is deformed spline mesh segments, props share one instanced component per mesh.
+	 * Passing the actor from a previous call rebuilds it in place, reusing its components and instance buffers.
+	 * @param SplineComponent Spline defining the road path
+	 * @param RoadMesh Mesh deformed along the road (forward along X, its length sets the segment length)
+	 * @param PropMeshes Prop meshes placed on both sides of the road
+	 * @param PropSpacing Spacing between props
+	 * @param World World to spawn in
+	 * @param TargetActor Composite actor to rebuild, or nullptr to spawn a new one
+	 * @return Composite road actor
+	 */
+	static AActor* GenerateRoadComposite(
+		USplineComponent* SplineComponent,
+		UStaticMesh* RoadMesh,
+		const TArray<UStaticMesh*>& PropMeshes,
+		float PropSpacing,
+		UWorld* World,
+		AActor* TargetActor = nullptr);
+
+	/**
+	 * Generate a fence as a single composite actor
+	 * Posts share one instanced component, panels are spline meshes bent to the span between posts.
+	 * @param SplineComponent Spline defining the fence path
+	 * @param PostMesh Mesh for fence posts
+	 * @param PanelMesh Mesh deformed between posts (forward along X)
+	 * @param PostSpacing Nominal spacing between posts, adjusted so posts land on both spline ends
+	 * @param World World to spawn in
+	 * @param TargetActor Composite actor to rebuild, or nullptr to spawn a new one
+	 * @return Composite fence actor
+	 */
+	static AActor* GenerateFenceComposite(
+		USplineComponent* SplineComponent,
+		UStaticMesh* PostMesh,
+		UStaticMesh* PanelMesh,
+		float PostSpacing,
+		UWorld* World,
+		AActor* TargetActor = nullptr);
+
+	/**
+	 * Generate cable routing as a single composite actor
+	 * Supports share one instanced component, each span hangs as a true catenary built from a continuous chain of spline meshes.
+	 * @param SplineComponent Spline defining the cable path
+	 * @param CableMesh Mesh deformed along the cable (forward along X)
+	 * @param SupportMesh Mesh for support structures
+	 * @param SupportSpacing Spacing between supports
+	 * @param SagAmount Amount of sag in cable (0 = no sag)
+	 * @param World World to spawn in
+	 * @param TargetActor Composite actor to rebuild, or nullptr to spawn a new one
+	 * @param TensionRatio Horizontal tension divided by cable weight per unit length, overrides SagAmount when above zero
+	 * @return Composite cable actor
+	 */
+	static AActor* GenerateCableComposite(
+		USplineComponent* SplineComponent,
+		UStaticMesh* CableMesh,
+		UStaticMesh* SupportMesh,
+		float SupportSpacing,
+		float SagAmount,
+		UWorld* World,
+		AActor* TargetActor = nullptr,
+		float TensionRatio = 0.0f);
 
 	/**
 	 * Calculate distance along spline
@@ -130,15 +246,19 @@ public:
 
 	/**
 	 * Get adaptive distances based on spline curvature
+	 * Each step is the longest chord whose deviation from the spline stays within the tolerance,
+	 * using the peak analytic curvature over the step, so the result does not depend on spline scale.
 	 * @param SplineComponent Spline to analyze
 	 * @param MinSpacing Minimum spacing between points
 	 * @param MaxSpacing Maximum spacing on straight sections
-	 * @return Array of adaptive distances
+	 * @param ChordTolerance Maximum distance between the spline and the chord joining two points
+	 * @return Array of adaptive distances, including the spline end
 	 */
 	static TArray<float> GetAdaptiveDistances(
 		USplineComponent* SplineComponent,
 		float MinSpacing = 50.0f,
-		float MaxSpacing = 200.0f);
+		float MaxSpacing = 200.0f,
+		float ChordTolerance = 5.0f);
 
 	/**
 	 * Calculate curvature at distance along spline
@@ -159,6 +279,18 @@ public:
 		USplineComponent* SplineComponent,
 		float SmoothingFactor = 0.5f);
 
+	/**
+	 * Remove spline points while keeping the curve within tolerance of its original shape
+	 * Points are first picked with Douglas-Peucker on the control points, then the rebuilt curve is
+	 * checked against samples of the original and points are restored wherever it strays too far.
+	 * @param SplineComponent Spline to simplify
+	 * @param Tolerance Largest distance allowed between the original and simplified curves
+	 * @return Points removed, deviation and distance query cost before and after
+	 */
+	static FSplineSimplificationResult SimplifySpline(
+		USplineComponent* SplineComponent,
+		float Tolerance = 10.0f);
+
 	/**
 	 * Distribute actors with varying density based on spline curvature
 	 * @param ActorClass Actor class to spawn
@@ -197,6 +329,26 @@ public:
 		UWorld* World,
 		float HeightOffset = 0.0f);
 
+	/**
+	 * Snap a spline to terrain along its whole length, not just at its control points
+	 * The spline is sampled densely, every sample is snapped to the landscape height snapshot
+	 * (traces are only used where no landscape covers a sample), and the snapped samples are
+	 * simplified back to the fewest points whose rebuilt curve stays within tolerance of them.
+	 * Control points that survive keep their type, custom tangents, rotation and scale.
+	 * @param SplineComponent Spline to snap, its points are replaced
+	 * @param World World for terrain queries
+	 * @param HeightOffset Additional height offset after snapping
+	 * @param SampleSpacing Distance between terrain samples along the spline
+	 * @param Tolerance Largest height error allowed when removing samples again
+	 * @return Number of spline points after snapping
+	 */
+	static int32 SnapSplineToTerrainDense(
+		USplineComponent* SplineComponent,
+		UWorld* World,
+		float HeightOffset = 0.0f,
+		float SampleSpacing = 100.0f,
+		float Tolerance = 10.0f);
+
 	/**
 	 * Create branching paths from a main spline
 	 * @param MainSpline Main spline path
@@ -211,20 +363,259 @@ public:
 		const TArray<float>& BranchAngles,
 		const TArray<float>& BranchLengths);
 
+	/**
+	 * Place actors along every spline of a network, leaving junctions clear
+	 * @param ActorClass Actor class to spawn
+	 * @param Splines Splines forming the network
+	 * @param Settings Placement settings applied to each spline
+	 * @param JunctionClearance Distance either side of a junction where nothing is placed
+	 * @param World World to spawn in
+	 * @return Array of spawned actors
+	 */
+	static TArray<AActor*> PlaceActorsAlongSplineNetwork(
+		UClass* ActorClass,
+		const TArray<USplineComponent*>& Splines,
+		const FSplinePlacementSettings& Settings,
+		float JunctionClearance,
+		UWorld* World);
+
+	/**
+	 * Find the junctions where splines of a network cross or touch
+	 * @param Splines Splines forming the network
+	 * @param Tolerance Distance at which two splines are considered to meet
+	 * @return World location of each junction
+	 */
+	static TArray<FVector> FindSplineJunctions(
+		const TArray<USplineComponent*>& Splines,
+		float Tolerance = 10.0f);
+
+	/**
+	 * Generate transforms along many splines in one parallel job
+	 * Every spline is snapshotted up front and the placement distances of all splines are
+	 * evaluated together across worker threads.
+	 * @param Splines Splines to place along
+	 * @param Settings Placement settings applied to each spline
+	 * @param OutSplineIndices Index into Splines of each returned transform
+	 * @return Transforms of all splines, spline after spline
+	 */
+	static TArray<FTransform> GenerateTransformsAlongSplines(
+		const TArray<USplineComponent*>& Splines,
+		const FSplinePlacementSettings& Settings,
+		TArray<int32>& OutSplineIndices);
+
+	/**
+	 * Generate transforms at given distances along many splines in one parallel job
+	 * @param Splines Splines to place along
+	 * @param SplineDistances Distances along each spline, one array per spline
+	 * @param Settings Placement settings applied to each spline
+	 * @param OutSplineIndices Index into Splines of each returned transform
+	 * @return Transforms of all splines, spline after spline
+	 */
+	static TArray<FTransform> GenerateTransformsAtSplineDistances(
+		const TArray<USplineComponent*>& Splines,
+		const TArray<TArray<float>>& SplineDistances,
+		const FSplinePlacementSettings& Settings,
+		TArray<int32>& OutSplineIndices);
+
+	/**
+	 * Place actors along many splines, evaluating all transforms in one parallel job
+	 * @param ActorClass Actor class to spawn
+	 * @param Splines Splines to place along
+	 * @param Settings Placement settings applied to each spline
+	 * @param World World to spawn in
+	 * @return Array of spawned actors
+	 */
+	static TArray<AActor*> PlaceActorsAlongSplines(
+		UClass* ActorClass,
+		const TArray<USplineComponent*>& Splines,
+		const FSplinePlacementSettings& Settings,
+		UWorld* World);
+
+	/**
+	 * Place mesh instances along many splines into one instanced component
+	 * @param Mesh Mesh to instance
+	 * @param Splines Splines to place along
+	 * @param Settings Placement settings applied to each spline
+	 * @param World World to spawn the host actor in
+	 * @param TargetActor Actor from a previous call to rebuild in place, or null to spawn a new one
+	 * @return Actor holding the instances
+	 */
+	static AActor* PlaceInstancesAlongSplines(
+		UStaticMesh* Mesh,
+		const TArray<USplineComponent*>& Splines,
+		const FSplinePlacementSettings& Settings,
+		UWorld* World,
+		AActor* TargetActor = nullptr);
+
 private:
 	/**
-	 * Helper to calculate tangent-aligned rotation
+	 * Helper to spawn one actor per transform
 	 */
-	static FRotator GetTangentRotation(
-		USplineComponent* SplineComponent,
-		float Distance);
+	static TArray<AActor*> SpawnActorsAtTransforms(
+		UClass* ActorClass,
+		const TArray<FTransform>& Transforms,
+		UWorld* World);
 
 	/**
-	 * Helper to calculate normal-aligned rotation
+	 * Helper to build a position curve through a subset of another curve's points, with tangents set as the spline would
 	 */
-	static FRotator GetNormalRotation(
-		USplineComponent* SplineComponent,
-		float Distance);
+	static void BuildSubsetCurve(
+		const FInterpCurveVector& Source,
+		const TArray<int32>& Kept,
+		bool bClosedLoop,
+		bool bStationaryEndpoints,
+		FInterpCurveVector& OutCurve);
+
+	/**
+	 * Helper to restore dropped points until a subset curve stays within tolerance of source samples, returning its deviation
+	 */
+	static float RefineSubsetCurve(
+		const FInterpCurveVector& Source,
+		const TArray<FVector>& Samples,
+		const TArray<int32>& SampleSegments,
+		float Tolerance,
+		bool bClosedLoop,
+		bool bStationaryEndpoints,
+		TArray<int32>& Kept,
+		FInterpCurveVector& OutCurve);
+
+	/**
+	 * Helper to time distance queries along a spline, in milliseconds per 1000 queries
+	 */
+	static float MeasureEvaluationTime(USplineComponent* SplineComponent);
+
+	/**
+	 * Helper to pick the points of a polyline to keep so the rest stay within tolerance (Douglas-Peucker)
+	 */
+	static void SimplifyPolyline(
+		const TArray<FVector>& Points,
+		float Tolerance,
+		TArray<int32>& OutKept);
+
+	/**
+	 * Helper to build a placement transform from a batch of snapshot samples
+	 */
+	static FTransform MakeSampledTransform(
+		const FOPM_SplineSamples& Samples,
+		int32 Index,
+		const FSplinePlacementSettings& Settings);
+
+	/**
+	 * Helper to evaluate an aligned transform from the spline cache
+	 */
+	static FTransform GetCachedTransform(
+		const FOPM_SplineCache& Cache,
+		float Distance,
+		ESplineAlignment Alignment);
+
+	/**
+	 * Helper to build an aligned transform from a spline frame
+	 */
+	static FTransform MakeAlignedTransform(
+		const FVector& Location,
+		const FVector& Direction,
+		const FVector& Up,
+		ESplineAlignment Alignment);
+
+	/**
+	 * Helper to spawn an actor midway between two points, facing and stretched along X to span them
+	 */
+	static AActor* SpawnStretchedActor(
+		UWorld* World,
+		UClass* ActorClass,
+		const FVector& Start,
+		const FVector& End);
+
+	/**
+	 * Helper to spawn an empty actor with a static scene root for generated components
+	 */
+	static AActor* SpawnComponentHost(
+		UWorld* World,
+		const FVector& Location,
+		const FString& Label);
+
+	/** Start and end state of one deformed spline mesh segment, in world space */
+	struct FSplineMeshSpan
+	{
+		FVector StartLocation;
+		FVector StartTangent;
+		FVector EndLocation;
+		FVector EndTangent;
+		FVector UpVector;
+		float EndRoll = 0.0f;
+		FVector2D StartScale = FVector2D::UnitVector;
+		FVector2D EndScale = FVector2D::UnitVector;
+	};
+
+	/**
+	 * Helper to build spline mesh spans following the spline between consecutive break distances
+	 */
+	static void MakeSplineMeshSpans(
+		const FOPM_SplineCache& Cache,
+		const TArray<float>& Breaks,
+		const FSplinePlacementSettings& Settings,
+		TArray<FSplineMeshSpan>& OutSpans);
+
+	/**
+	 * Helper to build spline mesh spans through a polyline, with Catmull-Rom tangents
+	 */
+	static void MakePolylineSpans(
+		const TArray<FVector>& Points,
+		TArray<FSplineMeshSpan>& OutSpans);
+
+	/**
+	 * Helper to fit the pooled spline mesh components with the given tag to the spans
+	 */
+	static void BuildSplineMeshSegments(
+		AActor* Owner,
+		UStaticMesh* Mesh,
+		const TArray<FSplineMeshSpan>& Spans,
+		FName PoolTag);
+
+	/**
+	 * Helper to find the instanced component for a mesh under a pool tag, creating it if needed
+	 */
+	static UInstancedStaticMeshComponent* FindOrAddInstancedComponent(
+		AActor* Owner,
+		UStaticMesh* Mesh,
+		FName PoolTag);
+
+	/**
+	 * Helper to overwrite an instanced component's instances, reusing the existing buffer
+	 */
+	static void UpdateInstances(
+		UInstancedStaticMeshComponent* Component,
+		const TArray<FTransform>& WorldTransforms);
+
+	/**
+	 * Helper to remove instanced components with the given tag that were not used by a rebuild
+	 */
+	static void RemoveUnusedInstancedComponents(
+		AActor* Owner,
+		FName PoolTag,
+		const TSet<UInstancedStaticMeshComponent*>& UsedComponents);
+
+	/**
+	 * Helper to split a span into a whole number of nearly equal pieces, returning the break distances
+	 */
+	static TArray<float> GetFittedBreaks(
+		float StartDistance,
+		float EndDistance,
+		float NominalLength);
+
+	/**
+	 * Helper to find the longest chord whose deviation from an arc of the given curvature stays within tolerance
+	 */
+	static float GetChordLengthForTolerance(
+		float Curvature,
+		float Tolerance,
+		float MinLength,
+		float MaxLength);
+
+	/**
+	 * Helper to convert curvature to the normalized tangent change over a sample window
+	 */
+	static float NormalizeCurvature(float Curvature);
 
 	/**
 	 * Helper to apply offset to transform
@@ -234,11 +625,13 @@ private:
 		const FVector& Offset);
 
 	/**
-	 * Helper to calculate cable sag transform
+	 * Helper to hang cable spans as catenaries, from a tension ratio when one is given or else from a midpoint sag
 	 */
-	static FVector CalculateCableSag(
-		const FVector& Start,
-		const FVector& End,
-		float Alpha,
-		float SagAmount);
+	static void SolveCableSpans(
+		TArrayView<const FVector> Starts,
+		TArrayView<const FVector> Ends,
+		float SagAmount,
+		float TensionRatio,
+		int32 PointsPerSpan,
+		TArray<FVector>& OutPoints);
 };
@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "Tickable.h"
+#include "OPMTypes.h"
+#include "SplineWatchSubsystem.generated.h"
+
+class USplineComponent;
+
+/**
+ * Keeps actors placed by PlaceActorsAlongSpline with bWatchSpline in step with later spline edits
+ * Each placed actor is bound to the spline segment it sits on. When the spline changes, control
+ * points are compared with the recorded state and only actors on segments touching a changed
+ * point are destroyed and re-placed; actors on untouched segments are left alone. Re-placed actors
+ * are spaced from the nearest kept actors on either side, so runs join without gaps or overlaps.
+ * Undo and redo restore actors and spline together, so they are never regenerated; the bindings
+ * are rebuilt from the restored actors instead.
+ */
+UCLASS()
+class OPM_API UOPM_SplineWatchSubsystem : public UEditorSubsystem, public FTickableEditorObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Get the subsystem instance
+	 * @return Subsystem, or nullptr outside the editor
+	 */
+	static UOPM_SplineWatchSubsystem* Get();
+
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/**
+	 * Watch a spline placement for edits
+	 * @param SplineComponent Spline the actors were placed along
+	 * @param ActorClass Class used to spawn the actors
+	 * @param Settings Settings used for the placement
+	 * @param Actors Placed actors
+	 * @param Distances Distance along the spline of each actor
+	 */
+	void WatchPlacement(
+		USplineComponent* SplineComponent,
+		UClass* ActorClass,
+		const FSplinePlacementSettings& Settings,
+		TArrayView<AActor* const> Actors,
+		TArrayView<const float> Distances);
+
+	/**
+	 * Stop watching every placement along a spline
+	 * @param SplineComponent Spline to forget
+	 */
+	void StopWatching(USplineComponent* SplineComponent);
+
+	//~ Begin FTickableEditorObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Always; }
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableEditorObject Interface
+
+private:
+	/** Control point state that affects the curve on either side of the point */
+	struct FPointState
+	{
+		FVector Location;
+		FVector ArriveTangent;
+		FVector LeaveTangent;
+		FQuat Rotation;
+		FVector Scale;
+		uint8 InterpMode = 0;
+
+		bool Equals(const FPointState& Other) const;
+	};
+
+	struct FPlacedItem
+	{
+		TWeakObjectPtr<AActor> Actor;
+		int32 Segment = INDEX_NONE;
+
+		/** Distance along the spline from the start of Segment */
+		float Offset = 0.0f;
+	};
+
+	struct FWatchedPlacement
+	{
+		TWeakObjectPtr<USplineComponent> Spline;
+		TWeakObjectPtr<UClass> ActorClass;
+		FSplinePlacementSettings Settings;
+
+		/** Spline state the items were last placed against */
+		TArray<FPointState> Points;
+		FTransform ComponentTransform;
+		bool bClosedLoop = false;
+		uint32 PlacedVersion = 0;
+
+		/** Most recent state seen, regeneration waits until it stops changing */
+		uint32 SeenVersion = 0;
+		FTransform SeenTransform;
+		double LastChangeTime = 0.0;
+
+		TArray<FPlacedItem> Items;
+
+		/** Every actor placed for this placement, undo can bring destroyed ones back */
+		TArray<TWeakObjectPtr<AActor>> History;
+	};
+
+	static void CapturePoints(USplineComponent* SplineComponent, TArray<FPointState>& OutPoints);
+	static int32 GetSegmentAtDistance(USplineComponent* SplineComponent, float Distance);
+
+	/** Helper to get the distances to fill between two kept items, either may be missing at an open end */
+	static void GetRunDistances(
+		USplineComponent* SplineComponent,
+		const FSplinePlacementSettings& Settings,
+		TOptional<float> PrevAnchor,
+		TOptional<float> NextAnchor,
+		TArray<float>& OutDistances);
+
+	/** Helper to re-place the items on segments whose control points changed */
+	void RegenerateChangedSegments(FWatchedPlacement& Placement);
+
+	/** Helper to bind the live placed actors to the segments they sit on after undo or redo */
+	static void RebuildItems(FWatchedPlacement& Placement);
+
+	/** Helper to check whether a placement can still affect anything, undo may bring back actors not yet garbage collected */
+	static bool IsPlacementAlive(const FWatchedPlacement& Placement);
+
+	/** Helper to drop placements whose spline or actors are gone for good, and the oldest beyond the cap */
+	void PrunePlacements();
+
+	void OnPostUndoRedo();
+
+	TArray<FWatchedPlacement> Placements;
+
+	FDelegateHandle UndoRedoHandle;
+};
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "OPMTypes.h"
+#include "TagIndexSubsystem.generated.h"
+
+/**
+ * Inverted index from actor tag to the actors carrying it
+ * Every actor in the indexed world owns a slot, and each tag keeps a bit array over the slots.
+ * Queries combine those bit arrays word by word, so AND/OR/NOT lookups cost a few microseconds
+ * regardless of how many actors the level holds. The index is built on the first query against a
+ * world and kept current through actor add/delete, World Partition and level streaming loads, tag
+ * property edits and the OPM tag utilities.
+ */
+UCLASS()
+class OPM_API UOPM_TagIndexSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Get the subsystem instance
+	 * @return Subsystem, or nullptr outside the editor
+	 */
+	static UOPM_TagIndexSubsystem* Get();
+
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/**
+	 * Find actors matching a tag query
+	 * @param World World to search
+	 * @param TagQuery Tags to require, accept and exclude
+	 * @param OutActors Matching actors, in slot order
+	 * @return Number of matching actors
+	 */
+	int32 Query(UWorld* World, const FTagQuery& TagQuery, TArray<AActor*>& OutActors);
+
+	/**
+	 * Find actors carrying a tag
+	 * @param World World to search
+	 * @param Tag Tag to look for
+	 * @param OutActors Actors carrying the tag
+	 * @return Number of matching actors
+	 */
+	int32 FindActorsWithTag(UWorld* World, FName Tag, TArray<AActor*>& OutActors);
+
+	/**
+	 * Re-read the tags of an actor after they were changed directly
+	 * @param Actor Actor whose tags changed
+	 */
+	void UpdateActor(AActor* Actor);
+
+	/**
+	 * Re-read the tags of several actors
+	 * @param Actors Actors whose tags changed
+	 */
+	void UpdateActors(TArrayView<AActor* const> Actors);
+
+	/**
+	 * Drop the index, it is rebuilt on the next query
+	 */
+	void Invalidate();
+
+private:
+	/** Helper to make sure the index describes World */
+	void EnsureBuilt(UWorld* World);
+
+	void AddActor(AActor* Actor);
+	void RemoveActor(AActor* Actor);
+	void SetSlotTags(int32 Slot, const TArray<FName>& Tags);
+
+	void OnLevelActorAdded(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+	void OnLoadedActorAdded(AActor& Actor);
+	void OnLoadedActorRemoved(AActor& Actor);
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+	void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& Event);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	TWeakObjectPtr<UWorld> IndexedWorld;
+	bool bBuilt = false;
+
+	TArray<TWeakObjectPtr<AActor>> Slots;
+	TArray<TArray<FName>> SlotTags;
+	TMap<TObjectKey<AActor>, int32> SlotOfActor;
+	TArray<int32> FreeSlots;
+
+	/** Slots holding an actor */
+	TBitArray<> LiveSlots;
+
+	/** Slots carrying each tag, arrays may be shorter than Slots when the trailing bits are clear */
+	TMap<FName, TBitArray<>> TagSlots;
+
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle LoadedActorAddedHandle;
+	FDelegateHandle LoadedActorRemovedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle UndoRedoHandle;
+};
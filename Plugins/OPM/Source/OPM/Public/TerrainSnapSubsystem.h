@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "Tickable.h"
+#include "OPMTypes.h"
+#include "TerrainSnapSubsystem.generated.h"
+
+class ALandscape;
+class ALandscapeProxy;
+struct FLandscapeProxyComponentDataChangedParams;
+
+/**
+ * Keeps actors placed by PlaceActorsOnLandscape with bKeepOnTerrain glued to the terrain
+ * Records each terrain-aligned actor with its placement settings in a coarse spatial hash.
+ * When landscape components change, only actors inside the changed region are queued, and the
+ * queue is re-aligned in small time-sliced batches once sculpting settles.
+ * Queued actors join the sculpt transaction so undoing the stroke restores them too.
+ * Moving a tracked actor by hand or deleting it stops tracking it.
+ */
+UCLASS()
+class OPM_API UOPM_TerrainSnapSubsystem : public UEditorSubsystem, public FTickableEditorObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Get the subsystem instance
+	 * @return Subsystem, or nullptr outside the editor
+	 */
+	static UOPM_TerrainSnapSubsystem* Get();
+
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/**
+	 * Track an actor so it is re-aligned when the landscape under it changes
+	 * @param Actor Actor that was aligned to the terrain
+	 * @param Landscape Landscape it was aligned to
+	 * @param Settings Settings used for the alignment
+	 */
+	void RegisterActor(AActor* Actor, ALandscape* Landscape, const FLandscapePlacementSettings& Settings);
+
+	/**
+	 * Stop tracking an actor
+	 * @param Actor Actor to forget
+	 */
+	void UnregisterActor(AActor* Actor);
+
+	/**
+	 * Queue every tracked actor inside a world-space region for re-alignment
+	 * @param Region Region whose terrain changed
+	 */
+	void QueueRegion(const FBox& Region);
+
+	/**
+	 * Get the number of tracked actors
+	 */
+	int32 GetNumTrackedActors() const { return Records.Num(); }
+
+	//~ Begin FTickableEditorObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Always; }
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableEditorObject Interface
+
+private:
+	struct FSnapRecord
+	{
+		TWeakObjectPtr<ALandscape> Landscape;
+		FLandscapePlacementSettings Settings;
+		FIntPoint Cell;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+	void AddToCell(AActor* Actor, const FIntPoint& Cell);
+	void RemoveFromCell(AActor* Actor, const FIntPoint& Cell);
+
+	void BindToLandscape(ALandscape* Landscape);
+	void UnbindAll();
+	void OnComponentDataChanged(ALandscapeProxy* Proxy, const FLandscapeProxyComponentDataChangedParams& Params);
+	void OnActorMoved(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+
+	TMap<TWeakObjectPtr<AActor>, FSnapRecord> Records;
+	TMap<FIntPoint, TArray<TWeakObjectPtr<AActor>>> Cells;
+
+	/** Actors waiting to be re-aligned, mapped to whether an edit transaction already recorded them */
+	TMap<TWeakObjectPtr<AActor>, bool> PendingActors;
+
+	/** Set while Tick moves actors so their move notifications are not taken for user edits */
+	bool bAligning = false;
+
+	/** Time the landscape last reported a change, processing waits until edits settle */
+	double LastChangeTime = 0.0;
+
+	TArray<TPair<TWeakObjectPtr<ALandscapeProxy>, FDelegateHandle>> ProxyBindings;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle ActorDeletedHandle;
+};